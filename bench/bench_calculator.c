@@ -0,0 +1,583 @@
+// ==========================================
+// FILE: bench_calculator.c
+// ==========================================
+/**
+ * @file bench_calculator.c
+ * @brief Calculator benchmark - every calculator_* operation
+ * @details Runs each scalar and batch operation over four operand
+ *          distributions (normal values, denormals, near-overflow values
+ *          and zero divisors) and reports nanoseconds per operation,
+ *          throughput, tail latency and the share of failing operations.
+ *          Throughput comes from long runs over the operand set; latency
+ *          percentiles come from many short timed windows with the timer
+ *          overhead subtracted. One batch operation is one element.
+ *          Operands are drawn once from a fixed-seed generator so runs are
+ *          comparable across builds. Pass --csv or --json for
+ *          machine-readable output.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_batch.h"
+#include "calculator_dispatch.h"
+#include "calculator_reduce.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Number of operand pairs per distribution */
+#define BENCH_OPERAND_COUNT 4096
+
+/** Passes over the operand set for the throughput figure */
+#define BENCH_PASSES 256
+
+/** Operations per timed window of a scalar operation */
+#define BENCH_WINDOW_OPS 32
+
+/** Timed windows per scalar operation */
+#define BENCH_SCALAR_SAMPLES 16384
+
+/** Timed calls per batch operation, each over the whole operand set */
+#define BENCH_BATCH_SAMPLES 512
+
+/** Scale factor of the axpy benchmark */
+#define BENCH_AXPY_ALPHA 0.75
+
+// ==========================================
+// MARK: - Benchmark Types
+// ==========================================
+
+/** Operand distributions */
+typedef enum {
+    BENCH_DIST_NORMAL = 0,      ///< Normal magnitudes, 1e-3 to 1e6
+    BENCH_DIST_DENORMAL,        ///< Subnormal operands
+    BENCH_DIST_NEAR_OVERFLOW,   ///< Magnitudes close to DBL_MAX (INT_MAX / INT64_MAX for modulus)
+    BENCH_DIST_ZERO_DIVISOR,    ///< Normal first operand, zero second operand
+    BENCH_DIST_SQUARE,          ///< Power only: exponent 2
+    BENCH_DIST_INTEGER_EXPONENT,///< Power only: integer exponents in [-64, 64]
+    BENCH_DIST_COUNT
+} bench_dist_t;
+
+/** Operation signatures */
+typedef enum {
+    BENCH_KIND_BINARY = 0,      ///< calc_result_t f(double, double, double *)
+    BENCH_KIND_MODULUS,         ///< calc_result_t f(int, int, double *)
+    BENCH_KIND_PREDICATE,       ///< bool f(double)
+    BENCH_KIND_BINARY_BATCH,    ///< f(const double *, const double *, double *, n, errors)
+    BENCH_KIND_MODULUS_BATCH,   ///< f(const int *, const int *, double *, n, errors)
+    BENCH_KIND_MODULUS_I64,     ///< calc_result_t f(int64_t, int64_t, int64_t *)
+    BENCH_KIND_MODULUS_I64_BATCH,///< f(const int64_t *, const calc_divisor_i64_t *, int64_t *, n)
+    BENCH_KIND_DIVIDE_PREPARED_BATCH,///< f(const double *, const calc_divisor_f64_t *, double *, n, errors)
+    BENCH_KIND_AXPY,            ///< f(double, const double *, const double *, double *, n, errors)
+    BENCH_KIND_REDUCE,          ///< calc_result_t f(const double *, n, double *)
+    BENCH_KIND_DOT              ///< calc_result_t f(const double *, const double *, n, double *)
+} bench_kind_t;
+
+/** One benchmarked operation; only the pointer matching kind is set */
+typedef struct {
+    const char *name;
+    bench_kind_t kind;
+    bool power;                 ///< Draw exponent-shaped second operands
+    bool accepts;               ///< Predicate returns true for good values
+    bool unit;                  ///< Draw normal operands near 1 so long products stay finite
+    calc_result_t (*binary)(double, double, double *);
+    calc_result_t (*modulus)(int, int, double *);
+    bool (*predicate)(double);
+    calc_result_t (*binary_batch)(const double *, const double *, double *, size_t,
+                                  calc_batch_errors_t *);
+    calc_result_t (*modulus_batch)(const int *, const int *, double *, size_t,
+                                   calc_batch_errors_t *);
+    calc_result_t (*modulus_i64)(int64_t, int64_t, int64_t *);
+    calc_result_t (*modulus_i64_batch)(const int64_t *, const calc_divisor_i64_t *, int64_t *,
+                                       size_t);
+    calc_result_t (*divide_prepared_batch)(const double *, const calc_divisor_f64_t *, double *,
+                                           size_t, calc_batch_errors_t *);
+    calc_result_t (*axpy)(double, const double *, const double *, double *, size_t,
+                          calc_batch_errors_t *);
+    calc_result_t (*reduce)(const double *, size_t, double *);
+    calc_result_t (*dot)(const double *, const double *, size_t, double *);
+} bench_case_t;
+
+/** Measurements of one operation over one distribution */
+typedef struct {
+    double ns_per_op;           ///< Mean time per operation
+    double mops;                ///< Throughput in million operations per second
+    double p50_ns;              ///< Median latency per operation
+    double p99_ns;              ///< 99th percentile latency per operation
+    double p999_ns;             ///< 99.9th percentile latency per operation
+    double max_ns;              ///< Slowest window, per operation
+    double error_rate;          ///< Share of operations that failed
+} bench_stats_t;
+
+/** Output formats */
+typedef enum {
+    BENCH_FORMAT_TEXT = 0,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+} bench_format_t;
+
+// ==========================================
+// MARK: - Operation Table
+// ==========================================
+
+static const bench_case_t bench_cases[] = {
+    { .name = "calculator_add", .kind = BENCH_KIND_BINARY, .binary = calculator_add },
+    { .name = "calculator_subtract", .kind = BENCH_KIND_BINARY, .binary = calculator_subtract },
+    { .name = "calculator_multiply", .kind = BENCH_KIND_BINARY, .binary = calculator_multiply },
+    { .name = "calculator_divide", .kind = BENCH_KIND_BINARY, .binary = calculator_divide },
+    { .name = "calculator_modulus", .kind = BENCH_KIND_MODULUS, .modulus = calculator_modulus },
+    { .name = "calculator_modulus_i64", .kind = BENCH_KIND_MODULUS_I64,
+      .modulus_i64 = calculator_modulus_i64 },
+    { .name = "calculator_power", .kind = BENCH_KIND_BINARY, .power = true,
+      .binary = calculator_power },
+    { .name = "calculator_is_valid_number", .kind = BENCH_KIND_PREDICATE, .accepts = true,
+      .predicate = calculator_is_valid_number },
+    { .name = "calculator_is_overflow", .kind = BENCH_KIND_PREDICATE,
+      .predicate = calculator_is_overflow },
+    { .name = "calculator_is_underflow", .kind = BENCH_KIND_PREDICATE,
+      .predicate = calculator_is_underflow },
+    { .name = "calculator_add_batch", .kind = BENCH_KIND_BINARY_BATCH,
+      .binary_batch = calculator_add_batch },
+    { .name = "calculator_subtract_batch", .kind = BENCH_KIND_BINARY_BATCH,
+      .binary_batch = calculator_subtract_batch },
+    { .name = "calculator_multiply_batch", .kind = BENCH_KIND_BINARY_BATCH,
+      .binary_batch = calculator_multiply_batch },
+    { .name = "calculator_divide_batch", .kind = BENCH_KIND_BINARY_BATCH,
+      .binary_batch = calculator_divide_batch },
+    { .name = "calculator_divide_prepared_batch", .kind = BENCH_KIND_DIVIDE_PREPARED_BATCH,
+      .divide_prepared_batch = calculator_divide_prepared_batch },
+    { .name = "calculator_axpy", .kind = BENCH_KIND_AXPY, .axpy = calculator_axpy },
+    { .name = "calculator_modulus_batch", .kind = BENCH_KIND_MODULUS_BATCH,
+      .modulus_batch = calculator_modulus_batch },
+    { .name = "calculator_modulus_i64_batch", .kind = BENCH_KIND_MODULUS_I64_BATCH,
+      .modulus_i64_batch = calculator_modulus_i64_batch },
+    { .name = "calculator_power_batch", .kind = BENCH_KIND_BINARY_BATCH, .power = true,
+      .binary_batch = calculator_power_batch },
+    { .name = "calculator_sum", .kind = BENCH_KIND_REDUCE, .reduce = calculator_sum },
+    { .name = "calculator_product", .kind = BENCH_KIND_REDUCE, .unit = true,
+      .reduce = calculator_product },
+    { .name = "calculator_dot", .kind = BENCH_KIND_DOT, .dot = calculator_dot },
+};
+
+static const char *const bench_dist_names[BENCH_DIST_COUNT] = {
+    "normal", "denormal", "near_overflow", "zero_divisor", "square",
+    "integer_exponent"
+};
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static double bench_a[BENCH_OPERAND_COUNT];
+static double bench_b[BENCH_OPERAND_COUNT];
+static int bench_ia[BENCH_OPERAND_COUNT];
+static int bench_ib[BENCH_OPERAND_COUNT];
+static int64_t bench_la[BENCH_OPERAND_COUNT];
+static int64_t bench_lb[BENCH_OPERAND_COUNT];
+static int64_t bench_lout[BENCH_OPERAND_COUNT];
+static calc_divisor_i64_t bench_divisor;
+static calc_divisor_f64_t bench_divisor_f64;
+static double bench_out[BENCH_OPERAND_COUNT];
+static double bench_samples[BENCH_SCALAR_SAMPLES];
+static uint64_t bench_state;
+
+/** Sink that keeps the compiler from dropping the work */
+static volatile double bench_sink;
+
+/** Cost of one bench_now_ns() pair, subtracted from every window */
+static double bench_timer_overhead_ns;
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static uint64_t bench_next(void) {
+    bench_state ^= bench_state << 13;
+    bench_state ^= bench_state >> 7;
+    bench_state ^= bench_state << 17;
+    return bench_state;
+}
+
+/** Uniform value in [0, 1) */
+static double bench_unit(void) {
+    return (double)(bench_next() >> 11) * 0x1.0p-53;
+}
+
+static double bench_signed(double magnitude) {
+    return (bench_next() & 1) ? -magnitude : magnitude;
+}
+
+/** Random magnitude spread evenly over the decades [10^lo, 10^hi) */
+static double bench_decades(int lo, int hi) {
+    return pow(10.0, lo + bench_unit() * (hi - lo));
+}
+
+static double bench_subnormal(void) {
+    uint64_t bits = (bench_next() & 0x000FFFFFFFFFFFFFu) | 1u;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return bench_signed(value);
+}
+
+/**
+ * Fill the operand arrays for one distribution
+ * @return false if the distribution does not apply to the operation
+ */
+static bool bench_fill(const bench_case_t *bench, bench_dist_t dist) {
+    bool integer = bench->kind == BENCH_KIND_MODULUS || bench->kind == BENCH_KIND_MODULUS_BATCH;
+
+    bench_state = 0x9E3779B97F4A7C15u + (uint64_t)dist;
+    if ((dist == BENCH_DIST_SQUARE || dist == BENCH_DIST_INTEGER_EXPONENT) && !bench->power) {
+        return false;
+    }
+    if (dist == BENCH_DIST_ZERO_DIVISOR && (bench->kind == BENCH_KIND_REDUCE || bench->kind == BENCH_KIND_DOT ||
+                                            bench->kind == BENCH_KIND_AXPY)) {
+        return false;
+    }
+    if (bench->kind == BENCH_KIND_MODULUS_I64 || bench->kind == BENCH_KIND_MODULUS_I64_BATCH) {
+        // One divisor repeated over the whole array, the case the prepared
+        // batch is for; the scalar call sees the same operands
+        int64_t divisor;
+        switch (dist) {
+            case BENCH_DIST_NORMAL:
+                divisor = 1000003;
+                break;
+            case BENCH_DIST_NEAR_OVERFLOW:
+                divisor = -(INT64_MAX / 3);
+                break;
+            case BENCH_DIST_ZERO_DIVISOR:
+                if (bench->kind == BENCH_KIND_MODULUS_I64_BATCH) {
+                    return false;
+                }
+                divisor = 0;
+                break;
+            default:
+                return false;
+        }
+        for (size_t i = 0; i < BENCH_OPERAND_COUNT; i++) {
+            uint64_t bits = bench_next();
+            bench_la[i] = (dist == BENCH_DIST_NEAR_OVERFLOW)
+                              ? ((bits & 1) ? INT64_MAX - (int64_t)(bits % 1000) : INT64_MIN + (int64_t)(bits % 1000))
+                              : (int64_t)bits;
+            bench_lb[i] = divisor;
+        }
+        if (bench->kind == BENCH_KIND_MODULUS_I64_BATCH) {
+            calculator_divisor_i64_init(&bench_divisor, divisor);
+        }
+        return true;
+    }
+    if (integer) {
+        if (dist == BENCH_DIST_DENORMAL) {
+            return false;
+        }
+        for (size_t i = 0; i < BENCH_OPERAND_COUNT; i++) {
+            switch (dist) {
+                case BENCH_DIST_NEAR_OVERFLOW:
+                    // Keep away from INT_MIN % -1, which traps
+                    bench_ia[i] = (int)bench_signed(INT_MAX - (double)(bench_next() % 1000));
+                    bench_ib[i] = (int)bench_signed(INT_MAX / 2 + (double)(bench_next() % 1000));
+                    break;
+                case BENCH_DIST_ZERO_DIVISOR:
+                    bench_ia[i] = (int)bench_signed((double)(bench_next() % 1000000));
+                    bench_ib[i] = 0;
+                    break;
+                default:
+                    bench_ia[i] = (int)bench_signed((double)(bench_next() % 1000000));
+                    bench_ib[i] = (int)bench_signed((double)(1 + bench_next() % 1000));
+                    break;
+            }
+        }
+        return true;
+    }
+
+    if (bench->kind == BENCH_KIND_DIVIDE_PREPARED_BATCH) {
+        // Dividends as for calculator_divide_batch, divided by one constant
+        double divisor = (dist == BENCH_DIST_NEAR_OVERFLOW) ? 0.75 : 3.7;
+        if (dist != BENCH_DIST_NORMAL && dist != BENCH_DIST_DENORMAL &&
+            dist != BENCH_DIST_NEAR_OVERFLOW) {
+            return false;
+        }
+        for (size_t i = 0; i < BENCH_OPERAND_COUNT; i++) {
+            bench_a[i] = (dist == BENCH_DIST_DENORMAL) ? bench_subnormal()
+                       : (dist == BENCH_DIST_NEAR_OVERFLOW) ? bench_signed(DBL_MAX * (0.5 + bench_unit() * 0.5))
+                       : bench_signed(bench_decades(-3, 6));
+        }
+        calculator_divisor_f64_init(&bench_divisor_f64, divisor);
+        return true;
+    }
+
+    for (size_t i = 0; i < BENCH_OPERAND_COUNT; i++) {
+        switch (dist) {
+            case BENCH_DIST_DENORMAL:
+                bench_a[i] = bench_subnormal();
+                bench_b[i] = bench->power ? 0.5 + bench_unit() * 1.5 : bench_subnormal();
+                break;
+            case BENCH_DIST_NEAR_OVERFLOW:
+                bench_a[i] = bench_signed(DBL_MAX * (0.5 + bench_unit() * 0.5));
+                bench_b[i] = bench->power ? 0.98 + bench_unit() * 0.04
+                                          : bench_signed(DBL_MAX * (0.5 + bench_unit() * 0.5));
+                break;
+            case BENCH_DIST_ZERO_DIVISOR:
+                bench_a[i] = bench_signed(bench_decades(-3, 6));
+                bench_b[i] = bench_signed(0.0);
+                break;
+            case BENCH_DIST_SQUARE:
+                bench_a[i] = bench_signed(bench_decades(-3, 6));
+                bench_b[i] = 2.0;
+                break;
+            case BENCH_DIST_INTEGER_EXPONENT:
+                bench_a[i] = bench_signed(bench_decades(-1, 1));
+                bench_b[i] = (double)((int)(bench_next() % 129) - 64);
+                break;
+            default:
+                if (bench->unit) {
+                    bench_a[i] = 1.0 + (bench_unit() - 0.5) * 1e-3;
+                    bench_b[i] = 1.0 + (bench_unit() - 0.5) * 1e-3;
+                } else if (bench->power) {
+                    bench_a[i] = bench_decades(-1, 1);
+                    bench_b[i] = (bench_unit() - 0.5) * 20.0;
+                } else {
+                    bench_a[i] = bench_signed(bench_decades(-3, 6));
+                    bench_b[i] = bench_signed(bench_decades(-3, 6));
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Run an operation over operands [begin, begin + count)
+ * @return Number of failing operations; for predicates, values rejected
+ */
+static size_t bench_run(const bench_case_t *bench, size_t begin, size_t count) {
+    size_t failed = 0;
+    double sum = 0.0;
+    double value = 0.0;
+    calc_batch_errors_t errors = { NULL, NULL, { 0, { 0 }, 0 } };
+
+    switch (bench->kind) {
+        case BENCH_KIND_BINARY:
+            for (size_t i = begin; i < begin + count; i++) {
+                failed += bench->binary(bench_a[i], bench_b[i], &value) != CALC_SUCCESS;
+                sum += value;
+            }
+            break;
+        case BENCH_KIND_MODULUS:
+            for (size_t i = begin; i < begin + count; i++) {
+                failed += bench->modulus(bench_ia[i], bench_ib[i], &value) != CALC_SUCCESS;
+                sum += value;
+            }
+            break;
+        case BENCH_KIND_PREDICATE:
+            for (size_t i = begin; i < begin + count; i++) {
+                failed += bench->predicate(bench_a[i]) != bench->accepts;
+            }
+            break;
+        case BENCH_KIND_BINARY_BATCH:
+            bench->binary_batch(bench_a + begin, bench_b + begin, bench_out + begin, count, &errors);
+            failed = errors.summary.failed;
+            sum = bench_out[begin];
+            break;
+        case BENCH_KIND_MODULUS_BATCH:
+            bench->modulus_batch(bench_ia + begin, bench_ib + begin, bench_out + begin, count, &errors);
+            failed = errors.summary.failed;
+            sum = bench_out[begin];
+            break;
+        case BENCH_KIND_MODULUS_I64:
+            for (size_t i = begin; i < begin + count; i++) {
+                int64_t remainder = 0;
+                failed += bench->modulus_i64(bench_la[i], bench_lb[i], &remainder) != CALC_SUCCESS;
+                sum += (double)remainder;
+            }
+            break;
+        case BENCH_KIND_DIVIDE_PREPARED_BATCH:
+            bench->divide_prepared_batch(bench_a + begin, &bench_divisor_f64, bench_out + begin, count,
+                                         &errors);
+            failed = errors.summary.failed;
+            sum = bench_out[begin];
+            break;
+        case BENCH_KIND_AXPY:
+            bench->axpy(BENCH_AXPY_ALPHA, bench_a + begin, bench_b + begin, bench_out + begin, count, &errors);
+            failed = errors.summary.failed;
+            sum = bench_out[begin];
+            break;
+        case BENCH_KIND_REDUCE:
+            failed = (bench->reduce(bench_a + begin, count, &value) != CALC_SUCCESS) ? count : 0;
+            sum = value;
+            break;
+        case BENCH_KIND_DOT:
+            failed = (bench->dot(bench_a + begin, bench_b + begin, count, &value) != CALC_SUCCESS) ? count : 0;
+            sum = value;
+            break;
+        case BENCH_KIND_MODULUS_I64_BATCH:
+            bench->modulus_i64_batch(bench_la + begin, &bench_divisor, bench_lout + begin, count);
+            sum = (double)bench_lout[begin];
+            break;
+    }
+    bench_sink = sum;
+    return failed;
+}
+
+static int bench_compare(const void *left, const void *right) {
+    double a = *(const double *)left;
+    double b = *(const double *)right;
+    return (a > b) - (a < b);
+}
+
+static double bench_percentile(const double *sorted, size_t count, double fraction) {
+    return sorted[(size_t)(fraction * (double)(count - 1) + 0.5)];
+}
+
+static void bench_calibrate_timer(void) {
+    for (size_t s = 0; s < BENCH_SCALAR_SAMPLES; s++) {
+        double start = bench_now_ns();
+        bench_samples[s] = bench_now_ns() - start;
+    }
+    qsort(bench_samples, BENCH_SCALAR_SAMPLES, sizeof(double), bench_compare);
+    bench_timer_overhead_ns = bench_percentile(bench_samples, BENCH_SCALAR_SAMPLES, 0.5);
+}
+
+// ==========================================
+// MARK: - Measurement
+// ==========================================
+
+static void bench_measure(const bench_case_t *bench, bench_stats_t *stats) {
+    bool batch = bench->kind == BENCH_KIND_BINARY_BATCH || bench->kind == BENCH_KIND_MODULUS_BATCH ||
+                 bench->kind == BENCH_KIND_MODULUS_I64_BATCH ||
+                 bench->kind == BENCH_KIND_DIVIDE_PREPARED_BATCH || bench->kind == BENCH_KIND_AXPY ||
+                 bench->kind == BENCH_KIND_REDUCE || bench->kind == BENCH_KIND_DOT;
+
+    stats->error_rate = (double)bench_run(bench, 0, BENCH_OPERAND_COUNT) / BENCH_OPERAND_COUNT;
+
+    double start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        bench_run(bench, 0, BENCH_OPERAND_COUNT);
+    }
+    double elapsed = bench_now_ns() - start;
+    stats->ns_per_op = elapsed / ((double)BENCH_PASSES * BENCH_OPERAND_COUNT);
+    stats->mops = 1e3 / stats->ns_per_op;
+
+    size_t samples = batch ? BENCH_BATCH_SAMPLES : BENCH_SCALAR_SAMPLES;
+    size_t window = batch ? BENCH_OPERAND_COUNT : BENCH_WINDOW_OPS;
+    for (size_t s = 0; s < samples; s++) {
+        size_t begin = batch ? 0 : (s * BENCH_WINDOW_OPS) % BENCH_OPERAND_COUNT;
+        start = bench_now_ns();
+        bench_run(bench, begin, window);
+        elapsed = bench_now_ns() - start - bench_timer_overhead_ns;
+        bench_samples[s] = (elapsed > 0.0 ? elapsed : 0.0) / (double)window;
+    }
+    qsort(bench_samples, samples, sizeof(double), bench_compare);
+    stats->p50_ns = bench_percentile(bench_samples, samples, 0.5);
+    stats->p99_ns = bench_percentile(bench_samples, samples, 0.99);
+    stats->p999_ns = bench_percentile(bench_samples, samples, 0.999);
+    stats->max_ns = bench_samples[samples - 1];
+}
+
+// ==========================================
+// MARK: - Reporting
+// ==========================================
+
+static void bench_print_header(bench_format_t format) {
+    const char *level = calculator_dispatch_level_name(calculator_dispatch_level());
+    const char *mode = calculator_error_mode_name(calculator_get_error_mode());
+
+    switch (format) {
+        case BENCH_FORMAT_CSV:
+            printf("function,distribution,ns_per_op,mops,p50_ns,p99_ns,p999_ns,max_ns,error_rate\n");
+            break;
+        case BENCH_FORMAT_JSON:
+            printf("{\n  \"cpu_level\": \"%s\",\n  \"error_mode\": \"%s\",\n  \"operands\": %d,\n"
+                   "  \"results\": [", level, mode, BENCH_OPERAND_COUNT);
+            break;
+        default:
+            printf("cpu level: %s, error mode: %s\n", level, mode);
+            printf("%-32s %-16s %8s %9s %8s %8s %8s %9s %7s\n", "function", "distribution",
+                   "ns/op", "Mops/s", "p50", "p99", "p99.9", "max", "errors");
+            break;
+    }
+}
+
+static void bench_print_row(bench_format_t format, const bench_case_t *bench, bench_dist_t dist,
+                            const bench_stats_t *stats, bool first) {
+    switch (format) {
+        case BENCH_FORMAT_CSV:
+            printf("%s,%s,%.3f,%.2f,%.3f,%.3f,%.3f,%.3f,%.4f\n", bench->name,
+                   bench_dist_names[dist], stats->ns_per_op, stats->mops, stats->p50_ns,
+                   stats->p99_ns, stats->p999_ns, stats->max_ns, stats->error_rate);
+            break;
+        case BENCH_FORMAT_JSON:
+            printf("%s\n    {\"function\": \"%s\", \"distribution\": \"%s\", \"ns_per_op\": %.3f, "
+                   "\"mops\": %.2f, \"p50_ns\": %.3f, \"p99_ns\": %.3f, \"p999_ns\": %.3f, "
+                   "\"max_ns\": %.3f, \"error_rate\": %.4f}",
+                   first ? "" : ",", bench->name, bench_dist_names[dist], stats->ns_per_op,
+                   stats->mops, stats->p50_ns, stats->p99_ns, stats->p999_ns, stats->max_ns,
+                   stats->error_rate);
+            break;
+        default:
+            printf("%-32s %-16s %8.2f %9.1f %8.2f %8.2f %8.2f %9.2f %6.1f%%\n", bench->name,
+                   bench_dist_names[dist], stats->ns_per_op, stats->mops, stats->p50_ns,
+                   stats->p99_ns, stats->p999_ns, stats->max_ns, stats->error_rate * 100.0);
+            break;
+    }
+}
+
+static void bench_print_footer(bench_format_t format) {
+    if (format == BENCH_FORMAT_JSON) {
+        printf("\n  ]\n}\n");
+    }
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+int main(int argc, char *argv[]) {
+    bench_format_t format = BENCH_FORMAT_TEXT;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            format = BENCH_FORMAT_CSV;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            format = BENCH_FORMAT_JSON;
+        } else {
+            fprintf(stderr, "usage: %s [--csv | --json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "bench_calculator: setup failed\n");
+        return 1;
+    }
+    bench_calibrate_timer();
+    bench_print_header(format);
+
+    bool first = true;
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        for (int dist = 0; dist < BENCH_DIST_COUNT; dist++) {
+            bench_stats_t stats;
+            if (!bench_fill(&bench_cases[c], (bench_dist_t)dist)) {
+                continue;
+            }
+            bench_measure(&bench_cases[c], &stats);
+            bench_print_row(format, &bench_cases[c], (bench_dist_t)dist, &stats, first);
+            first = false;
+        }
+    }
+
+    bench_print_footer(format);
+    calculator_cleanup();
+    return 0;
+}
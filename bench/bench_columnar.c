@@ -0,0 +1,117 @@
+// ==========================================
+// FILE: bench_columnar.c
+// ==========================================
+/**
+ * @file bench_columnar.c
+ * @brief Columnar benchmark - Text batch versus columnar evaluation
+ * @details Writes a million operation lines in runs of one op, then
+ *          reports nanoseconds per row for evaluating them as text
+ *          (batch_mode_run_file() into /dev/null), for converting them to a
+ *          columnar file, and for evaluating the columnar file in place.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "batch_mode.h"
+#include "columnar.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Rows per run */
+#define BENCH_ROWS (1 << 20)
+
+/** Rows per run of one op */
+#define BENCH_RUN_ROWS 4096
+
+/** Scratch files, next to the benchmark binaries (the Makefile sets BENCH_DIR) */
+#ifndef BENCH_DIR
+#define BENCH_DIR "build/bench"
+#endif
+#define BENCH_TEXT_PATH BENCH_DIR "/bench_columnar.txt"
+#define BENCH_COLUMNAR_PATH BENCH_DIR "/bench_columnar.col"
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void bench_report(const char *name, double elapsed_ns) {
+    printf("%-28s %8.2f ns/row\n", name, elapsed_ns / BENCH_ROWS);
+}
+
+/** Write BENCH_ROWS lines cycling through add, sub, mul, div and pow runs */
+static int bench_write_text(void) {
+    static const char *const ops[] = { "add", "sub", "mul", "div", "pow" };
+    FILE *text = fopen(BENCH_TEXT_PATH, "w");
+    if (text == NULL) {
+        return -1;
+    }
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        double a = (double)((r * 7919) % 100003) / 101.0 + 1.0;
+        double b = (double)((r * 104729) % 1009) / 97.0 + 0.5;
+        fprintf(text, "%s %.17g %.17g\n", ops[(r / BENCH_RUN_ROWS) % 5], a, b);
+    }
+    return fclose(text);
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+int main(void) {
+    columnar_file_t file;
+    calc_batch_summary_t summary;
+    batch_stats_t stats;
+    size_t rows;
+
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0 || calculator_initialize() != CALC_SUCCESS || bench_write_text() != 0) {
+        fprintf(stderr, "bench_columnar: setup failed\n");
+        return 1;
+    }
+
+    double start = bench_now_ns();
+    batch_mode_run_file(BENCH_TEXT_PATH, null_fd, NULL, &stats);
+    bench_report("text batch (parse + format)", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    if (columnar_convert_text(BENCH_TEXT_PATH, BENCH_COLUMNAR_PATH, &rows) != COLUMNAR_SUCCESS ||
+        rows != BENCH_ROWS) {
+        fprintf(stderr, "bench_columnar: conversion failed\n");
+        return 1;
+    }
+    bench_report("columnar_convert_text", bench_now_ns() - start);
+
+    if (columnar_open(BENCH_COLUMNAR_PATH, true, &file) != COLUMNAR_SUCCESS) {
+        fprintf(stderr, "bench_columnar: open failed\n");
+        return 1;
+    }
+    // Untimed pass so both evaluations start from pages that are mapped in
+    columnar_evaluate(&file, &summary);
+    start = bench_now_ns();
+    columnar_evaluate(&file, &summary);
+    bench_report("columnar_evaluate", bench_now_ns() - start);
+    columnar_close(&file);
+
+    printf("rows: %zu text, %zu columnar; failed: %zu text, %zu columnar\n",
+           stats.lines, rows, stats.failed, summary.failed);
+
+    close(null_fd);
+    unlink(BENCH_TEXT_PATH);
+    unlink(BENCH_COLUMNAR_PATH);
+    calculator_cleanup();
+    return 0;
+}
@@ -0,0 +1,103 @@
+// ==========================================
+// FILE: bench_expr.c
+// ==========================================
+/**
+ * @file bench_expr.c
+ * @brief Expression benchmark - parse and evaluate throughput
+ * @details Parses and evaluates a fixed set of short expressions in a loop
+ *          and reports nanoseconds and expressions per second for parsing
+ *          alone and for parsing plus evaluation, on one core. Every
+ *          expression is parsed into an arena that is reset afterwards, as
+ *          the menu does.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "expr.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Number of passes over the expression set */
+#define BENCH_PASSES 200000
+
+/** Short expressions of the kind typed at the menu */
+static const char *const bench_expressions[] = {
+    "(1.5 + 2.25) * 3 ^ 2",
+    "100 / 7 - 3 * 2",
+    "-2 ^ 2 + 17 % 5",
+    "2 ^ 10 / (1 + 1e-3)",
+    "((4 - 1) * (5 + 2)) / 3",
+    "0.1 + 0.2 + 0.3 + 0.4",
+    "12345.678 * -0.001",
+    "(3 + 4) * (5 - 6) ^ 3"
+};
+
+#define BENCH_EXPRESSION_COUNT (sizeof(bench_expressions) / sizeof(bench_expressions[0]))
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+/** Sink that keeps the compiler from dropping the work */
+static volatile double bench_sink;
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void bench_report(const char *name, double elapsed_ns) {
+    double count = (double)BENCH_EXPRESSION_COUNT * BENCH_PASSES;
+    printf("%-28s %8.1f ns/expr %10.2f M expr/s\n", name, elapsed_ns / count, count / elapsed_ns * 1e3);
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+int main(void) {
+    expr_t expr;
+    arena_t arena;
+    size_t lengths[BENCH_EXPRESSION_COUNT];
+    double value;
+
+    arena_init(&arena, 0, 0);
+
+    for (size_t i = 0; i < BENCH_EXPRESSION_COUNT; i++) {
+        lengths[i] = strlen(bench_expressions[i]);
+    }
+
+    double start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < BENCH_EXPRESSION_COUNT; i++) {
+            expr_parse(bench_expressions[i], lengths[i], &arena, &expr);
+            bench_sink += expr.count;
+            arena_reset(&arena);
+        }
+    }
+    bench_report("expr_parse", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < BENCH_EXPRESSION_COUNT; i++) {
+            expr_parse(bench_expressions[i], lengths[i], &arena, &expr);
+            if (expr_evaluate(&expr, &value) == CALC_SUCCESS) {
+                bench_sink += value;
+            }
+            arena_reset(&arena);
+        }
+    }
+    bench_report("expr_parse + expr_evaluate", bench_now_ns() - start);
+
+    arena_stats_t stats = arena_stats(&arena);
+    printf("arena: peak %zu bytes, reserved %zu bytes\n", stats.peak, stats.reserved);
+    arena_destroy(&arena);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// ==========================================
+// FILE: bench_format.c
+// ==========================================
+/**
+ * @file bench_format.c
+ * @brief Formatting benchmark - format.h versus snprintf
+ * @details Formats the same set of doubles with snprintf and with the format
+ *          subsystem in both modes and reports nanoseconds per value.
+ *          Values are drawn once from a fixed-seed generator so runs are
+ *          comparable across builds.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "format.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Number of distinct values formatted per pass */
+#define BENCH_VALUE_COUNT 4096
+
+/** Number of passes over the value set */
+#define BENCH_PASSES 256
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static double bench_values[BENCH_VALUE_COUNT];
+
+/** Sink that keeps the compiler from dropping the formatting work */
+static volatile size_t bench_sink;
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/** Fill the value set: half arbitrary bit patterns, half short decimals */
+static void bench_fill_values(void) {
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    for (size_t i = 0; i < BENCH_VALUE_COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (i % 2 == 0) {
+            uint64_t bits = state & 0x7FEFFFFFFFFFFFFFu;
+            memcpy(&bench_values[i], &bits, sizeof(bits));
+        } else {
+            bench_values[i] = (double)(state % 1000000) / 100.0;
+        }
+    }
+}
+
+static void bench_report(const char *name, double elapsed_ns) {
+    double values = (double)BENCH_VALUE_COUNT * BENCH_PASSES;
+    printf("%-28s %8.1f ns/value\n", name, elapsed_ns / values);
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+static void bench_snprintf(const char *name, const char *format) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    double start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < BENCH_VALUE_COUNT; i++) {
+            bench_sink += (size_t)snprintf(buffer, sizeof(buffer), format, bench_values[i]);
+        }
+    }
+    bench_report(name, bench_now_ns() - start);
+}
+
+static void bench_shortest(void) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    double start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < BENCH_VALUE_COUNT; i++) {
+            bench_sink += format_double_shortest(bench_values[i], buffer);
+        }
+    }
+    bench_report("format_double_shortest", bench_now_ns() - start);
+}
+
+static void bench_general(void) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    double start = bench_now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < BENCH_VALUE_COUNT; i++) {
+            bench_sink += format_double_general(bench_values[i], FORMAT_DISPLAY_PRECISION, buffer);
+        }
+    }
+    bench_report("format_double_general(6)", bench_now_ns() - start);
+}
+
+int main(void) {
+    bench_fill_values();
+    bench_snprintf("snprintf(\"%.17g\")", "%.17g");
+    bench_shortest();
+    bench_snprintf("snprintf(\"%.6g\")", "%.6g");
+    bench_general();
+    return 0;
+}
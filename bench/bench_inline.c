@@ -0,0 +1,172 @@
+// ==========================================
+// FILE: bench_inline.c
+// ==========================================
+/**
+ * @file bench_inline.c
+ * @brief Inline benchmark - calculator_* calls versus calculator_inline_*
+ * @details Runs the same element loop over each operation twice: once
+ *          calling the out-of-line calculator_* function in libcalc and
+ *          once with its calculator_inline.h version, which the compiler
+ *          can inline into the loop. Reports nanoseconds per element for
+ *          both and the speedup, and checks that both loops produced the
+ *          same results and failure counts. In an LTO build (make LTO=1)
+ *          the out-of-line calls can be inlined too, so the gap closes.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_inline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Elements per loop; small enough to stay in L1 */
+#define BENCH_ELEMENTS 4096
+
+/** Passes over the elements per measurement */
+#define BENCH_PASSES 2048
+
+// ==========================================
+// MARK: - Benchmark Types
+// ==========================================
+
+/** One element loop: returns the number of failed elements */
+typedef size_t (*bench_loop_fn_t)(const double *a, const double *b, double *out, size_t n);
+
+/** A pair of loops over the same operation */
+typedef struct {
+    const char *name;
+    bench_loop_fn_t call;       ///< Loop calling calculator_*
+    bench_loop_fn_t inlined;    ///< Loop using calculator_inline_*
+    bool exponents;             ///< Second operand is a small integer exponent
+} bench_case_t;
+
+// ==========================================
+// MARK: - Loops
+// ==========================================
+
+/** Loop over a (double, double, double *) operation */
+#define BENCH_BINARY_LOOP(name, op)                                             \
+    static size_t name(const double *a, const double *b, double *out, size_t n) { \
+        size_t failed = 0;                                                      \
+        for (size_t i = 0; i < n; i++) {                                        \
+            failed += (op(a[i], b[i], &out[i]) != CALC_SUCCESS);                \
+        }                                                                       \
+        return failed;                                                          \
+    }
+
+/** Loop over a validator; out records the verdict so it can be compared */
+#define BENCH_PREDICATE_LOOP(name, op)                                          \
+    static size_t name(const double *a, const double *b, double *out, size_t n) { \
+        (void)b;                                                                \
+        size_t failed = 0;                                                      \
+        for (size_t i = 0; i < n; i++) {                                        \
+            bool valid = op(a[i]);                                              \
+            out[i] = valid ? 1.0 : 0.0;                                         \
+            failed += !valid;                                                   \
+        }                                                                       \
+        return failed;                                                          \
+    }
+
+BENCH_BINARY_LOOP(bench_call_add, calculator_add)
+BENCH_BINARY_LOOP(bench_inline_add, calculator_inline_add)
+BENCH_BINARY_LOOP(bench_call_subtract, calculator_subtract)
+BENCH_BINARY_LOOP(bench_inline_subtract, calculator_inline_subtract)
+BENCH_BINARY_LOOP(bench_call_multiply, calculator_multiply)
+BENCH_BINARY_LOOP(bench_inline_multiply, calculator_inline_multiply)
+BENCH_BINARY_LOOP(bench_call_divide, calculator_divide)
+BENCH_BINARY_LOOP(bench_inline_divide, calculator_inline_divide)
+BENCH_BINARY_LOOP(bench_call_power, calculator_power)
+BENCH_BINARY_LOOP(bench_inline_power, calculator_inline_power)
+BENCH_PREDICATE_LOOP(bench_call_is_valid, calculator_is_valid_number)
+BENCH_PREDICATE_LOOP(bench_inline_is_valid, calculator_inline_is_valid_number)
+
+static const bench_case_t bench_cases[] = {
+    { "add",             bench_call_add,      bench_inline_add,      false },
+    { "subtract",        bench_call_subtract, bench_inline_subtract, false },
+    { "multiply",        bench_call_multiply, bench_inline_multiply, false },
+    { "divide",          bench_call_divide,   bench_inline_divide,   false },
+    { "power (integer)", bench_call_power,    bench_inline_power,    true },
+    { "is_valid_number", bench_call_is_valid, bench_inline_is_valid, false },
+};
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/** Nanoseconds per element of one loop; failed receives its failure count */
+static double bench_time(bench_loop_fn_t loop, const double *a, const double *b, double *out,
+                         size_t *failed) {
+    *failed = loop(a, b, out, BENCH_ELEMENTS);
+    double start = bench_now_ns();
+    for (size_t pass = 0; pass < BENCH_PASSES; pass++) {
+        loop(a, b, out, BENCH_ELEMENTS);
+    }
+    return (bench_now_ns() - start) / ((double)BENCH_PASSES * BENCH_ELEMENTS);
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+int main(void) {
+    static double a[BENCH_ELEMENTS];
+    static double b[BENCH_ELEMENTS];
+    static double exponents[BENCH_ELEMENTS];
+    static double out_call[BENCH_ELEMENTS];
+    static double out_inline[BENCH_ELEMENTS];
+
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "bench_inline: setup failed\n");
+        return 1;
+    }
+
+    // Mostly normal operands; every 64th element is one the checks reject
+    srand(42);
+    for (size_t i = 0; i < BENCH_ELEMENTS; i++) {
+        a[i] = ((double)rand() / RAND_MAX - 0.5) * 2e3;
+        b[i] = ((double)rand() / RAND_MAX - 0.5) * 2e3;
+        exponents[i] = (double)(rand() % 17 - 8);
+        if (i % 64 == 63) {
+            b[i] = (i % 128 == 127) ? 0.0 : NAN;
+        }
+        if (i % 256 == 255) {
+            a[i] = INFINITY;
+        }
+    }
+
+    printf("%-18s %12s %12s %9s\n", "operation", "call ns/el", "inline ns/el", "speedup");
+    int status = 0;
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        const bench_case_t *bench = &bench_cases[c];
+        const double *second = bench->exponents ? exponents : b;
+        size_t failed_call;
+        size_t failed_inline;
+        memset(out_call, 0, sizeof(out_call));
+        memset(out_inline, 0, sizeof(out_inline));
+
+        double call_ns = bench_time(bench->call, a, second, out_call, &failed_call);
+        double inline_ns = bench_time(bench->inlined, a, second, out_inline, &failed_inline);
+        printf("%-18s %12.2f %12.2f %8.2fx\n", bench->name, call_ns, inline_ns, call_ns / inline_ns);
+
+        if (failed_call != failed_inline || memcmp(out_call, out_inline, sizeof(out_call)) != 0) {
+            fprintf(stderr, "bench_inline: %s results differ\n", bench->name);
+            status = 1;
+        }
+    }
+
+    calculator_cleanup();
+    return status;
+}
@@ -0,0 +1,120 @@
+// ==========================================
+// FILE: bench_vm.c
+// ==========================================
+/**
+ * @file bench_vm.c
+ * @brief VM benchmark - AST walk versus bytecode versus column mode
+ * @details Evaluates one formula over a million rows of inputs three ways:
+ *          expr_evaluate_inputs() per row, vm_execute() per row and
+ *          vm_execute_columns() over the whole columns, and reports
+ *          nanoseconds per row.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "vm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==========================================
+// MARK: - Benchmark Constants
+// ==========================================
+
+/** Rows per run */
+#define BENCH_ROWS (1 << 20)
+
+/** Number of input columns */
+#define BENCH_COLUMNS 3
+
+/** Formula evaluated for every row */
+#define BENCH_FORMULA "(col1 + 2.5) * col2 - col3 / 7 + col1 * col1"
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+/** Sink that keeps the compiler from dropping the work */
+static volatile double bench_sink;
+
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void bench_report(const char *name, double elapsed_ns) {
+    printf("%-28s %8.2f ns/row\n", name, elapsed_ns / BENCH_ROWS);
+}
+
+// ==========================================
+// MARK: - Benchmarks
+// ==========================================
+
+int main(void) {
+    expr_t expr;
+    vm_program_t program;
+    arena_t arena;
+    double *columns[BENCH_COLUMNS];
+    double *out = malloc(BENCH_ROWS * sizeof(double));
+
+    arena_init(&arena, 0, 0);
+    if (out == NULL || calculator_initialize() != CALC_SUCCESS ||
+        expr_parse(BENCH_FORMULA, strlen(BENCH_FORMULA), &arena, &expr) != EXPR_SUCCESS ||
+        vm_compile(&expr, &arena, &program) != VM_SUCCESS) {
+        fprintf(stderr, "bench_vm: setup failed\n");
+        return 1;
+    }
+
+    for (int c = 0; c < BENCH_COLUMNS; c++) {
+        columns[c] = malloc(BENCH_ROWS * sizeof(double));
+        if (columns[c] == NULL) {
+            fprintf(stderr, "bench_vm: out of memory\n");
+            return 1;
+        }
+        for (size_t r = 0; r < BENCH_ROWS; r++) {
+            columns[c][r] = (double)((r * 7919 + (size_t)c * 104729) % 100003) / 101.0 + 1.0;
+        }
+    }
+
+    printf("formula: %s (%u instructions, %u registers)\n", BENCH_FORMULA,
+           program.code_length, program.register_count);
+
+    double inputs[BENCH_COLUMNS];
+    double value;
+    double start = bench_now_ns();
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        for (int c = 0; c < BENCH_COLUMNS; c++) {
+            inputs[c] = columns[c][r];
+        }
+        if (expr_evaluate_inputs(&expr, inputs, BENCH_COLUMNS, expr.values, &value) == CALC_SUCCESS) {
+            bench_sink += value;
+        }
+    }
+    bench_report("expr_evaluate_inputs (AST)", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t r = 0; r < BENCH_ROWS; r++) {
+        for (int c = 0; c < BENCH_COLUMNS; c++) {
+            inputs[c] = columns[c][r];
+        }
+        if (vm_execute(&program, inputs, BENCH_COLUMNS, &value) == CALC_SUCCESS) {
+            bench_sink += value;
+        }
+    }
+    bench_report("vm_execute (bytecode)", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    vm_execute_columns(&program, (const double *const *)columns, BENCH_COLUMNS, out, BENCH_ROWS, NULL);
+    bench_report("vm_execute_columns", bench_now_ns() - start);
+    bench_sink += out[BENCH_ROWS - 1];
+
+    for (int c = 0; c < BENCH_COLUMNS; c++) {
+        free(columns[c]);
+    }
+    free(out);
+    arena_destroy(&arena);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// ==========================================
+// FILE: arena.h
+// ==========================================
+/**
+ * @file arena.h
+ * @brief Arena subsystem header - Bump allocation with scoped resets
+ * @details Defines a bump allocator over a chain of blocks. Allocation is a
+ *          pointer increment; memory is never freed piecemeal. A batch
+ *          scope resets the whole arena, while an expression scope takes a
+ *          mark first and releases back to it, so per-expression memory is
+ *          reused without returning blocks to malloc. Counters report the
+ *          peak number of bytes in use so arenas can be sized for
+ *          production workloads. Library callers own the arenas that
+ *          expr_parse() and vm_compile() fill, so the lifecycle and scope
+ *          calls are exported by libcalc.so; allocation and the counters
+ *          are engine internal.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - Arena Constants
+// ==========================================
+
+/** Default size of each block obtained from malloc */
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/** Alignment of every allocation */
+#define ARENA_ALIGNMENT 16
+
+// ==========================================
+// MARK: - Arena Types
+// ==========================================
+
+/** One malloc'd block; the arena bumps through data */
+typedef struct arena_block arena_block_t;
+
+/** Bump allocator */
+typedef struct {
+    arena_block_t *first;       ///< First block, or NULL before the first allocation
+    arena_block_t *current;     ///< Block allocations are served from
+    size_t block_size;          ///< Size of regular blocks
+    size_t limit;               ///< Maximum bytes reserved from malloc, 0 for no limit
+    size_t used;                ///< Bytes handed out since the last reset, padding included
+    size_t peak;                ///< Highest value of used since init
+    size_t reserved;            ///< Bytes currently reserved from malloc
+} arena_t;
+
+/** Position to release back to when an expression scope ends */
+typedef struct {
+    arena_block_t *block;       ///< Current block when the mark was taken
+    size_t offset;              ///< Its fill level at that time
+    size_t used;                ///< arena_t.used at that time
+} arena_mark_t;
+
+/** Usage counters */
+typedef struct {
+    size_t used;                ///< Bytes in use now
+    size_t peak;                ///< Peak bytes in use
+    size_t reserved;            ///< Bytes reserved from malloc
+} arena_stats_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Initialize an arena
+ * @details No memory is reserved until the first allocation.
+ * @param arena Arena to initialize
+ * @param block_size Size of regular blocks, or 0 for ARENA_DEFAULT_BLOCK_SIZE
+ * @param limit Maximum bytes to reserve from malloc, or 0 for no limit
+ */
+CALC_API void arena_init(arena_t *arena, size_t block_size, size_t limit);
+
+/**
+ * @brief Release all blocks
+ * @param arena Arena to destroy; it may be initialized again afterwards
+ */
+CALC_API void arena_destroy(arena_t *arena);
+
+/**
+ * @brief Allocate memory
+ * @details Requests larger than a block get a block of their own.
+ * @param arena Initialized arena
+ * @param size Number of bytes
+ * @return ARENA_ALIGNMENT-aligned memory, or NULL if malloc failed or the
+ *         limit would be exceeded
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief End a batch scope
+ * @details Makes every block available again without freeing it.
+ * @param arena Initialized arena
+ */
+CALC_API void arena_reset(arena_t *arena);
+
+/**
+ * @brief Begin an expression scope
+ * @param arena Initialized arena
+ * @return Mark to pass to arena_release()
+ */
+CALC_API arena_mark_t arena_mark(const arena_t *arena);
+
+/**
+ * @brief End an expression scope
+ * @details Frees everything allocated since the mark was taken.
+ * @param arena Arena the mark was taken from
+ * @param mark Mark returned by arena_mark()
+ */
+CALC_API void arena_release(arena_t *arena, arena_mark_t mark);
+
+/**
+ * @brief Get usage counters
+ * @param arena Initialized arena
+ * @return Current, peak and reserved byte counts
+ */
+arena_stats_t arena_stats(const arena_t *arena);
+
+#endif /* ARENA_H */
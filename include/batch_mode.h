@@ -0,0 +1,168 @@
+// ==========================================
+// FILE: batch_mode.h
+// ==========================================
+/**
+ * @file batch_mode.h
+ * @brief Batch mode header - Headless evaluation of operation files
+ * @details Defines the non-interactive front end used by `calc --batch`.
+ *          Input is one operation per line (`add 1.5 2`); output is one
+ *          result per line, either the value or `error: <name>`. Blank lines
+ *          and lines starting with '#' are skipped without output.
+ *          Regular files are mapped and evaluated in parallel chunks;
+ *          pipes and stdin are streamed through a read() window.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef BATCH_MODE_H
+#define BATCH_MODE_H
+
+#include <stddef.h>
+#include "calculator.h"
+#include "output.h"
+
+// ==========================================
+// MARK: - Batch Mode Constants
+// ==========================================
+
+/** Input window and output buffer size; also the longest accepted line */
+#define BATCH_IO_BUFFER_SIZE (1 << 20)
+
+/** Path that selects standard input */
+#define BATCH_STDIN_PATH "-"
+
+/** Mapped input: bytes per pool task (rounded up to a line end) */
+#define BATCH_MAPPED_CHUNK_SIZE (256 * 1024)
+
+/** Mapped input: chunks evaluated together before their results are written */
+#define BATCH_MAPPED_CHUNKS 64
+
+// ==========================================
+// MARK: - Batch Mode Types
+// ==========================================
+
+/** Batch mode result codes */
+typedef enum {
+    BATCH_SUCCESS = 0,          ///< Whole input processed
+    BATCH_ERROR_INVALID_INPUT,  ///< Invalid argument
+    BATCH_ERROR_IO,             ///< Input could not be opened, read or written
+    BATCH_ERROR_MEMORY          ///< Input window could not be allocated
+} batch_result_t;
+
+/** Classification of one input line */
+typedef enum {
+    BATCH_LINE_OPERATION = 0,   ///< Operation parsed
+    BATCH_LINE_SKIP,            ///< Blank line or comment, produces no output
+    BATCH_LINE_INVALID          ///< Malformed line, reported as invalid input
+} batch_line_t;
+
+/** Operations understood by batch mode */
+typedef enum {
+    BATCH_OP_ADD = 0,           ///< add, +
+    BATCH_OP_SUBTRACT,          ///< sub, subtract, -
+    BATCH_OP_MULTIPLY,          ///< mul, multiply, *
+    BATCH_OP_DIVIDE,            ///< div, divide, /
+    BATCH_OP_MODULUS,           ///< mod, modulus, %
+    BATCH_OP_POWER,             ///< pow, power, ^
+    BATCH_OP_INVALID            ///< Unknown operation name
+} batch_op_t;
+
+/** One parsed operation line */
+typedef struct {
+    batch_op_t op;              ///< Operation to perform
+    double a;                   ///< First operand
+    double b;                   ///< Second operand
+} batch_operation_t;
+
+/** Counters for one batch run */
+typedef struct {
+    size_t lines;               ///< Operation lines evaluated
+    size_t failed;              ///< Lines that produced an error
+    size_t arena_peak;          ///< Peak bytes used from the run's arena
+} batch_stats_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Evaluate an operations file
+ * @details Opens the file (or stdin for "-"). Regular files are evaluated
+ *          with batch_mode_run_mapped() unless the policy asks for timely
+ *          flushes; everything else is streamed through batch_mode_run().
+ * @param path Input path, or BATCH_STDIN_PATH
+ * @param output_fd File descriptor receiving one result per line
+ * @param policy Flush policy for results, or NULL to flush only when the
+ *               output buffer fills and at the end
+ * @param stats Counters to fill in, or NULL
+ * @return BATCH_SUCCESS on success, error code on failure
+ */
+batch_result_t batch_mode_run_file(const char *path, int output_fd,
+                                   const output_flush_policy_t *policy, batch_stats_t *stats);
+
+/**
+ * @brief Evaluate an operations stream
+ * @details Reads lines until EOF and writes one result line per operation.
+ *          Calculation errors and malformed or overlong lines are reported
+ *          inline and do not stop the run.
+ *          Each result line is one record of the output flush policy.
+ * @param input_fd File descriptor of the operation lines
+ * @param output_fd File descriptor receiving one result per line
+ * @param policy Flush policy for results, or NULL to flush only when the
+ *               output buffer fills and at the end
+ * @param stats Counters to fill in, or NULL
+ * @return BATCH_SUCCESS on success, error code on failure
+ */
+batch_result_t batch_mode_run(int input_fd, int output_fd,
+                              const output_flush_policy_t *policy, batch_stats_t *stats);
+
+/**
+ * @brief Evaluate a memory-mapped operations file
+ * @details Maps the file and cuts it into line-aligned chunks of about
+ *          BATCH_MAPPED_CHUNK_SIZE bytes that the thread pool parses and
+ *          evaluates in place, straight from the mapped pages. Results are
+ *          written chunk by chunk in input order, so the output is the same
+ *          as batch_mode_run() produces; pages already evaluated are handed
+ *          back to the kernel as the run advances. Falls back to
+ *          batch_mode_run() when the file cannot be mapped.
+ * @param input_fd File descriptor of the operation lines, read from offset 0
+ * @param output_fd File descriptor receiving one result per line
+ * @param stats Counters to fill in, or NULL
+ * @return BATCH_SUCCESS on success, error code on failure
+ */
+batch_result_t batch_mode_run_mapped(int input_fd, int output_fd, batch_stats_t *stats);
+
+/**
+ * @brief Parse one operation line
+ * @details Expects `<op> <a> <b>` separated by blanks; numbers use the
+ *          locale-independent parser.
+ * @param line Start of the line (no newline)
+ * @param length Length of the line in bytes
+ * @param operation Pointer to store the parsed operation
+ * @return Classification of the line; operation is only valid for
+ *         BATCH_LINE_OPERATION
+ */
+batch_line_t batch_mode_parse_line(const char *line, size_t length, batch_operation_t *operation);
+
+/**
+ * @brief Look up an operation by name
+ * @param name Operation name or symbol
+ * @param length Length of name in bytes
+ * @return Matching operation, or BATCH_OP_INVALID
+ */
+batch_op_t batch_mode_parse_op(const char *name, size_t length);
+
+/**
+ * @brief Evaluate one operation through the calculator engine
+ * @details Modulus operands are truncated to int64_t as in the interactive
+ *          menu; values outside int64_t range are rejected as invalid input.
+ * @param op Operation to perform
+ * @param a First operand
+ * @param b Second operand
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, error code on failure
+ */
+calc_result_t batch_mode_evaluate(batch_op_t op, double a, double b, double *result);
+
+#endif /* BATCH_MODE_H */
@@ -0,0 +1,40 @@
+// ==========================================
+// FILE: calc_api.h
+// ==========================================
+/**
+ * @file calc_api.h
+ * @brief Library export header - Symbol visibility of the engine API
+ * @details The engine is compiled with -fvisibility=hidden, so libcalc.so
+ *          exports only the functions whose prototypes are marked CALC_API.
+ *          That set is the supported library API:
+ *          - calculator.h: the scalar operations, modes and result names
+ *          - calculator_batch.h, calculator_reduce.h: the array operations,
+ *            prepared divisors and reductions
+ *          - calculator_dispatch.h: the active kernel level and its name
+ *          - expr.h, vm.h: parsing, evaluation, compilation and execution
+ *            of expressions, plus the arena.h lifecycle calls they need
+ *            (init, destroy, reset, mark, release)
+ *          Everything else, including the batch-mode, columnar, CSV, pool
+ *          and output layers behind build/calc and the helpers the engine
+ *          shares between its own translation units, stays private to the
+ *          library. libcalc.a and build/calc still link every symbol.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALC_API_H
+#define CALC_API_H
+
+// ==========================================
+// MARK: - Visibility
+// ==========================================
+
+/** Marks a function as part of the exported library API */
+#if defined(__GNUC__) || defined(__clang__)
+#define CALC_API __attribute__((visibility("default")))
+#else
+#define CALC_API
+#endif
+
+#endif /* CALC_API_H */
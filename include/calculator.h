@@ -16,8 +16,11 @@
 #define CALCULATOR_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <math.h>
 #include <limits.h>
+#include <fenv.h>
+#include "calc_api.h"
 // ==========================================
 // MARK: - Calculator Constants
 // ==========================================
@@ -31,6 +34,21 @@
 /** Minimum safe integer for modulus operations */
 #define CALC_MIN_SAFE_INTEGER INT_MIN
 
+/** Doubles in [-CALC_I64_DOUBLE_LIMIT, CALC_I64_DOUBLE_LIMIT) convert to int64_t (2^63) */
+#define CALC_I64_DOUBLE_LIMIT 9223372036854775808.0
+
+/** Largest |exponent| raised by squaring instead of pow() */
+#define CALC_POWER_INTEGER_MAX 64
+
+/** Environment variable that selects the error mode ("errno" or "fenv") */
+#define CALC_ERROR_MODE_ENV "CALC_ERROR_MODE"
+
+/** Environment variable that selects the denormal mode ("preserve" or "flush") */
+#define CALC_DENORMAL_MODE_ENV "CALC_DENORMAL_MODE"
+
+/** Floating-point exception flags mapped onto result codes */
+#define CALC_FENV_FLAGS (FE_INVALID | FE_DIVBYZERO | FE_OVERFLOW | FE_UNDERFLOW)
+
 // ==========================================
 // MARK: - Calculator Types
 // ==========================================
@@ -46,6 +64,18 @@ typedef enum {
     CALC_ERROR_INIT                 ///< Calculator initialization error
 } calc_result_t;
 
+/** How libm errors are detected around pow() */
+typedef enum {
+    CALC_ERROR_MODE_ERRNO = 0,      ///< Clear and read errno around every pow() call
+    CALC_ERROR_MODE_FENV            ///< Leave errno alone; batches test the FE_* flags once
+} calc_error_mode_t;
+
+/** How batches treat subnormal operands and results */
+typedef enum {
+    CALC_DENORMAL_MODE_PRESERVE = 0, ///< IEEE gradual underflow; tiny results fail with CALC_ERROR_UNDERFLOW
+    CALC_DENORMAL_MODE_FLUSH         ///< Batches run with DAZ/FTZ; tiny results become zero and are counted
+} calc_denormal_mode_t;
+
 // ==========================================
 // MARK: - Function Prototypes
 // ==========================================
@@ -56,14 +86,83 @@ typedef enum {
  *          internal state, and validates the mathematical environment.
  * @return CALC_SUCCESS on success, appropriate error code on failure
  */
-calc_result_t calculator_initialize(void);
+CALC_API calc_result_t calculator_initialize(void);
+
+/**
+ * @brief Select how libm errors are detected
+ * @details In CALC_ERROR_MODE_FENV, calculator_power() classifies pow()
+ *          results from their value alone and never touches errno, and
+ *          calculator_power_batch() clears the exception flags once before
+ *          the batch and tests them once after it, classifying elements
+ *          individually only if an error flag was raised. Result codes are
+ *          the same in both modes. calculator_initialize() applies
+ *          CALC_ERROR_MODE if it is set.
+ * @param mode Mode to activate
+ * @return CALC_SUCCESS on success, CALC_ERROR_INVALID_INPUT if the mode is unknown
+ */
+CALC_API calc_result_t calculator_set_error_mode(calc_error_mode_t mode);
+
+/**
+ * @brief Get the active error mode
+ * @return Mode set by calculator_set_error_mode() or CALC_ERROR_MODE
+ */
+CALC_API calc_error_mode_t calculator_get_error_mode(void);
+
+/**
+ * @brief Convert an error mode to its CALC_ERROR_MODE spelling
+ * @param mode The mode to convert
+ * @return Mode name, or "unknown" if invalid
+ */
+CALC_API const char *calculator_error_mode_name(calc_error_mode_t mode);
+
+/**
+ * @brief Select how batches treat subnormal numbers
+ * @details In CALC_DENORMAL_MODE_FLUSH every batch body run by
+ *          calculator_batch_parallel() executes with the MXCSR DAZ and FTZ
+ *          bits set: subnormal operands read as zero and results too small
+ *          for a normal double become zero, which avoids the microcode
+ *          assists subnormals cost on x86. Such results are not failures;
+ *          each one is counted in calc_batch_summary_t.flushed instead of
+ *          being reported as CALC_ERROR_UNDERFLOW. Scalar calls are not
+ *          affected. calculator_initialize() applies CALC_DENORMAL_MODE if
+ *          it is set.
+ * @param mode Mode to activate
+ * @return CALC_SUCCESS on success, CALC_ERROR_INVALID_INPUT if the mode is
+ *         unknown or the CPU has no MXCSR (non-x86, or x86 without SSE2)
+ */
+CALC_API calc_result_t calculator_set_denormal_mode(calc_denormal_mode_t mode);
+
+/**
+ * @brief Get the active denormal mode
+ * @return Mode set by calculator_set_denormal_mode() or CALC_DENORMAL_MODE
+ */
+CALC_API calc_denormal_mode_t calculator_get_denormal_mode(void);
+
+/**
+ * @brief Convert a denormal mode to its CALC_DENORMAL_MODE spelling
+ * @param mode The mode to convert
+ * @return Mode name, or "unknown" if invalid
+ */
+CALC_API const char *calculator_denormal_mode_name(calc_denormal_mode_t mode);
+
+/**
+ * @brief Map floating-point exception flags onto a result code
+ * @details FE_INVALID maps to CALC_ERROR_DOMAIN, FE_DIVBYZERO to
+ *          CALC_ERROR_DIVISION_BY_ZERO, FE_OVERFLOW to CALC_ERROR_OVERFLOW
+ *          and FE_UNDERFLOW to CALC_ERROR_UNDERFLOW, in that order of
+ *          precedence. Other flags, FE_INEXACT included, are ignored.
+ *          Engine internal: not exported by libcalc.so.
+ * @param flags Flags as returned by fetestexcept()
+ * @return Code of the most severe flag, or CALC_SUCCESS if none is set
+ */
+calc_result_t calculator_fenv_result(int flags);
 
 /**
  * @brief Clean up calculator resources
  * @details Releases any resources allocated by the calculator engine
  *          and prepares for termination.
  */
-void calculator_cleanup(void);
+CALC_API void calculator_cleanup(void);
 
 /**
  * @brief Perform addition operation
@@ -75,7 +174,7 @@ void calculator_cleanup(void);
  * @pre result must not be NULL
  * @post result contains a + b if CALC_SUCCESS returned
  */
-calc_result_t calculator_add(double a, double b, double *result);
+CALC_API calc_result_t calculator_add(double a, double b, double *result);
 
 /**
  * @brief Perform subtraction operation
@@ -87,11 +186,12 @@ calc_result_t calculator_add(double a, double b, double *result);
  * @pre result must not be NULL
  * @post result contains a - b if CALC_SUCCESS returned
  */
-calc_result_t calculator_subtract(double a, double b, double *result);
+CALC_API calc_result_t calculator_subtract(double a, double b, double *result);
 
 /**
  * @brief Perform multiplication operation
- * @details Computes the product of two numbers with overflow detection.
+ * @details Computes the product of two numbers with overflow and underflow
+ *          detection.
  * @param a First factor
  * @param b Second factor
  * @param result Pointer to store the result
@@ -99,11 +199,12 @@ calc_result_t calculator_subtract(double a, double b, double *result);
  * @pre result must not be NULL
  * @post result contains a * b if CALC_SUCCESS returned
  */
-calc_result_t calculator_multiply(double a, double b, double *result);
+CALC_API calc_result_t calculator_multiply(double a, double b, double *result);
 
 /**
  * @brief Perform division operation
- * @details Computes the quotient of two numbers with division-by-zero checking.
+ * @details Computes the quotient of two numbers with division-by-zero checking
+ *          and overflow and underflow detection.
  * @param a Dividend (number to be divided)
  * @param b Divisor (number to divide by)
  * @param result Pointer to store the result
@@ -111,7 +212,39 @@ calc_result_t calculator_multiply(double a, double b, double *result);
  * @pre result must not be NULL
  * @post result contains a / b if CALC_SUCCESS returned
  */
-calc_result_t calculator_divide(double a, double b, double *result);
+CALC_API calc_result_t calculator_divide(double a, double b, double *result);
+
+/**
+ * @brief Perform fused multiply-add operation
+ * @details Computes a * b + c with a single rounding (hardware FMA), with
+ *          overflow and underflow detection on the fused result. Replaces
+ *          calculator_multiply() followed by calculator_add(), which
+ *          rounds twice and can overflow in the product alone.
+ * @param a First factor
+ * @param b Second factor
+ * @param c Addend
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, error code on failure
+ * @pre result must not be NULL
+ * @post result contains a * b + c if CALC_SUCCESS returned
+ */
+CALC_API calc_result_t calculator_fma(double a, double b, double c, double *result);
+
+/**
+ * @brief Perform linear interpolation
+ * @details Computes a + t * (b - a) as fma(t, b, fma(-t, a, a)): two fused
+ *          steps and no rounded b - a, so t == 0 gives a and t == 1 gives b
+ *          exactly. t outside [0, 1] extrapolates. Overflow and underflow
+ *          detection applies to the result.
+ * @param a Value at t == 0
+ * @param b Value at t == 1
+ * @param t Interpolation parameter
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, error code on failure
+ * @pre result must not be NULL
+ * @post result contains a + t * (b - a) if CALC_SUCCESS returned
+ */
+CALC_API calc_result_t calculator_lerp(double a, double b, double t, double *result);
 
 /**
  * @brief Perform modulus operation
@@ -123,11 +256,26 @@ calc_result_t calculator_divide(double a, double b, double *result);
  * @pre result must not be NULL
  * @post result contains a % b if CALC_SUCCESS returned
  */
-calc_result_t calculator_modulus(int a, int b, double *result);
+CALC_API calc_result_t calculator_modulus(int a, int b, double *result);
+
+/**
+ * @brief Perform 64-bit modulus operation
+ * @details Computes the remainder of a / b truncated toward zero, so the
+ *          result has the sign of a. INT64_MIN % -1 is 0 rather than a trap.
+ * @param a Dividend
+ * @param b Divisor
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, CALC_ERROR_DIVISION_BY_ZERO if b is 0
+ * @pre result must not be NULL
+ * @post result contains a % b if CALC_SUCCESS returned
+ */
+CALC_API calc_result_t calculator_modulus_i64(int64_t a, int64_t b, int64_t *result);
 
 /**
  * @brief Perform power operation
  * @details Computes base raised to the power of exponent with domain validation.
+ *          Integral exponents up to CALC_POWER_INTEGER_MAX in magnitude go
+ *          through calculator_power_int(); pow() handles the rest.
  * @param base Base number
  * @param exponent Exponent value
  * @param result Pointer to store the result
@@ -135,30 +283,64 @@ calc_result_t calculator_modulus(int a, int b, double *result);
  * @pre result must not be NULL
  * @post result contains base^exponent if CALC_SUCCESS returned
  */
-calc_result_t calculator_power(double base, double exponent, double *result);
+CALC_API calc_result_t calculator_power(double base, double exponent, double *result);
+
+/**
+ * @brief Perform power operation with an integer exponent
+ * @details Uses exponentiation by squaring when |exponent| is at most
+ *          CALC_POWER_INTEGER_MAX, the result stays in the normal range and
+ *          no step of the squaring can round: the significant bits of base
+ *          times exponent fit in a double (e.g. integer bases with results
+ *          below 2^53), or base is a power of two. Results that are certain
+ *          to overflow are reported without computing them. Everything else
+ *          goes through pow(), so results and error codes match
+ *          calculator_power() exactly.
+ * @param base Base number
+ * @param exponent Exponent value
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, error code on failure
+ * @pre result must not be NULL
+ * @post result contains base^exponent if CALC_SUCCESS returned
+ */
+CALC_API calc_result_t calculator_power_int(double base, int exponent, double *result);
 
 /**
  * @brief Validate numeric input
- * @details Checks if a number is finite and within acceptable ranges.
+ * @details Checks if a number is finite (neither infinite nor NaN) with one
+ *          test of its exponent bits.
  * @param value The number to validate
  * @return true if valid, false otherwise
  */
-bool calculator_is_valid_number(double value);
+CALC_API bool calculator_is_valid_number(double value);
 
 /**
  * @brief Check for numeric overflow
- * @details Determines if a calculation result represents an overflow condition.
+ * @details Determines if a calculation result represents an overflow
+ *          condition: the result is +inf or -inf.
  * @param value The value to check
  * @return true if overflow detected, false otherwise
  */
-bool calculator_is_overflow(double value);
+CALC_API bool calculator_is_overflow(double value);
 
 /**
  * @brief Check for numeric underflow
- * @details Determines if a calculation result represents an underflow condition.
+ * @details Determines if a calculation result represents an underflow
+ *          condition: the result is subnormal. Results that underflowed
+ *          all the way to zero cannot be told from exact zeros by value,
+ *          so the operations also report CALC_ERROR_UNDERFLOW for a zero
+ *          result whose exact value is not zero.
  * @param value The value to check
  * @return true if underflow detected, false otherwise
  */
-bool calculator_is_underflow(double value);
+CALC_API bool calculator_is_underflow(double value);
+
+/**
+ * @brief Convert a result code to a short machine-readable name
+ * @details Returns a stable lowercase identifier (e.g. "division_by_zero")
+ *          suitable for batch output and logs.
+ * @param result The result code to convert
+ * @return Name of the result code, or "unknown" if invalid
+ */
+CALC_API const char *calculator_result_name(calc_result_t result);
 
 #endif /* CALCULATOR_H */
\ No newline at end of file
@@ -0,0 +1,360 @@
+// ==========================================
+// FILE: calculator_batch.h
+// ==========================================
+/**
+ * @file calculator_batch.h
+ * @brief Calculator batch engine header - Array operations
+ * @details Defines the batch interface of the calculator engine. Each entry
+ *          point applies one operation element-wise over arrays of operands
+ *          and reports the same status the scalar operation would have
+ *          returned for every element through a compact error channel:
+ *          one status byte and/or one bit per element, plus per-kind
+ *          failure counts. Vector kernels are selected at runtime from the
+ *          instruction sets the CPU supports.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_BATCH_H
+#define CALCULATOR_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calculator.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - Batch Constants
+// ==========================================
+
+/** Number of elements re-run through the scalar path after a kernel stops */
+#define CALC_BATCH_BLOCK 8
+
+/** Number of distinct calc_result_t codes (size of the summary counters) */
+#define CALC_RESULT_COUNT (CALC_ERROR_INIT + 1)
+
+/** Elements per floating-point flag check of power in CALC_ERROR_MODE_FENV */
+#define CALC_BATCH_FENV_BLOCK 256
+
+/** Number of 64-bit words needed for a failure bitset over n elements */
+#define CALC_BATCH_MASK_WORDS(n) (((n) + 63) / 64)
+
+/**
+ * Elements per task handed to the thread pool. A multiple of 64 (no two
+ * tasks share a mask word) and of CALC_BATCH_FENV_BLOCK.
+ */
+#define CALC_BATCH_PARALLEL_BLOCK 16384
+
+/** Smallest batch that is split across the thread pool */
+#define CALC_BATCH_PARALLEL_MIN (4 * CALC_BATCH_PARALLEL_BLOCK)
+
+// ==========================================
+// MARK: - Batch Types
+// ==========================================
+
+/** Failure counts of one batch call */
+typedef struct {
+    size_t failed;                      ///< Total number of failing elements
+    size_t counts[CALC_RESULT_COUNT];   ///< Failures per calc_result_t code
+    size_t flushed;                     ///< Underflows flushed to zero in CALC_DENORMAL_MODE_FLUSH (not failures)
+} calc_batch_summary_t;
+
+/**
+ * 64-bit divisor prepared for repeated modulus. Division by |d| becomes a
+ * multiply by a precomputed reciprocal and a shift (Granlund-Montgomery,
+ * as in libdivide); powers of two become a mask.
+ */
+typedef struct {
+    uint64_t divisor;           ///< |d|
+    uint64_t magic;             ///< Reciprocal multiplier, 0 for powers of two
+    uint8_t shift;              ///< Shift applied after the multiply
+    bool add;                   ///< The reciprocal needs 65 bits: use the add-and-halve fixup
+} calc_divisor_i64_t;
+
+/**
+ * Floating-point divisor prepared for repeated division. Validation happens
+ * once; kernels with FMA then divide by multiplying with the reciprocal and
+ * correcting the quotient by its exact residual, which yields the correctly
+ * rounded a / d (Markstein). The correction is only exact while the
+ * residual cannot underflow, so dividends with |a| outside
+ * [dividend_min, dividend_max] take a true division instead.
+ */
+typedef struct {
+    double divisor;             ///< d
+    double reciprocal;          ///< 1 / d rounded to nearest
+    double dividend_min;        ///< Smallest |a| for the reciprocal path
+    double dividend_max;        ///< Largest |a| for the reciprocal path (0 disables it)
+} calc_divisor_f64_t;
+
+/**
+ * Per-element error channel of one batch call. Either output array may be
+ * NULL; the summary is always filled in.
+ */
+typedef struct {
+    uint8_t *codes;                 ///< One calc_result_t code per element, or NULL
+    uint64_t *mask;                 ///< Bit (i % 64) of word (i / 64) set if element i failed, or NULL
+    calc_batch_summary_t summary;   ///< Failure counts, reset by every call
+} calc_batch_errors_t;
+
+/**
+ * Body of a parallel batch: handles elements [begin, end) and records each
+ * failure at its absolute index without resetting the channel.
+ * @return Error code of the range's first failing element, or CALC_SUCCESS
+ */
+typedef calc_result_t (*calc_batch_range_fn_t)(void *context, size_t begin, size_t end,
+                                               calc_batch_errors_t *errors);
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Perform addition over arrays
+ * @details Computes out[i] = a[i] + b[i] for every element.
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array (may alias a or b)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre a, b and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] + b[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_add_batch(const double *a, const double *b, double *out,
+                                            size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Perform subtraction over arrays
+ * @details Computes out[i] = a[i] - b[i] for every element.
+ * @param a Minuend array
+ * @param b Subtrahend array
+ * @param out Result array (may alias a or b)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre a, b and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] - b[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_subtract_batch(const double *a, const double *b, double *out,
+                                                 size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Perform multiplication over arrays
+ * @details Computes out[i] = a[i] * b[i] for every element.
+ * @param a First factor array
+ * @param b Second factor array
+ * @param out Result array (may alias a or b)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre a, b and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] * b[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_multiply_batch(const double *a, const double *b, double *out,
+                                                 size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Perform division over arrays
+ * @details Computes out[i] = a[i] / b[i] for every element.
+ * @param a Dividend array
+ * @param b Divisor array
+ * @param out Result array (may alias a or b)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre a, b and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] / b[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_divide_batch(const double *a, const double *b, double *out,
+                                               size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Perform scaled addition over arrays
+ * @details Computes out[i] = alpha * x[i] + y[i] for every element with one
+ *          rounding (BLAS axpy). Every element reports what
+ *          calculator_fma(alpha, x[i], y[i]) would.
+ * @param alpha Scale factor applied to x
+ * @param x Scaled operand array
+ * @param y Addend array
+ * @param out Result array (may alias x or y)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre x, y and out must not be NULL when n is non-zero
+ * @post out[i] contains alpha * x[i] + y[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_axpy(double alpha, const double *x, const double *y, double *out,
+                                       size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Perform modulus over arrays
+ * @details Computes out[i] = a[i] % b[i] for every element.
+ * @param a Dividend array
+ * @param b Divisor array
+ * @param out Result array
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre a, b and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] % b[i] wherever element i did not fail
+ */
+CALC_API calc_result_t calculator_modulus_batch(const int *a, const int *b, double *out,
+                                                size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Prepare a divisor for repeated division
+ * @details Applies calculator_divide()'s divisor checks once and computes
+ *          the reciprocal and the dividend range it is exact for.
+ * @param divisor Prepared divisor to fill in
+ * @param d Divisor value
+ * @return CALC_SUCCESS on success, CALC_ERROR_INVALID_INPUT if d is not
+ *         finite or divisor is NULL, CALC_ERROR_DIVISION_BY_ZERO if
+ *         |d| < CALC_PRECISION_EPSILON
+ */
+CALC_API calc_result_t calculator_divisor_f64_init(calc_divisor_f64_t *divisor, double d);
+
+/**
+ * @brief Divide by a prepared divisor
+ * @details Same result and status as calculator_divide(a, d, result),
+ *          without re-validating d.
+ * @param a Dividend
+ * @param divisor Divisor prepared by calculator_divisor_f64_init()
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, otherwise the code calculator_divide()
+ *         returns for a / d
+ */
+CALC_API calc_result_t calculator_divide_prepared(double a, const calc_divisor_f64_t *divisor, double *result);
+
+/**
+ * @brief Perform division by one prepared divisor over an array
+ * @details Computes out[i] = a[i] / d, bit for bit equal to
+ *          calculator_divide_batch() with every b[i] == d. On FMA-capable
+ *          levels the quotient comes from the reciprocal plus one FMA
+ *          correction instead of a hardware division.
+ * @param a Dividend array
+ * @param divisor Divisor prepared by calculator_divisor_f64_init()
+ * @param out Result array (may alias a)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ */
+CALC_API calc_result_t calculator_divide_prepared_batch(const double *a, const calc_divisor_f64_t *divisor,
+                                                        double *out, size_t n, calc_batch_errors_t *errors);
+
+/**
+ * @brief Prepare a divisor for calculator_modulus_i64_batch()
+ * @details Computes the reciprocal once, so it can be reused across any
+ *          number of batches.
+ * @param divisor Prepared divisor to fill in
+ * @param d Divisor value
+ * @return CALC_SUCCESS on success, CALC_ERROR_DIVISION_BY_ZERO if d is 0,
+ *         CALC_ERROR_INVALID_INPUT if divisor is NULL
+ */
+CALC_API calc_result_t calculator_divisor_i64_init(calc_divisor_i64_t *divisor, int64_t d);
+
+/**
+ * @brief Perform 64-bit modulus over an array with one divisor
+ * @details Computes out[i] = a[i] % d with the same results as
+ *          calculator_modulus_i64(), using one multiply-high per element
+ *          instead of a hardware division. No element can fail once the
+ *          divisor is prepared, so there is no error channel.
+ * @param a Dividend array
+ * @param divisor Divisor prepared by calculator_divisor_i64_init()
+ * @param out Result array (may alias a)
+ * @param n Number of elements
+ * @return CALC_SUCCESS on success, CALC_ERROR_INVALID_INPUT if a pointer is NULL
+ * @pre a and out must not be NULL when n is non-zero
+ * @post out[i] contains a[i] % d
+ */
+CALC_API calc_result_t calculator_modulus_i64_batch(const int64_t *a, const calc_divisor_i64_t *divisor,
+                                                    int64_t *out, size_t n);
+
+/**
+ * @brief Perform power over arrays
+ * @details Computes out[i] = base[i] ^ exponent[i] for every element. In
+ *          CALC_ERROR_MODE_FENV the exception flags are checked once per
+ *          CALC_BATCH_FENV_BLOCK elements, and pow() results are only
+ *          classified in blocks that raised an error flag.
+ * @param base Base array
+ * @param exponent Exponent array
+ * @param out Result array (may alias base or exponent)
+ * @param n Number of elements
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every element succeeded, otherwise the error code
+ *         of the first failing element
+ * @pre base, exponent and out must not be NULL when n is non-zero
+ * @post out[i] contains base[i] ^ exponent[i] wherever element i did not
+ *       fail, and what calculator_power() leaves in its result where it did
+ */
+CALC_API calc_result_t calculator_power_batch(const double *base, const double *exponent, double *out,
+                                              size_t n, calc_batch_errors_t *errors);
+
+// ==========================================
+// MARK: - Engine Internals
+// ==========================================
+
+/*
+ * Shared by the batch bodies of the engine itself (the operations above,
+ * the reductions, the expression VM and the columnar and CSV drivers).
+ * None of them is exported by libcalc.so.
+ */
+
+/**
+ * @brief Run a batch body over n elements on the thread pool
+ * @details Resets the error channel, then runs fn over
+ *          CALC_BATCH_PARALLEL_BLOCK-element ranges on the pool, or over the
+ *          whole batch on the calling thread when it is smaller than
+ *          CALC_BATCH_PARALLEL_MIN. Summaries are merged, so the channel
+ *          ends up as a single call over [0, n) would have left it. In
+ *          CALC_DENORMAL_MODE_FLUSH each thread runs fn with DAZ and FTZ
+ *          set and restores its own MXCSR controls afterwards.
+ * @param n Number of elements
+ * @param fn Batch body
+ * @param context Passed to fn unchanged
+ * @param errors Per-element error channel, or NULL if not needed
+ * @return Error code of the first failing element, or CALC_SUCCESS
+ */
+calc_result_t calculator_batch_parallel(size_t n, calc_batch_range_fn_t fn, void *context,
+                                        calc_batch_errors_t *errors);
+
+/**
+ * @brief Clear an error channel before a batch runs
+ * @details Every element starts out as CALC_SUCCESS, so batch code only has
+ *          to touch the channel for the elements that fail.
+ * @param errors Error channel, or NULL
+ * @param n Number of elements in the batch
+ */
+void calculator_batch_errors_reset(calc_batch_errors_t *errors, size_t n);
+
+/**
+ * @brief Record one failing element in an error channel
+ * @details While the calling thread flushes denormals, an underflow is the
+ *          zero the caller asked for: it is counted in summary.flushed and
+ *          the element succeeds.
+ * @param errors Error channel, or NULL
+ * @param index Index of the failing element
+ * @param code Its error code
+ * @return code, or CALC_SUCCESS if the element was counted as flushed
+ */
+calc_result_t calculator_batch_errors_record(calc_batch_errors_t *errors, size_t index,
+                                             calc_result_t code);
+
+/**
+ * @brief Check whether the calling thread flushes denormals
+ * @details True while a batch body runs in CALC_DENORMAL_MODE_FLUSH, when
+ *          MXCSR has FTZ set. A body passed to calculator_batch_parallel()
+ *          that checks intermediate steps itself (as the expression VM
+ *          does) uses it to tell a flush from a failure.
+ * @return true if results too small for a normal double become zero
+ */
+bool calculator_batch_flushing(void);
+
+#endif /* CALCULATOR_BATCH_H */
@@ -0,0 +1,95 @@
+// ==========================================
+// FILE: calculator_dispatch.h
+// ==========================================
+/**
+ * @file calculator_dispatch.h
+ * @brief Calculator dispatch header - Runtime CPU feature selection
+ * @details Defines the dispatch layer that chooses which kernel table the
+ *          batch engine runs. The level is detected once through cpuid and
+ *          can be forced through the CALC_CPU_LEVEL environment variable
+ *          (scalar, sse2, avx2, avx512) for benchmarking and bug reproduction.
+ *          libcalc.so exports only calculator_dispatch_level() and
+ *          calculator_dispatch_level_name(); the rest serves the engine.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_DISPATCH_H
+#define CALCULATOR_DISPATCH_H
+
+#include "calculator.h"
+#include "calculator_kernels.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - Dispatch Constants
+// ==========================================
+
+/** Environment variable that forces a kernel level */
+#define CALC_CPU_LEVEL_ENV "CALC_CPU_LEVEL"
+
+// ==========================================
+// MARK: - Dispatch Types
+// ==========================================
+
+/** Kernel levels, ordered from least to most capable */
+typedef enum {
+    CALC_CPU_LEVEL_SCALAR = 0,  ///< Portable C, one element at a time
+    CALC_CPU_LEVEL_SSE2,        ///< SSE2, 2 lanes
+    CALC_CPU_LEVEL_AVX2,        ///< AVX2 + FMA, 4 lanes
+    CALC_CPU_LEVEL_AVX512       ///< AVX-512F + DQ on top of AVX2 + FMA, 8 lanes
+} calc_cpu_level_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Initialize the dispatch layer
+ * @details Detects the CPU level and applies CALC_CPU_LEVEL if it is set.
+ *          Called by calculator_initialize(); batch calls made without it
+ *          fall back to the detected level.
+ * @return CALC_SUCCESS on success, CALC_ERROR_INIT if CALC_CPU_LEVEL names an
+ *         unknown level or one the CPU does not support
+ */
+calc_result_t calculator_dispatch_initialize(void);
+
+/**
+ * @brief Detect the highest level the running CPU supports
+ * @return Highest supported kernel level
+ */
+calc_cpu_level_t calculator_dispatch_detect(void);
+
+/**
+ * @brief Get the active kernel level
+ * @return Level whose kernels the batch engine currently runs
+ */
+CALC_API calc_cpu_level_t calculator_dispatch_level(void);
+
+/**
+ * @brief Force a kernel level
+ * @details Safe to call while batches run on other threads, which keep
+ *          running on the table they already loaded.
+ * @param level Level to activate
+ * @return CALC_SUCCESS on success, CALC_ERROR_INVALID_INPUT if the level is
+ *         unknown or not supported by the CPU
+ */
+calc_result_t calculator_dispatch_set_level(calc_cpu_level_t level);
+
+/**
+ * @brief Convert a kernel level to its CALC_CPU_LEVEL spelling
+ * @param level The level to convert
+ * @return Level name, or "unknown" if invalid
+ */
+CALC_API const char *calculator_dispatch_level_name(calc_cpu_level_t level);
+
+/**
+ * @brief Get the active kernel table
+ * @details Thread-safe; the first call from any thread selects the level
+ *          once if calculator_dispatch_initialize() has not run.
+ * @return Kernel table for the active level, never NULL
+ */
+const calc_kernel_table_t *calculator_dispatch_kernels(void);
+
+#endif /* CALCULATOR_DISPATCH_H */
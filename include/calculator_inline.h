@@ -0,0 +1,422 @@
+// ==========================================
+// FILE: calculator_inline.h
+// ==========================================
+/**
+ * @file calculator_inline.h
+ * @brief Inline calculator operations - Header-only ops for hot loops
+ * @details Defines static inline versions of every calculator operation
+ *          and validator. calculator.c implements the calculator_* API as
+ *          thin wrappers around them, so both give bit-identical results
+ *          and error codes. Including this header lets a loop that calls
+ *          an operation per element inline it, keep the operands in
+ *          registers and drop the checks it does not need, which a call
+ *          into another translation unit rules out. Only the pow() path of
+ *          the power operations stays out of line, because it depends on
+ *          the error mode and errno.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_INLINE_H
+#define CALCULATOR_INLINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "calculator.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - IEEE 754 Bit Patterns
+// ==========================================
+
+/** Sign bit of a double */
+#define CALC_F64_SIGN_MASK UINT64_C(0x8000000000000000)
+
+/** Exponent field of a double; all ones for infinities and NaNs only */
+#define CALC_F64_EXPONENT_MASK UINT64_C(0x7FF0000000000000)
+
+/** Smallest positive normal double; smaller nonzero magnitudes are subnormal */
+#define CALC_F64_MIN_NORMAL UINT64_C(0x0010000000000000)
+
+/** +inf and -inf */
+#define CALC_F64_POSITIVE_INFINITY UINT64_C(0x7FF0000000000000)
+#define CALC_F64_NEGATIVE_INFINITY UINT64_C(0xFFF0000000000000)
+
+// ==========================================
+// MARK: - Out-of-line Helpers
+// ==========================================
+
+/**
+ * @brief Evaluate pow() with the active error mode's error detection
+ * @details The shared fallback of calculator_inline_power() and
+ *          calculator_inline_power_int() for finite operands that passed
+ *          their domain checks.
+ * @param base Base number
+ * @param exponent Exponent value
+ * @param result Pointer to store the result
+ * @return CALC_SUCCESS on success, error code on failure
+ */
+CALC_API calc_result_t calculator_power_general(double base, double exponent, double *result);
+
+// ==========================================
+// MARK: - Validation Functions
+// ==========================================
+
+/*
+ * The validators classify the bit pattern with integer tests, which never
+ * raise FP exceptions, need no compare against DBL_MAX or INFINITY and are
+ * not fooled by DAZ, under which a subnormal compares equal to zero: a
+ * double is finite exactly when its exponent field is not all ones, and
+ * subnormal when the field is zero and the rest of the magnitude is not.
+ */
+
+/** Bit pattern of a double */
+static inline uint64_t calculator_inline_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/** Inline calculator_is_valid_number(): finite, one exponent mask test */
+static inline bool calculator_inline_is_valid_number(double value) {
+    return (calculator_inline_bits(value) & CALC_F64_EXPONENT_MASK) != CALC_F64_EXPONENT_MASK;
+}
+
+/** +0 or -0 (the sign bit shifted out) */
+static inline bool calculator_inline_is_zero(double value) {
+    return (calculator_inline_bits(value) << 1) == 0;
+}
+
+/** Inline calculator_is_overflow(): +inf or -inf */
+static inline bool calculator_inline_is_overflow(double value) {
+    return (calculator_inline_bits(value) << 1) == (CALC_F64_POSITIVE_INFINITY << 1);
+}
+
+/** Inline calculator_is_underflow(): subnormal */
+static inline bool calculator_inline_is_underflow(double value) {
+    return (calculator_inline_bits(value) & CALC_F64_EXPONENT_MASK) == 0 &&
+           !calculator_inline_is_zero(value);
+}
+
+/**
+ * The value as DAZ reads it: under DAZ a subnormal compares equal to zero
+ * and becomes that zero; without DAZ every value comes back unchanged.
+ * libm takes subnormals apart with integer code (glibc rescales them by
+ * 2^52, which DAZ zeroes as well) and builds exact subnormal results past
+ * FTZ, so pow() operands and results pass through this.
+ */
+static inline double calculator_inline_as_daz(double value) {
+    return (value == 0.0) ? copysign(0.0, value) : value;
+}
+
+/** a + b is exactly zero: b is -a bit for bit, or both are zeros */
+static inline bool calculator_inline_cancels(double a, double b) {
+    uint64_t x = calculator_inline_bits(a);
+    uint64_t y = calculator_inline_bits(b);
+    return (x ^ y) == CALC_F64_SIGN_MASK || ((x | y) << 1) == 0;
+}
+
+/**
+ * a * b + c is exactly zero. Only consulted for zero results, so it may
+ * take the significands apart: a nonzero product cancels c only if it is
+ * exact in 53 bits, which holds when the product of the frexp()
+ * significands (both in [0.5, 1), so neither product nor residual can
+ * underflow) has a zero FMA residual.
+ */
+static inline bool calculator_inline_fma_cancels(double a, double b, double c) {
+    if (calculator_inline_is_zero(a) | calculator_inline_is_zero(b)) {
+        return calculator_inline_is_zero(c);
+    }
+    if (calculator_inline_is_zero(c)) {
+        return false;
+    }
+
+    int ea, eb, ec;
+    double ma = frexp(a, &ea);
+    double mb = frexp(b, &eb);
+    double mc = frexp(c, &ec);
+    double m = ma * mb;
+    if (fma(ma, mb, -m) != 0.0) {
+        return false;
+    }
+    if (fabs(m) < 0.5) {
+        m *= 2.0;
+        ea--;
+    }
+    return m == -mc && ea + eb == ec;
+}
+
+/**
+ * Range classification shared by the operations. Normal results pass with
+ * one test, since only a zero or all-ones exponent field wraps around the
+ * subtraction. Infinities overflow and subnormals underflow; a zero
+ * underflows unless zero_is_exact says the exact result was zero as well.
+ * NaN passes.
+ */
+static inline calc_result_t calculator_inline_range(double value, bool zero_is_exact) {
+    uint64_t exponent = calculator_inline_bits(value) & CALC_F64_EXPONENT_MASK;
+    if (exponent - CALC_F64_MIN_NORMAL < CALC_F64_EXPONENT_MASK - CALC_F64_MIN_NORMAL) {
+        return CALC_SUCCESS;
+    }
+    if (exponent == CALC_F64_EXPONENT_MASK) {
+        return calculator_inline_is_overflow(value) ? CALC_ERROR_OVERFLOW : CALC_SUCCESS;
+    }
+    return (calculator_inline_is_zero(value) && zero_is_exact) ? CALC_SUCCESS : CALC_ERROR_UNDERFLOW;
+}
+
+/** Both operands valid, tested without a branch between them */
+static inline bool calculator_inline_are_valid(double a, double b) {
+    return calculator_inline_is_valid_number(a) & calculator_inline_is_valid_number(b);
+}
+
+// ==========================================
+// MARK: - Arithmetic Operations
+// ==========================================
+
+/** Inline calculator_add() */
+static inline calc_result_t calculator_inline_add(double a, double b, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_are_valid(a, b)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    *result = a + b;
+    return calculator_inline_range(*result, calculator_inline_cancels(a, b));
+}
+
+/** Inline calculator_subtract() */
+static inline calc_result_t calculator_inline_subtract(double a, double b, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_are_valid(a, b)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    *result = a - b;
+    return calculator_inline_range(*result, calculator_inline_cancels(a, -b));
+}
+
+/** Inline calculator_multiply() */
+static inline calc_result_t calculator_inline_multiply(double a, double b, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_are_valid(a, b)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    *result = a * b;
+    return calculator_inline_range(*result, calculator_inline_is_zero(a) | calculator_inline_is_zero(b));
+}
+
+/** Inline calculator_divide() */
+static inline calc_result_t calculator_inline_divide(double a, double b, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_are_valid(a, b)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (fabs(b) < CALC_PRECISION_EPSILON) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    *result = a / b;
+    return calculator_inline_range(*result, calculator_inline_is_zero(a));
+}
+
+/*
+ * fma() is the FMA instruction where the compiler targets it and glibc's
+ * hardware variant otherwise. A non-finite operand always yields a
+ * non-finite result, and the range check sees the single rounding.
+ */
+
+/** Inline calculator_fma() */
+static inline calc_result_t calculator_inline_fma(double a, double b, double c, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!(calculator_inline_are_valid(a, b) & calculator_inline_is_valid_number(c))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    *result = fma(a, b, c);
+    return calculator_inline_range(*result, calculator_inline_is_zero(*result) &&
+                                            calculator_inline_fma_cancels(a, b, c));
+}
+
+/** Inline calculator_lerp() */
+static inline calc_result_t calculator_inline_lerp(double a, double b, double t, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!(calculator_inline_are_valid(a, b) & calculator_inline_is_valid_number(t))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    // a - t * a is exact at t == 0 and t == 1, so both ends come back bit for bit
+    double rest = fma(-t, a, a);
+    *result = fma(t, b, rest);
+    return calculator_inline_range(*result, calculator_inline_is_zero(*result) &&
+                                            calculator_inline_fma_cancels(t, b, rest));
+}
+
+/** Inline calculator_modulus() */
+static inline calc_result_t calculator_inline_modulus(int a, int b, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (a > CALC_MAX_SAFE_INTEGER || a < CALC_MIN_SAFE_INTEGER ||
+        b > CALC_MAX_SAFE_INTEGER || b < CALC_MIN_SAFE_INTEGER) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (b == 0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    // INT_MIN % -1 traps on x86; x % -1 is 0
+    *result = (b == -1) ? 0.0 : (double)(a % b);
+    return CALC_SUCCESS;
+}
+
+/** Inline calculator_modulus_i64() */
+static inline calc_result_t calculator_inline_modulus_i64(int64_t a, int64_t b, int64_t *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (b == 0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    // INT64_MIN % -1 traps on x86; x % -1 is 0
+    *result = (b == -1) ? 0 : a % b;
+    return CALC_SUCCESS;
+}
+
+/**
+ * calculator_modulus_i64() of two doubles truncated toward zero. Converting
+ * a double outside [-2^63, 2^63) to int64_t is undefined, so such operands
+ * (NaN and infinities included) are invalid input.
+ */
+static inline calc_result_t calculator_inline_modulus_truncated_i64(double a, double b, int64_t *result) {
+    if (!(a >= -CALC_I64_DOUBLE_LIMIT && a < CALC_I64_DOUBLE_LIMIT &&
+          b >= -CALC_I64_DOUBLE_LIMIT && b < CALC_I64_DOUBLE_LIMIT)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    return calculator_inline_modulus_i64((int64_t)a, (int64_t)b, result);
+}
+
+/** calculator_inline_modulus_truncated_i64() with the remainder as a double */
+static inline calc_result_t calculator_inline_modulus_truncated(double a, double b, double *result) {
+    int64_t remainder;
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    calc_result_t status = calculator_inline_modulus_truncated_i64(a, b, &remainder);
+    if (status == CALC_SUCCESS) {
+        *result = (double)remainder;
+    }
+    return status;
+}
+
+/**
+ * Inline calculator_power_int(). base is m * 2^k with m odd and L bits
+ * long, so |base|^n = m^n * 2^(k * n) where m^n has at most L * n bits:
+ * when that is at most DBL_MANT_DIG, every partial product of the
+ * squaring is a double and no step rounds. Powers of two (m == 1) are
+ * exact for any n, including negative ones. Everything else goes to
+ * pow(), so results match calculator_power() bit for bit.
+ */
+static inline calc_result_t calculator_inline_power_int(double base, int exponent, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_is_valid_number(base)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (base == 0.0 && exponent < 0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    if (exponent == 0) {
+        *result = 1.0;
+        return CALC_SUCCESS;
+    }
+
+    // Zero and subnormal bases have no usable binary exponent
+    uint64_t bits = calculator_inline_bits(base);
+    int biased = (int)((bits >> 52) & 0x7FF);
+    if (exponent < -CALC_POWER_INTEGER_MAX || exponent > CALC_POWER_INTEGER_MAX ||
+        base == 0.0 || biased <= 0) {
+        return calculator_power_general(base, (double)exponent, result);
+    }
+
+    // |base| lies in [2^e, 2^(e + 1)), so |result| lies between 2^(e * n)
+    // and 2^((e + 1) * n)
+    int e = biased - (DBL_MAX_EXP - 1);
+    int low = e * exponent;
+    int high = (e + 1) * exponent;
+    if (low > high) {
+        int swap = low;
+        low = high;
+        high = swap;
+    }
+
+    if (low >= DBL_MAX_EXP) {
+        // Certain overflow: report it like pow() would
+        bool negative = base < 0.0 && exponent % 2 != 0;
+        *result = negative ? -HUGE_VAL : HUGE_VAL;
+        return CALC_ERROR_OVERFLOW;
+    }
+
+    // Significand bits of m: the trailing zeros of the 53-bit significand drop out
+    uint64_t significand = (bits & ((UINT64_C(1) << 52) - 1)) | (UINT64_C(1) << 52);
+    int length = DBL_MANT_DIG - __builtin_ctzll(significand);
+    unsigned int n = (exponent < 0) ? (unsigned int)-exponent : (unsigned int)exponent;
+    bool exact = (length == 1) || (exponent > 0 && (unsigned int)length * n <= DBL_MANT_DIG);
+    if (!exact || high > DBL_MAX_EXP - 2 || low < DBL_MIN_EXP) {
+        // A rounded chain, or close to the range limits or into the
+        // subnormals
+        return calculator_power_general(base, (double)exponent, result);
+    }
+
+    // Every partial product is exact and lies between 1 and
+    // |base|^|exponent|, so none of them can overflow or underflow
+    double value = 1.0;
+    double square = base;
+    while (true) {
+        if (n & 1u) {
+            value *= square;
+        }
+        n >>= 1;
+        if (n == 0) {
+            break;
+        }
+        square *= square;
+    }
+
+    *result = (exponent < 0) ? 1.0 / value : value;
+    return CALC_SUCCESS;
+}
+
+/** Inline calculator_power() */
+static inline calc_result_t calculator_inline_power(double base, double exponent, double *result) {
+    if (result == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_inline_are_valid(base, exponent)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    // Small integral exponents skip pow() (the range check keeps the cast defined)
+    if (fabs(exponent) <= CALC_POWER_INTEGER_MAX && exponent == (double)(int)exponent) {
+        return calculator_inline_power_int(base, (int)exponent, result);
+    }
+    if (base == 0.0 && exponent < 0.0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    if (base < 0.0 && floor(exponent) != exponent) {
+        return CALC_ERROR_DOMAIN; // Negative base with non-integer exponent
+    }
+    return calculator_power_general(base, exponent, result);
+}
+
+#endif /* CALCULATOR_INLINE_H */
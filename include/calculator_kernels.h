@@ -0,0 +1,97 @@
+// ==========================================
+// FILE: calculator_kernels.h
+// ==========================================
+/**
+ * @file calculator_kernels.h
+ * @brief Calculator kernel header - Per-instruction-set kernel tables
+ * @details Declares the kernel tables built for each instruction set level.
+ *          Every level lives in its own translation unit so the Makefile can
+ *          compile it with matching -m flags; the dispatch layer picks one
+ *          table at startup. Internal to the engine: callers use the batch API.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_KERNELS_H
+#define CALCULATOR_KERNELS_H
+
+#include <stddef.h>
+#include "calculator.h"
+#include "calculator_batch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CALC_KERNELS_X86 1
+#endif
+
+/** Accumulator lanes of a reduction kernel, the same at every level */
+#define CALC_REDUCE_LANES 8
+
+// ==========================================
+// MARK: - Kernel Types
+// ==========================================
+
+/**
+ * Vector kernel: computes whole vectors and stops in front of the first one
+ * containing a failure. Returns the number of elements completed.
+ */
+typedef size_t (*calc_kernel_fn_t)(const double *a, const double *b, double *out, size_t n);
+
+/** Division kernel with one prepared divisor; same contract as calc_kernel_fn_t */
+typedef size_t (*calc_divide_prepared_fn_t)(const double *a, const calc_divisor_f64_t *divisor,
+                                            double *out, size_t n);
+
+/** Scaled addition kernel, out = fma(alpha, x, y); same contract as calc_kernel_fn_t */
+typedef size_t (*calc_axpy_fn_t)(double alpha, const double *x, const double *y, double *out, size_t n);
+
+/**
+ * Compensated accumulators of a reduction. Element i goes to lane
+ * i % CALC_REDUCE_LANES and a partial last block is padded with the
+ * identity, so every level performs the same operations in the same order
+ * and produces bit-identical lanes.
+ */
+typedef struct {
+    double value[CALC_REDUCE_LANES];        ///< Running sum or product
+    double compensation[CALC_REDUCE_LANES]; ///< Accumulated rounding error of value
+} calc_reduce_lanes_t;
+
+/**
+ * Reduction kernel: folds a[0..n) (and b[0..n) for dot) into the lanes.
+ * Sum and dot add each error-free transformation's error term to the
+ * compensation; product scales the compensation and adds the error term.
+ */
+typedef void (*calc_reduce_fn_t)(const double *a, const double *b, size_t n,
+                                 calc_reduce_lanes_t *lanes);
+
+/** Kernel set for one instruction set level */
+typedef struct {
+    calc_kernel_fn_t add;       ///< out = a + b
+    calc_kernel_fn_t subtract;  ///< out = a - b
+    calc_kernel_fn_t multiply;  ///< out = a * b
+    calc_kernel_fn_t divide;    ///< out = a / b
+    calc_divide_prepared_fn_t divide_prepared;  ///< out = a / d
+    calc_axpy_fn_t axpy;        ///< out = alpha * x + y, one rounding
+    calc_reduce_fn_t sum;       ///< lanes += a
+    calc_reduce_fn_t product;   ///< lanes *= a
+    calc_reduce_fn_t dot;       ///< lanes += a * b
+} calc_kernel_table_t;
+
+// ==========================================
+// MARK: - Kernel Tables
+// ==========================================
+
+/** Portable C kernels, one element at a time */
+extern const calc_kernel_table_t calc_kernels_scalar;
+
+#ifdef CALC_KERNELS_X86
+/** SSE2 kernels, 2 lanes (calculator_kernels.c) */
+extern const calc_kernel_table_t calc_kernels_sse2;
+
+/** AVX2 + FMA kernels, 4 lanes (calculator_kernels_avx2.c) */
+extern const calc_kernel_table_t calc_kernels_avx2;
+
+/** AVX-512 kernels, 8 lanes (calculator_kernels_avx512.c) */
+extern const calc_kernel_table_t calc_kernels_avx512;
+#endif
+
+#endif /* CALCULATOR_KERNELS_H */
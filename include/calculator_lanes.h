@@ -0,0 +1,372 @@
+// ==========================================
+// FILE: calculator_lanes.h
+// ==========================================
+/**
+ * @file calculator_lanes.h
+ * @brief Lane classifier header - SIMD versions of the validators
+ * @details Defines the calculator_inline.h validators for whole vectors:
+ *          each classifier takes 2 (SSE2), 4 (AVX2) or 8 (AVX-512) doubles
+ *          and returns a lane mask with bit i set when lane i passes, so a
+ *          kernel can accept a vector with one comparison against the full
+ *          mask. Every classifier uses the same bit tests as its scalar
+ *          counterpart, so DAZ never makes a subnormal look like zero. The
+ *          sum, difference, product and quotient classifiers apply
+ *          calculator_inline_range() to the result of one operation: zero
+ *          or normal lanes pass, except zeros whose exact result was not
+ *          zero. Each level is only defined in translation units compiled
+ *          for it. Internal to the engine.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_LANES_H
+#define CALCULATOR_LANES_H
+
+#include "calculator_inline.h"
+#include "calculator_kernels.h"
+
+#ifdef CALC_KERNELS_X86
+#include <immintrin.h>
+
+// ==========================================
+// MARK: - Lane Masks
+// ==========================================
+
+/** Every lane set */
+#define CALC_LANES_ALL_SSE2 0x3
+#define CALC_LANES_ALL_AVX2 0xF
+#define CALC_LANES_ALL_AVX512 0xFF
+
+// ==========================================
+// MARK: - SSE2 Classifiers (2 lanes)
+// ==========================================
+
+/*
+ * SSE2 has no 64-bit compare. The exponent mask's low 32 bits are zero, so
+ * the compare of each lane's high half decides it, and its top bit is the
+ * one _mm_movemask_pd() collects; other patterns need both halves equal.
+ */
+
+/** Lanes whose 64 bits are all equal, as a vector mask */
+__attribute__((target("sse2")))
+static inline __m128i calculator_lanes_equal_sse2(__m128i x, __m128i y) {
+    __m128i halves = _mm_cmpeq_epi32(x, y);
+    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/** Lanes that are finite (calculator_is_valid_number()) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_valid_sse2(__m128d v) {
+    const __m128i exponent = _mm_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m128i special = _mm_cmpeq_epi32(_mm_and_si128(_mm_castpd_si128(v), exponent), exponent);
+    return ~_mm_movemask_pd(_mm_castsi128_pd(special)) & CALC_LANES_ALL_SSE2;
+}
+
+/** Lanes that are +0 or -0 (calculator_inline_is_zero()) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_zero_sse2(__m128d v) {
+    __m128i magnitude = _mm_slli_epi64(_mm_castpd_si128(v), 1);
+    return _mm_movemask_pd(_mm_castsi128_pd(calculator_lanes_equal_sse2(magnitude, _mm_setzero_si128())));
+}
+
+/** Lanes that are +inf or -inf (calculator_is_overflow()) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_overflow_sse2(__m128d v) {
+    const __m128i infinity = _mm_set1_epi64x((long long)(CALC_F64_POSITIVE_INFINITY << 1));
+    __m128i magnitude = _mm_slli_epi64(_mm_castpd_si128(v), 1);
+    return _mm_movemask_pd(_mm_castsi128_pd(calculator_lanes_equal_sse2(magnitude, infinity)));
+}
+
+/** Lanes that are subnormal (calculator_is_underflow()) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_underflow_sse2(__m128d v) {
+    const __m128i exponent = _mm_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m128i low = _mm_cmpeq_epi32(_mm_and_si128(_mm_castpd_si128(v), exponent), _mm_setzero_si128());
+    return _mm_movemask_pd(_mm_castsi128_pd(low)) & ~calculator_lanes_zero_sse2(v);
+}
+
+/** Lanes that are zero or normal: the results no operand can make fail */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_in_range_sse2(__m128d v) {
+    const __m128i exponent = _mm_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m128i field = _mm_and_si128(_mm_castpd_si128(v), exponent);
+    __m128i special = _mm_or_si128(_mm_cmpeq_epi32(field, exponent), _mm_cmpeq_epi32(field, _mm_setzero_si128()));
+    return (~_mm_movemask_pd(_mm_castsi128_pd(special)) & CALC_LANES_ALL_SSE2) | calculator_lanes_zero_sse2(v);
+}
+
+/** Lanes where a + b is exactly zero (calculator_inline_cancels()) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_cancel_sse2(__m128d a, __m128d b) {
+    const __m128i sign = _mm_set1_epi64x((long long)CALC_F64_SIGN_MASK);
+    __m128i x = _mm_castpd_si128(a);
+    __m128i y = _mm_castpd_si128(b);
+    __m128i opposite = calculator_lanes_equal_sse2(_mm_xor_si128(x, y), sign);
+    return _mm_movemask_pd(_mm_castsi128_pd(opposite)) | calculator_lanes_zero_sse2(_mm_or_pd(a, b));
+}
+
+/** Lanes where r = a + b passes calculator_add()'s range check */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_sum_sse2(__m128d a, __m128d b, __m128d r) {
+    int pass = calculator_lanes_in_range_sse2(r);
+    int zero = calculator_lanes_zero_sse2(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_cancel_sse2(a, b));
+}
+
+/** Lanes where r = a - b passes calculator_subtract()'s range check */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_difference_sse2(__m128d a, __m128d b, __m128d r) {
+    int pass = calculator_lanes_in_range_sse2(r);
+    int zero = calculator_lanes_zero_sse2(r);
+    if (zero == 0) {
+        return pass;
+    }
+    __m128d negated = _mm_xor_pd(b, _mm_set1_pd(-0.0));
+    return pass & (~zero | calculator_lanes_cancel_sse2(a, negated));
+}
+
+/** Lanes where r = a * b passes calculator_multiply()'s range check */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_product_sse2(__m128d a, __m128d b, __m128d r) {
+    int pass = calculator_lanes_in_range_sse2(r);
+    int zero = calculator_lanes_zero_sse2(r);
+    if (zero == 0) {
+        return pass;
+    }
+    return pass & (~zero | calculator_lanes_zero_sse2(a) | calculator_lanes_zero_sse2(b));
+}
+
+/** Lanes where r = a / b passes calculator_divide()'s range check (divisor aside) */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_quotient_sse2(__m128d a, __m128d r) {
+    int pass = calculator_lanes_in_range_sse2(r);
+    int zero = calculator_lanes_zero_sse2(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_zero_sse2(a));
+}
+
+/** Lanes that are usable divisors: finite and at least CALC_PRECISION_EPSILON in magnitude */
+__attribute__((target("sse2")))
+static inline int calculator_lanes_divisor_sse2(__m128d v) {
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m128d large = _mm_cmpge_pd(_mm_and_pd(v, abs_mask), _mm_set1_pd(CALC_PRECISION_EPSILON));
+    return calculator_lanes_valid_sse2(v) & _mm_movemask_pd(large);
+}
+
+// ==========================================
+// MARK: - AVX2 Classifiers (4 lanes)
+// ==========================================
+
+#ifdef __AVX2__
+
+/** Lanes that are finite (calculator_is_valid_number()) */
+static inline int calculator_lanes_valid_avx2(__m256d v) {
+    const __m256i exponent = _mm256_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m256i special = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_castpd_si256(v), exponent), exponent);
+    return ~_mm256_movemask_pd(_mm256_castsi256_pd(special)) & CALC_LANES_ALL_AVX2;
+}
+
+/** Lanes that are +0 or -0 (calculator_inline_is_zero()) */
+static inline int calculator_lanes_zero_avx2(__m256d v) {
+    __m256i magnitude = _mm256_slli_epi64(_mm256_castpd_si256(v), 1);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(magnitude, _mm256_setzero_si256())));
+}
+
+/** Lanes that are +inf or -inf (calculator_is_overflow()) */
+static inline int calculator_lanes_overflow_avx2(__m256d v) {
+    const __m256i infinity = _mm256_set1_epi64x((long long)(CALC_F64_POSITIVE_INFINITY << 1));
+    __m256i magnitude = _mm256_slli_epi64(_mm256_castpd_si256(v), 1);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(magnitude, infinity)));
+}
+
+/** Lanes that are subnormal (calculator_is_underflow()) */
+static inline int calculator_lanes_underflow_avx2(__m256d v) {
+    const __m256i exponent = _mm256_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m256i field = _mm256_and_si256(_mm256_castpd_si256(v), exponent);
+    __m256i low = _mm256_cmpeq_epi64(field, _mm256_setzero_si256());
+    return _mm256_movemask_pd(_mm256_castsi256_pd(low)) & ~calculator_lanes_zero_avx2(v);
+}
+
+/** Lanes that are zero or normal: the results no operand can make fail */
+static inline int calculator_lanes_in_range_avx2(__m256d v) {
+    const __m256i exponent = _mm256_set1_epi64x((long long)CALC_F64_EXPONENT_MASK);
+    __m256i field = _mm256_and_si256(_mm256_castpd_si256(v), exponent);
+    __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(field, exponent),
+                                      _mm256_cmpeq_epi64(field, _mm256_setzero_si256()));
+    return (~_mm256_movemask_pd(_mm256_castsi256_pd(special)) & CALC_LANES_ALL_AVX2) |
+           calculator_lanes_zero_avx2(v);
+}
+
+/** Lanes where a + b is exactly zero (calculator_inline_cancels()) */
+static inline int calculator_lanes_cancel_avx2(__m256d a, __m256d b) {
+    const __m256i sign = _mm256_set1_epi64x((long long)CALC_F64_SIGN_MASK);
+    __m256i opposite = _mm256_cmpeq_epi64(_mm256_castpd_si256(_mm256_xor_pd(a, b)), sign);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(opposite)) | calculator_lanes_zero_avx2(_mm256_or_pd(a, b));
+}
+
+/** Lanes where r = a + b passes calculator_add()'s range check */
+static inline int calculator_lanes_sum_avx2(__m256d a, __m256d b, __m256d r) {
+    int pass = calculator_lanes_in_range_avx2(r);
+    int zero = calculator_lanes_zero_avx2(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_cancel_avx2(a, b));
+}
+
+/** Lanes where r = a - b passes calculator_subtract()'s range check */
+static inline int calculator_lanes_difference_avx2(__m256d a, __m256d b, __m256d r) {
+    int pass = calculator_lanes_in_range_avx2(r);
+    int zero = calculator_lanes_zero_avx2(r);
+    if (zero == 0) {
+        return pass;
+    }
+    __m256d negated = _mm256_xor_pd(b, _mm256_set1_pd(-0.0));
+    return pass & (~zero | calculator_lanes_cancel_avx2(a, negated));
+}
+
+/** Lanes where r = a * b passes calculator_multiply()'s range check */
+static inline int calculator_lanes_product_avx2(__m256d a, __m256d b, __m256d r) {
+    int pass = calculator_lanes_in_range_avx2(r);
+    int zero = calculator_lanes_zero_avx2(r);
+    if (zero == 0) {
+        return pass;
+    }
+    return pass & (~zero | calculator_lanes_zero_avx2(a) | calculator_lanes_zero_avx2(b));
+}
+
+/**
+ * Lanes where r = fma(a, b, c) passes calculator_fma()'s range check. A
+ * zero only passes here when the product and c are zeros; a product that
+ * cancels c is left to calculator_fma().
+ */
+static inline int calculator_lanes_fused_avx2(__m256d a, __m256d b, __m256d c, __m256d r) {
+    int pass = calculator_lanes_in_range_avx2(r);
+    int zero = calculator_lanes_zero_avx2(r);
+    if (zero == 0) {
+        return pass;
+    }
+    int exact = (calculator_lanes_zero_avx2(a) | calculator_lanes_zero_avx2(b)) & calculator_lanes_zero_avx2(c);
+    return pass & (~zero | exact);
+}
+
+/** Lanes where r = a / b passes calculator_divide()'s range check (divisor aside) */
+static inline int calculator_lanes_quotient_avx2(__m256d a, __m256d r) {
+    int pass = calculator_lanes_in_range_avx2(r);
+    int zero = calculator_lanes_zero_avx2(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_zero_avx2(a));
+}
+
+/** Lanes that are usable divisors: finite and at least CALC_PRECISION_EPSILON in magnitude */
+static inline int calculator_lanes_divisor_avx2(__m256d v) {
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d large = _mm256_cmp_pd(_mm256_and_pd(v, abs_mask), _mm256_set1_pd(CALC_PRECISION_EPSILON),
+                                  _CMP_GE_OQ);
+    return calculator_lanes_valid_avx2(v) & _mm256_movemask_pd(large);
+}
+
+#endif /* __AVX2__ */
+
+// ==========================================
+// MARK: - AVX-512 Classifiers (8 lanes)
+// ==========================================
+
+#ifdef __AVX512F__
+
+/** Lanes that are finite (calculator_is_valid_number()) */
+static inline __mmask8 calculator_lanes_valid_avx512(__m512d v) {
+    const __m512i exponent = _mm512_set1_epi64((long long)CALC_F64_EXPONENT_MASK);
+    return _mm512_cmpneq_epi64_mask(_mm512_and_si512(_mm512_castpd_si512(v), exponent), exponent);
+}
+
+/** Lanes that are +0 or -0 (calculator_inline_is_zero()) */
+static inline __mmask8 calculator_lanes_zero_avx512(__m512d v) {
+    __m512i magnitude = _mm512_slli_epi64(_mm512_castpd_si512(v), 1);
+    return _mm512_cmpeq_epi64_mask(magnitude, _mm512_setzero_si512());
+}
+
+/** Lanes that are +inf or -inf (calculator_is_overflow()) */
+static inline __mmask8 calculator_lanes_overflow_avx512(__m512d v) {
+    const __m512i infinity = _mm512_set1_epi64((long long)(CALC_F64_POSITIVE_INFINITY << 1));
+    return _mm512_cmpeq_epi64_mask(_mm512_slli_epi64(_mm512_castpd_si512(v), 1), infinity);
+}
+
+/** Lanes that are subnormal (calculator_is_underflow()) */
+static inline __mmask8 calculator_lanes_underflow_avx512(__m512d v) {
+    const __m512i exponent = _mm512_set1_epi64((long long)CALC_F64_EXPONENT_MASK);
+    __m512i field = _mm512_and_si512(_mm512_castpd_si512(v), exponent);
+    return _mm512_cmpeq_epi64_mask(field, _mm512_setzero_si512()) & ~calculator_lanes_zero_avx512(v);
+}
+
+/** Lanes that are zero or normal: the results no operand can make fail */
+static inline __mmask8 calculator_lanes_in_range_avx512(__m512d v) {
+    const __m512i exponent = _mm512_set1_epi64((long long)CALC_F64_EXPONENT_MASK);
+    __m512i field = _mm512_and_si512(_mm512_castpd_si512(v), exponent);
+    return (_mm512_cmpneq_epi64_mask(field, exponent) & _mm512_cmpneq_epi64_mask(field, _mm512_setzero_si512())) |
+           calculator_lanes_zero_avx512(v);
+}
+
+/** Lanes where a + b is exactly zero (calculator_inline_cancels()) */
+static inline __mmask8 calculator_lanes_cancel_avx512(__m512d a, __m512d b) {
+    const __m512i sign = _mm512_set1_epi64((long long)CALC_F64_SIGN_MASK);
+    __m512i x = _mm512_castpd_si512(a);
+    __m512i y = _mm512_castpd_si512(b);
+    return _mm512_cmpeq_epi64_mask(_mm512_xor_si512(x, y), sign) |
+           _mm512_cmpeq_epi64_mask(_mm512_slli_epi64(_mm512_or_si512(x, y), 1), _mm512_setzero_si512());
+}
+
+/** Lanes where r = a + b passes calculator_add()'s range check */
+static inline __mmask8 calculator_lanes_sum_avx512(__m512d a, __m512d b, __m512d r) {
+    __mmask8 pass = calculator_lanes_in_range_avx512(r);
+    __mmask8 zero = calculator_lanes_zero_avx512(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_cancel_avx512(a, b));
+}
+
+/** Lanes where r = a - b passes calculator_subtract()'s range check */
+static inline __mmask8 calculator_lanes_difference_avx512(__m512d a, __m512d b, __m512d r) {
+    __mmask8 pass = calculator_lanes_in_range_avx512(r);
+    __mmask8 zero = calculator_lanes_zero_avx512(r);
+    if (zero == 0) {
+        return pass;
+    }
+    __m512d negated = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(b),
+                                                           _mm512_set1_epi64((long long)CALC_F64_SIGN_MASK)));
+    return pass & (~zero | calculator_lanes_cancel_avx512(a, negated));
+}
+
+/** Lanes where r = a * b passes calculator_multiply()'s range check */
+static inline __mmask8 calculator_lanes_product_avx512(__m512d a, __m512d b, __m512d r) {
+    __mmask8 pass = calculator_lanes_in_range_avx512(r);
+    __mmask8 zero = calculator_lanes_zero_avx512(r);
+    if (zero == 0) {
+        return pass;
+    }
+    return pass & (~zero | calculator_lanes_zero_avx512(a) | calculator_lanes_zero_avx512(b));
+}
+
+/** Lanes where r = fma(a, b, c) passes calculator_fma()'s range check, as calculator_lanes_fused_avx2() */
+static inline __mmask8 calculator_lanes_fused_avx512(__m512d a, __m512d b, __m512d c, __m512d r) {
+    __mmask8 pass = calculator_lanes_in_range_avx512(r);
+    __mmask8 zero = calculator_lanes_zero_avx512(r);
+    if (zero == 0) {
+        return pass;
+    }
+    __mmask8 exact = (calculator_lanes_zero_avx512(a) | calculator_lanes_zero_avx512(b)) &
+                     calculator_lanes_zero_avx512(c);
+    return pass & (~zero | exact);
+}
+
+/** Lanes where r = a / b passes calculator_divide()'s range check (divisor aside) */
+static inline __mmask8 calculator_lanes_quotient_avx512(__m512d a, __m512d r) {
+    __mmask8 pass = calculator_lanes_in_range_avx512(r);
+    __mmask8 zero = calculator_lanes_zero_avx512(r);
+    return (zero == 0) ? pass : pass & (~zero | calculator_lanes_zero_avx512(a));
+}
+
+/** Lanes that are usable divisors: finite and at least CALC_PRECISION_EPSILON in magnitude */
+static inline __mmask8 calculator_lanes_divisor_avx512(__m512d v) {
+    return _mm512_mask_cmp_pd_mask(calculator_lanes_valid_avx512(v), _mm512_abs_pd(v),
+                                   _mm512_set1_pd(CALC_PRECISION_EPSILON), _CMP_GE_OQ);
+}
+
+#endif /* __AVX512F__ */
+
+#endif /* CALC_KERNELS_X86 */
+
+#endif /* CALCULATOR_LANES_H */
@@ -0,0 +1,85 @@
+// ==========================================
+// FILE: calculator_reduce.h
+// ==========================================
+/**
+ * @file calculator_reduce.h
+ * @brief Calculator reduction header - Compensated sum, product and dot
+ * @details Defines reductions of whole arrays to one value. Each array is
+ *          cut into CALC_REDUCE_CHUNK-element chunks; a chunk is reduced
+ *          over CALC_REDUCE_LANES compensated SIMD lanes and the chunk
+ *          partials are then combined in chunk order. The thread pool only
+ *          decides which chunk is computed where, so a result is
+ *          bit-identical for every thread count. Sum and dot carry the
+ *          exact rounding error of every step (TwoSum / FMA TwoProduct),
+ *          which makes them as accurate as summing in twice the precision.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATOR_REDUCE_H
+#define CALCULATOR_REDUCE_H
+
+#include <stddef.h>
+#include "calculator.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - Reduction Constants
+// ==========================================
+
+/** Elements per chunk; the unit of work and of the combine order */
+#define CALC_REDUCE_CHUNK 8192
+
+/** Fewest chunks worth handing to the thread pool */
+#define CALC_REDUCE_PARALLEL_CHUNKS 8
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Sum an array with compensated summation
+ * @details Errors are reported as the scalar operations report them: a
+ *          non-finite element is invalid input and a sum that leaves the
+ *          double range, toward either infinity, is overflow. A sum that
+ *          ends up subnormal is underflow. The sum of an empty array is 0.
+ * @param a Array to sum
+ * @param n Number of elements
+ * @param result Pointer to store the sum
+ * @return CALC_SUCCESS on success, otherwise the error described above
+ * @pre a must not be NULL when n is non-zero; result must not be NULL
+ */
+CALC_API calc_result_t calculator_sum(const double *a, size_t n, double *result);
+
+/**
+ * @brief Multiply the elements of an array with compensated products
+ * @details Errors are reported as calculator_sum() reports them, and a
+ *          product that ends up subnormal, or zero without a zero factor,
+ *          is underflow. Lanes multiply disjoint subsets, so a lane may
+ *          overflow or flush to zero even where a sequential product would
+ *          have recovered. The product of an empty array is 1.
+ * @param a Array to multiply
+ * @param n Number of elements
+ * @param result Pointer to store the product
+ * @return CALC_SUCCESS on success, otherwise the error described above
+ * @pre a must not be NULL when n is non-zero; result must not be NULL
+ */
+CALC_API calc_result_t calculator_product(const double *a, size_t n, double *result);
+
+/**
+ * @brief Compute the dot product of two arrays with compensated summation
+ * @details Errors are reported as calculator_sum() reports them, and a
+ *          dot product that is zero while some a[i] * b[i] of nonzero
+ *          factors underflowed to zero is underflow as well. The dot
+ *          product of empty arrays is 0.
+ * @param a First array
+ * @param b Second array
+ * @param n Number of elements
+ * @param result Pointer to store sum(a[i] * b[i])
+ * @return CALC_SUCCESS on success, otherwise the error described above
+ * @pre a and b must not be NULL when n is non-zero; result must not be NULL
+ */
+CALC_API calc_result_t calculator_dot(const double *a, const double *b, size_t n, double *result);
+
+#endif /* CALCULATOR_REDUCE_H */
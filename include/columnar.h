@@ -0,0 +1,149 @@
+// ==========================================
+// FILE: columnar.h
+// ==========================================
+/**
+ * @file columnar.h
+ * @brief Columnar file header - Binary operand and result columns
+ * @details Defines a binary alternative to the text batch format that needs
+ *          no parsing or formatting. A file is a 64-byte header followed by
+ *          five columns, each starting on a COLUMNAR_ALIGNMENT boundary:
+ *          the operands a and b (double), op (one uint8_t batch_op_t code
+ *          per row), result (double, meaningful where error is 0) and error
+ *          (one uint8_t calc_result_t code per row). Every value is stored
+ *          little-endian. Files are mapped, so the batch kernels read the
+ *          operand columns and write the result and error columns in place.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "calculator_batch.h"
+
+// ==========================================
+// MARK: - Columnar Constants
+// ==========================================
+
+/** First eight bytes of every columnar file */
+#define COLUMNAR_MAGIC "CALCCOL1"
+
+/** Format version written into the header */
+#define COLUMNAR_VERSION 1
+
+/** Alignment of every column, in bytes (one cache line, one AVX-512 vector) */
+#define COLUMNAR_ALIGNMENT 64
+
+/** Runs of one op shorter than this are evaluated row by row */
+#define COLUMNAR_MIN_RUN 16
+
+// ==========================================
+// MARK: - Columnar Types
+// ==========================================
+
+/** Columnar result codes */
+typedef enum {
+    COLUMNAR_SUCCESS = 0,           ///< Operation completed
+    COLUMNAR_ERROR_INVALID_INPUT,   ///< Invalid argument
+    COLUMNAR_ERROR_IO,              ///< File could not be opened, sized or mapped
+    COLUMNAR_ERROR_FORMAT           ///< Not a columnar file, or a damaged one
+} columnar_result_t;
+
+/** Columns of a file, in the order of the header's offsets */
+typedef enum {
+    COLUMNAR_COLUMN_A = 0,
+    COLUMNAR_COLUMN_B,
+    COLUMNAR_COLUMN_OP,
+    COLUMNAR_COLUMN_RESULT,
+    COLUMNAR_COLUMN_ERROR,
+    COLUMNAR_COLUMN_COUNT
+} columnar_column_t;
+
+/** On-disk header, little-endian */
+typedef struct {
+    char magic[8];                              ///< COLUMNAR_MAGIC, not NUL-terminated
+    uint32_t version;                           ///< COLUMNAR_VERSION
+    uint32_t header_size;                       ///< sizeof(columnar_header_t)
+    uint64_t rows;                              ///< Rows in every column
+    uint64_t offsets[COLUMNAR_COLUMN_COUNT];    ///< File offset of each column
+} columnar_header_t;
+
+/** Open columnar file; the column pointers point into the mapping */
+typedef struct {
+    void *base;                 ///< Start of the mapping
+    size_t size;                ///< Mapped bytes (the whole file)
+    size_t rows;                ///< Rows in every column
+    bool writable;              ///< Result and error columns may be written
+    double *a;
+    double *b;
+    uint8_t *op;
+    double *result;
+    uint8_t *error;
+} columnar_file_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Create a columnar file
+ * @details Replaces path with a file of rows zeroed rows and maps it
+ *          writable; the caller fills in the operand and op columns.
+ * @param path File to create
+ * @param rows Number of rows
+ * @param file File to fill in
+ * @return COLUMNAR_SUCCESS on success, error code on failure
+ */
+columnar_result_t columnar_create(const char *path, size_t rows, columnar_file_t *file);
+
+/**
+ * @brief Open a columnar file
+ * @details Maps the file and checks the header: magic, version, and that
+ *          every column is aligned and lies inside the file.
+ * @param path File to open
+ * @param writable Map the file writable so it can be evaluated in place
+ * @param file File to fill in
+ * @return COLUMNAR_SUCCESS on success, error code on failure
+ */
+columnar_result_t columnar_open(const char *path, bool writable, columnar_file_t *file);
+
+/**
+ * @brief Unmap a columnar file
+ * @details Changes to a writable file reach the file through the shared
+ *          mapping.
+ * @param file File to close; safe to call twice
+ */
+void columnar_close(columnar_file_t *file);
+
+/**
+ * @brief Evaluate every row in place
+ * @details Splits the rows into runs of one op and hands each run's
+ *          columns straight to the matching *_batch() function; modulus,
+ *          invalid op codes and short runs go row by row through
+ *          batch_mode_evaluate(). Rows get the result and error code the
+ *          text batch format would have printed for them.
+ * @param file File opened writable
+ * @param summary Failure counts over all rows, or NULL
+ * @return COLUMNAR_SUCCESS on success, COLUMNAR_ERROR_INVALID_INPUT if the
+ *         file is not writable
+ */
+columnar_result_t columnar_evaluate(columnar_file_t *file, calc_batch_summary_t *summary);
+
+/**
+ * @brief Convert a text operations file to a columnar file
+ * @details Every line the text batch format prints a result for becomes
+ *          one row; malformed and overlong lines become rows with op code
+ *          BATCH_OP_INVALID. Blank lines and comments are dropped.
+ * @param text_path Text operations file (a regular file; it is mapped)
+ * @param columnar_path Columnar file to create
+ * @param rows Pointer to store the number of rows written, or NULL
+ * @return COLUMNAR_SUCCESS on success, error code on failure
+ */
+columnar_result_t columnar_convert_text(const char *text_path, const char *columnar_path,
+                                        size_t *rows);
+
+#endif /* COLUMNAR_H */
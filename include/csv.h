@@ -0,0 +1,101 @@
+// ==========================================
+// FILE: csv.h
+// ==========================================
+/**
+ * @file csv.h
+ * @brief CSV subsystem header - Streaming column-expression evaluation
+ * @details Defines the `calc --csv` front end. A compiled expression is
+ *          evaluated for every row of a comma-separated stream, reading
+ *          colN from the row's N-th field, and every row is written back
+ *          with two new fields appended: the result and the error name
+ *          (one of them empty). Fields may be quoted; quoted fields may
+ *          hold delimiters and newlines. Fields that are not numbers, and
+ *          missing fields, evaluate as invalid input.
+ *
+ *          Rows flow through a fixed ring of CSV_PIPELINE_DEPTH blocks and
+ *          three stages on their own threads: a reader that fills a block
+ *          with read() and cuts it into rows and fields, the calling thread
+ *          that runs the VM over the block's columns, and a writer that
+ *          formats the rows. Memory stays bounded by the ring whatever the
+ *          input size.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef CSV_H
+#define CSV_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "vm.h"
+
+// ==========================================
+// MARK: - CSV Constants
+// ==========================================
+
+/** Input bytes per block; also the longest accepted row */
+#define CSV_BLOCK_SIZE (4 * 1024 * 1024)
+
+/** Most rows per block */
+#define CSV_BLOCK_ROWS 65536
+
+/** Blocks in flight between the reader, compute and writer stages */
+#define CSV_PIPELINE_DEPTH 4
+
+/** Field delimiter and quote character */
+#define CSV_DELIMITER ','
+#define CSV_QUOTE '"'
+
+/** Names of the appended fields in a header row */
+#define CSV_HEADER_SUFFIX ",result,error"
+
+// ==========================================
+// MARK: - CSV Types
+// ==========================================
+
+/** CSV result codes */
+typedef enum {
+    CSV_SUCCESS = 0,            ///< Whole input processed
+    CSV_ERROR_INVALID_INPUT,    ///< Invalid argument
+    CSV_ERROR_IO,               ///< read() or write() failed
+    CSV_ERROR_MEMORY,           ///< Blocks could not be allocated
+    CSV_ERROR_OVERLONG,         ///< A row is longer than CSV_BLOCK_SIZE
+    CSV_ERROR_THREAD            ///< A pipeline thread could not be started
+} csv_result_t;
+
+/** Counters for one CSV run */
+typedef struct {
+    size_t rows;                ///< Data rows evaluated (the header row excluded)
+    size_t failed;              ///< Rows whose evaluation failed
+} csv_stats_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Evaluate an expression over every row of a CSV stream
+ * @details Output rows repeat the input row byte for byte (without its
+ *          line ending) followed by ",<result>," on success or
+ *          ",,<error name>" on failure, one per line. A header row gets
+ *          CSV_HEADER_SUFFIX instead and is not evaluated.
+ * @param input_fd File descriptor of the CSV input
+ * @param output_fd File descriptor receiving the extended rows
+ * @param program Compiled expression
+ * @param header The first row is a header row
+ * @param stats Counters to fill in, or NULL
+ * @return CSV_SUCCESS on success, error code on failure; rows before the
+ *         failure have been written
+ */
+csv_result_t csv_evaluate(int input_fd, int output_fd, const vm_program_t *program, bool header,
+                          csv_stats_t *stats);
+
+/**
+ * @brief Get the name of a CSV result code
+ * @param result Result code
+ * @return Static string such as "overlong"
+ */
+const char *csv_result_name(csv_result_t result);
+
+#endif /* CSV_H */
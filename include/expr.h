@@ -0,0 +1,157 @@
+// ==========================================
+// FILE: expr.h
+// ==========================================
+/**
+ * @file expr.h
+ * @brief Expression subsystem header - Parsing and evaluating arithmetic
+ * @details Defines a tokenizer, a Pratt parser that builds a compact AST and
+ *          an evaluator that runs the AST through the calculator engine.
+ *          Expressions use + - * / % ^, unary minus, parentheses, numbers
+ *          in the locale-independent parser's syntax and input references
+ *          col1, col2, ... that read one value per row; ^ binds
+ *          tighter than unary minus and is right-associative, so -2^2 is -4
+ *          and 2^3^2 is 512. Nodes and evaluation scratch are bump-allocated
+ *          from a caller-provided arena in one piece per expression, so
+ *          parsing never calls malloc per token.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef EXPR_H
+#define EXPR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "calculator.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - Expression Constants
+// ==========================================
+
+/** Maximum number of AST nodes in one expression */
+#define EXPR_MAX_NODES (1u << 16)
+
+/** Maximum nesting of parentheses, prefix operators and right operands */
+#define EXPR_MAX_DEPTH 64
+
+/** Highest input number accepted in colN references */
+#define EXPR_MAX_INPUTS 1024
+
+/** Prefix of input references */
+#define EXPR_INPUT_PREFIX "col"
+
+// ==========================================
+// MARK: - Expression Types
+// ==========================================
+
+/** Expression parser result codes */
+typedef enum {
+    EXPR_SUCCESS = 0,           ///< Expression parsed
+    EXPR_ERROR_INVALID_INPUT,   ///< Invalid argument
+    EXPR_ERROR_SYNTAX,          ///< Text is not a well-formed expression
+    EXPR_ERROR_TOO_COMPLEX,     ///< Node or nesting limit exceeded
+    EXPR_ERROR_MEMORY           ///< Arena allocation failed
+} expr_result_t;
+
+/** AST node kinds; binary kinds map one-to-one onto calculator_* operations */
+typedef enum {
+    EXPR_NODE_NUMBER = 0,       ///< Literal value
+    EXPR_NODE_INPUT,            ///< Input reference colN
+    EXPR_NODE_NEGATE,           ///< Unary minus
+    EXPR_NODE_ADD,              ///< a + b
+    EXPR_NODE_SUBTRACT,         ///< a - b
+    EXPR_NODE_MULTIPLY,         ///< a * b
+    EXPR_NODE_DIVIDE,           ///< a / b
+    EXPR_NODE_MODULUS,          ///< a % b (operands truncated to int64_t)
+    EXPR_NODE_POWER             ///< a ^ b
+} expr_node_kind_t;
+
+/**
+ * One AST node (16 bytes). Children are referenced by index and always
+ * precede their parent, so the node array is in evaluation (postfix) order.
+ */
+typedef struct {
+    union {
+        double value;           ///< EXPR_NODE_NUMBER: literal value
+        uint32_t input;         ///< EXPR_NODE_INPUT: zero-based input index (colN is N - 1)
+        struct {
+            uint32_t left;      ///< Left operand (the only one for NEGATE)
+            uint32_t right;     ///< Right operand of binary nodes
+        } children;
+    } as;
+    uint8_t kind;               ///< expr_node_kind_t
+} expr_node_t;
+
+/**
+ * Parsed expression. Its storage belongs to the arena it was parsed into
+ * and is valid until that arena is reset or released past it.
+ */
+typedef struct {
+    expr_node_t *nodes;                 ///< Nodes in postfix order
+    double *values;                     ///< expr_evaluate() scratch, one value per node
+    uint32_t capacity;                  ///< Nodes allocated
+    uint32_t count;                     ///< Number of nodes in use
+    uint32_t root;                      ///< Index of the root node (count - 1)
+    uint32_t input_count;               ///< One past the highest input index referenced
+    size_t error_offset;                ///< Byte offset of a syntax error
+} expr_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Parse an expression
+ * @details Every node consumes at least one character, so storage for
+ *          min(length, EXPR_MAX_NODES) nodes is taken from the arena up front.
+ * @param text Expression text (need not be NUL-terminated)
+ * @param length Length of text in bytes
+ * @param arena Arena that receives the nodes
+ * @param expr Expression to fill in
+ * @return EXPR_SUCCESS on success; on failure expr->error_offset holds the
+ *         offset of the offending character
+ */
+CALC_API expr_result_t expr_parse(const char *text, size_t length, arena_t *arena, expr_t *expr);
+
+/**
+ * @brief Evaluate a parsed expression without inputs
+ * @details Equivalent to expr_evaluate_inputs() with no inputs and
+ *          expr->values as scratch, so any colN reference is invalid input
+ *          and one expression must not be evaluated from two threads at once.
+ * @param expr Expression produced by expr_parse()
+ * @param result Pointer to store the value
+ * @return CALC_SUCCESS on success, otherwise the first failing operation's code
+ */
+CALC_API calc_result_t expr_evaluate(expr_t *expr, double *result);
+
+/**
+ * @brief Evaluate a parsed expression for one row of inputs
+ * @details Applies the calculator_* operation of every node in postfix
+ *          order and stops at the first failure. Literals that overflowed
+ *          while parsing and non-finite inputs are invalid input, as they
+ *          would be for calculator_*, and take precedence over any
+ *          operation error; modulus operands outside int64_t range are
+ *          invalid input as well. The expression is only read, and
+ *          intermediate values go to the caller's scratch, so threads with
+ *          their own scratch can evaluate one expression at the same time.
+ * @param expr Expression produced by expr_parse()
+ * @param inputs Input values, inputs[N - 1] for colN
+ * @param input_count Number of input values
+ * @param scratch Intermediate values, at least expr->count elements
+ * @param result Pointer to store the value
+ * @return CALC_SUCCESS on success, otherwise the first failing operation's code
+ */
+CALC_API calc_result_t expr_evaluate_inputs(const expr_t *expr, const double *inputs,
+                                            size_t input_count, double *scratch, double *result);
+
+/**
+ * @brief Get a short name for an expression result code
+ * @param result Result code
+ * @return Static string such as "syntax"
+ */
+CALC_API const char *expr_result_name(expr_result_t result);
+
+#endif /* EXPR_H */
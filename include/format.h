@@ -0,0 +1,65 @@
+// ==========================================
+// FILE: format.h
+// ==========================================
+/**
+ * @file format.h
+ * @brief Format subsystem header - Fast double to text conversion
+ * @details Defines locale-independent, allocation-free formatting of doubles
+ *          into caller-provided buffers. The shortest mode writes the fewest
+ *          digits that read back to the same double (Schubfach algorithm);
+ *          the general mode reproduces printf's "%.Ng" output exactly for
+ *          precisions up to 15.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stddef.h>
+
+// ==========================================
+// MARK: - Format Constants
+// ==========================================
+
+/** Buffer size that fits any formatted double plus the terminating NUL */
+#define FORMAT_BUFFER_SIZE 32
+
+/** Significant digits of the "%.6g" style used by the interactive menu */
+#define FORMAT_DISPLAY_PRECISION 6
+
+/** Highest precision format_double_general() reproduces exactly */
+#define FORMAT_MAX_GENERAL_PRECISION 15
+
+/** Decimal exponent at which shortest mode switches to scientific notation */
+#define FORMAT_SHORTEST_SCIENTIFIC_EXPONENT 17
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Format the shortest round-trip representation
+ * @details Writes the fewest significant digits that parse back to exactly
+ *          the same double, in "%.17g" layout: fixed notation for decimal
+ *          exponents in [-4, 17), scientific ("1.5e+300") otherwise.
+ *          Infinities and NaNs are written as inf, -inf, nan and -nan.
+ * @param value Value to format
+ * @param buffer Output buffer of at least FORMAT_BUFFER_SIZE bytes
+ * @return Number of characters written, excluding the terminating NUL
+ */
+size_t format_double_shortest(double value, char *buffer);
+
+/**
+ * @brief Format like printf("%.*g", precision, value)
+ * @details Rounds the exact binary value half-to-even, as glibc does, and
+ *          produces byte-identical output to printf in the "C" locale.
+ * @param value Value to format
+ * @param precision Significant digits, clamped to [1, FORMAT_MAX_GENERAL_PRECISION]
+ * @param buffer Output buffer of at least FORMAT_BUFFER_SIZE bytes
+ * @return Number of characters written, excluding the terminating NUL
+ */
+size_t format_double_general(double value, int precision, char *buffer);
+
+#endif /* FORMAT_H */
@@ -17,6 +17,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "output.h"
+#include "pool.h"
 
 // ==========================================
 // MARK: - Application Constants
@@ -38,6 +40,32 @@
 // MARK: - Return Codes
 // ==========================================
 
+/** Command line flag that selects batch mode */
+#define APP_FLAG_BATCH "--batch"
+
+/** Command line flag that evaluates one expression */
+#define APP_FLAG_EXPR "--expr"
+
+/** Command line flags for columnar files: evaluate one in place / convert a text file to one */
+#define APP_FLAG_COLUMNAR "--columnar"
+#define APP_FLAG_TO_COLUMNAR "--to-columnar"
+
+/** CSV mode flags: input file, output file (default stdout), first row is a header */
+#define APP_FLAG_CSV "--csv"
+#define APP_FLAG_OUT "--out"
+#define APP_FLAG_CSV_HEADER "--csv-header"
+
+/** Command line flag that prints usage */
+#define APP_FLAG_HELP "--help"
+
+/** Batch mode flags: flush results every N lines / every N microseconds */
+#define APP_FLAG_FLUSH_RECORDS "--flush-every"
+#define APP_FLAG_FLUSH_US "--flush-us"
+
+/** Thread pool flags: thread count (submitting thread included) / pin workers to CPUs */
+#define APP_FLAG_THREADS "--threads"
+#define APP_FLAG_PIN_THREADS "--pin-threads"
+
 /** Application exit codes */
 typedef enum {
     APP_SUCCESS = 0,        ///< Application completed successfully
@@ -46,10 +74,86 @@ typedef enum {
     APP_ERROR_MEMORY = 3    ///< Memory allocation error
 } app_result_t;
 
+/** Application run modes */
+typedef enum {
+    APP_MODE_INTERACTIVE = 0,   ///< Menu-driven session (default)
+    APP_MODE_BATCH,             ///< Headless evaluation of an operations file
+    APP_MODE_EXPRESSION,        ///< Evaluate one expression and print the result
+    APP_MODE_COLUMNAR,          ///< Evaluate a columnar file in place
+    APP_MODE_CONVERT,           ///< Convert an operations file to a columnar file
+    APP_MODE_CSV,               ///< Evaluate an expression over the rows of a CSV file
+    APP_MODE_HELP               ///< Print usage and exit
+} app_mode_t;
+
+/** Options parsed from the command line */
+typedef struct {
+    app_mode_t mode;            ///< Selected run mode
+    const char *batch_path;     ///< Operations file for APP_MODE_BATCH ("-" for stdin) and APP_MODE_CONVERT
+    const char *columnar_path;  ///< Columnar file for APP_MODE_COLUMNAR and APP_MODE_CONVERT
+    const char *expression;     ///< Expression text for APP_MODE_EXPRESSION and APP_MODE_CSV
+    const char *csv_path;       ///< CSV input for APP_MODE_CSV ("-" for stdin)
+    const char *out_path;       ///< CSV output for APP_MODE_CSV, NULL for stdout
+    bool csv_header;            ///< The CSV input starts with a header row
+    output_flush_policy_t flush_policy; ///< Result flush policy for APP_MODE_BATCH
+    pool_config_t pool;         ///< Thread pool configuration
+} app_options_t;
+
 // ==========================================
 // MARK: - Function Prototypes
 // ==========================================
 
+/**
+ * @brief Parse command line arguments
+ * @details Recognizes `--batch <file>`, `--expr <text>`, `--csv <file>`,
+ *          `--out <file>`, `--csv-header`, `--columnar <file>`,
+ *          `--to-columnar <text> <file>`, `--flush-every <n>`,
+ *          `--flush-us <n>`, `--threads <n>`, `--pin-threads` and `--help`;
+ *          no arguments selects the interactive menu.
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param options Pointer to store the parsed options
+ * @return APP_SUCCESS on success, APP_ERROR_INIT on unknown or incomplete arguments
+ * @pre options must not be NULL
+ */
+app_result_t app_parse_arguments(int argc, char *argv[], app_options_t *options);
+
+/**
+ * @brief Run the headless batch mode
+ * @details Initializes the calculator engine and evaluates the operations
+ *          file without banners, menus or pauses.
+ * @param options Parsed options with mode APP_MODE_BATCH
+ * @return APP_SUCCESS on success, error code on failure
+ */
+app_result_t app_run_batch(const app_options_t *options);
+
+/**
+ * @brief Evaluate one expression from the command line
+ * @details Prints the value in shortest round-trip form on stdout; syntax
+ *          and calculation errors go to stderr.
+ * @param options Parsed options with mode APP_MODE_EXPRESSION
+ * @return APP_SUCCESS on success, error code on failure
+ */
+app_result_t app_run_expression(const app_options_t *options);
+
+/**
+ * @brief Evaluate an expression over every row of a CSV file
+ * @details Writes each row with the result and error fields appended to
+ *          the --out file, or to stdout.
+ * @param options Parsed options with mode APP_MODE_CSV
+ * @return APP_SUCCESS on success, error code on failure
+ */
+app_result_t app_run_csv(const app_options_t *options);
+
+/**
+ * @brief Evaluate a columnar file in place, or convert a text file to one
+ * @details APP_MODE_COLUMNAR writes the result and error columns of the file
+ *          and prints the row and failure counts; APP_MODE_CONVERT prints
+ *          the number of rows written.
+ * @param options Parsed options with mode APP_MODE_COLUMNAR or APP_MODE_CONVERT
+ * @return APP_SUCCESS on success, error code on failure
+ */
+app_result_t app_run_columnar(const app_options_t *options);
+
 /**
  * @brief Initialize the application
  * @details Sets up the application environment, displays welcome message,
@@ -83,6 +187,12 @@ void app_cleanup(void);
  */
 void app_display_welcome(void);
 
+/**
+ * @brief Display command line usage
+ * @param program Program name from argv[0]
+ */
+void app_display_usage(const char *program);
+
 /**
  * @brief Display application goodbye message
  * @details Shows farewell message before application termination.
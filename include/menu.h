@@ -23,11 +23,17 @@
 // ==========================================
 
 /** Maximum number of menu choices */
-#define MENU_MAX_CHOICES 7
+#define MENU_MAX_CHOICES 8
 
 /** Menu choice validation bounds */
 #define MENU_MIN_CHOICE 1
-#define MENU_MAX_CHOICE 7
+#define MENU_MAX_CHOICE 8
+
+/** Input window for standard input; also the longest accepted line */
+#define MENU_INPUT_BUFFER_SIZE 4096
+
+/** Arena block size for expressions typed at the menu (fits the longest line) */
+#define MENU_ARENA_BLOCK_SIZE (MENU_INPUT_BUFFER_SIZE * 32)
 
 // ==========================================
 // MARK: - Menu Types
@@ -38,7 +44,8 @@ typedef enum {
     MENU_SUCCESS = 0,           ///< Menu operation completed successfully
     MENU_ERROR_INVALID_INPUT,   ///< Invalid user input received
     MENU_ERROR_IO,             ///< Input/output error
-    MENU_ERROR_INIT            ///< Menu initialization error
+    MENU_ERROR_INIT,           ///< Menu initialization error
+    MENU_ERROR_MEMORY          ///< Expression arena exhausted
 } menu_result_t;
 
 /** Available menu choices */
@@ -50,7 +57,8 @@ typedef enum {
     MENU_CHOICE_DIVIDE = 4,     ///< Division operation
     MENU_CHOICE_MODULUS = 5,    ///< Modulus operation
     MENU_CHOICE_POWER = 6,      ///< Power operation
-    MENU_CHOICE_EXIT = 7        ///< Exit application
+    MENU_CHOICE_EXPRESSION = 7, ///< Evaluate a whole expression
+    MENU_CHOICE_EXIT = 8        ///< Exit application
 } menu_choice_t;
 
 // ==========================================
@@ -93,6 +101,15 @@ menu_result_t menu_display_and_get_choice(menu_choice_t *choice);
  */
 menu_result_t menu_handle_calculation(menu_choice_t operation);
 
+/**
+ * @brief Handle expression request from menu
+ * @details Reads one expression such as `(1 + 2) * 3 ^ 2`, evaluates it
+ *          through the expression subsystem and displays the result.
+ * @return MENU_SUCCESS when an expression was read, MENU_ERROR_MEMORY if
+ *         the expression arena is exhausted, error code on other failures
+ */
+menu_result_t menu_handle_expression(void);
+
 /**
  * @brief Display the main menu
  * @details Renders the formatted main menu interface to stdout.
@@ -101,16 +118,19 @@ void menu_display_main_menu(void);
 
 /**
  * @brief Get and validate user input
- * @details Safely reads user input and validates it against menu choices.
+ * @details Safely reads one line of user input and validates it against
+ *          menu choices.
  * @param choice Pointer to store the validated choice
- * @return MENU_SUCCESS on valid input, error code on invalid input
+ * @return MENU_SUCCESS on valid input, MENU_ERROR_IO at end of input,
+ *         MENU_ERROR_INVALID_INPUT otherwise
  * @pre choice must not be NULL
  */
 menu_result_t menu_get_user_input(menu_choice_t *choice);
 
 /**
  * @brief Get numeric input from user
- * @details Safely reads and validates numeric input from the user.
+ * @details Safely reads one line and parses it with the locale-independent
+ *          number parser.
  * @param prompt Message to display to the user
  * @param value Pointer to store the numeric value
  * @return MENU_SUCCESS on valid input, error code on invalid input
@@ -120,7 +140,7 @@ menu_result_t menu_get_numeric_input(const char *prompt, double *value);
 
 /**
  * @brief Clear input buffer
- * @details Clears the input buffer to prevent input contamination.
+ * @details Discards the next input line; used for "Press Enter" pauses.
  */
 void menu_clear_input_buffer(void);
 
@@ -0,0 +1,153 @@
+// ==========================================
+// FILE: output.h
+// ==========================================
+/**
+ * @file output.h
+ * @brief Output subsystem header - Buffered single-syscall output
+ * @details Defines a writer that renders text into a preallocated buffer and
+ *          hands it to the kernel with one write() (or writev() when a large
+ *          block does not fit behind pending text). The interactive menu
+ *          flushes once per screen, right before it waits for input; batch
+ *          mode flushes when the buffer fills or when its flush policy asks
+ *          for it after N records or N microseconds.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==========================================
+// MARK: - Output Constants
+// ==========================================
+
+/** Buffer size of the shared standard output writer */
+#define OUTPUT_STDOUT_BUFFER_SIZE (16 * 1024)
+
+/** Smallest buffer a writer accepts; fits any formatted double */
+#define OUTPUT_MIN_CAPACITY 64
+
+// ==========================================
+// MARK: - Output Types
+// ==========================================
+
+/** Output operation result codes */
+typedef enum {
+    OUTPUT_SUCCESS = 0,         ///< Data buffered or written
+    OUTPUT_ERROR_INVALID_INPUT, ///< Invalid argument
+    OUTPUT_ERROR_IO             ///< write() failed; the writer stays failed
+} output_result_t;
+
+/**
+ * When a writer flushes besides a full buffer. Both limits are checked when
+ * a record ends, so a quiet producer is flushed by its next record or by
+ * an explicit output_flush().
+ */
+typedef struct {
+    size_t max_records;         ///< Flush after this many records, 0 for no limit
+    uint64_t max_delay_us;      ///< Flush once the oldest pending record is this old, 0 for no limit
+} output_flush_policy_t;
+
+/** Buffered writer over a file descriptor */
+typedef struct {
+    int fd;                         ///< Output file descriptor
+    char *buffer;                   ///< Caller-provided output buffer
+    size_t capacity;                ///< Size of the buffer in bytes
+    size_t length;                  ///< Bytes pending in the buffer
+    output_flush_policy_t policy;   ///< Record-based flush policy
+    size_t pending_records;         ///< Records ended since the last flush
+    uint64_t first_pending_ns;      ///< Monotonic time the first pending record ended
+    bool failed;                    ///< A write error occurred
+} output_writer_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Initialize a writer
+ * @details The writer starts with no record-based flush policy.
+ * @param writer Writer to initialize
+ * @param fd File descriptor to write to
+ * @param buffer Output buffer
+ * @param capacity Size of buffer in bytes, at least OUTPUT_MIN_CAPACITY
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_INVALID_INPUT on bad arguments
+ */
+output_result_t output_init(output_writer_t *writer, int fd, char *buffer, size_t capacity);
+
+/**
+ * @brief Set the record-based flush policy
+ * @param writer Initialized writer
+ * @param policy New policy, or NULL to flush only when the buffer fills
+ */
+void output_set_policy(output_writer_t *writer, const output_flush_policy_t *policy);
+
+/**
+ * @brief Append bytes
+ * @details Data that does not fit behind pending text is written together
+ *          with it in one writev() call.
+ * @param writer Initialized writer
+ * @param data Bytes to append
+ * @param length Number of bytes
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO if a flush failed
+ */
+output_result_t output_write(output_writer_t *writer, const char *data, size_t length);
+
+/**
+ * @brief Append a NUL-terminated string
+ * @param writer Initialized writer
+ * @param text String to append
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO if a flush failed
+ */
+output_result_t output_puts(output_writer_t *writer, const char *text);
+
+/**
+ * @brief Append printf-formatted text
+ * @details Formats straight into the buffer when the text fits.
+ * @param writer Initialized writer
+ * @param format printf format string
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO if a flush failed,
+ *         OUTPUT_ERROR_INVALID_INPUT if formatting failed
+ */
+output_result_t output_printf(output_writer_t *writer, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Append a double in shortest round-trip form
+ * @param writer Initialized writer
+ * @param value Value to append
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO if a flush failed
+ */
+output_result_t output_double(output_writer_t *writer, double value);
+
+/**
+ * @brief End one record (e.g. one batch result line)
+ * @details Flushes if the policy's record count or age limit is reached.
+ * @param writer Initialized writer
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO if a flush failed
+ */
+output_result_t output_end_record(output_writer_t *writer);
+
+/**
+ * @brief Write all pending bytes
+ * @details Retries partial writes and EINTR until everything is written.
+ * @param writer Initialized writer
+ * @return OUTPUT_SUCCESS on success, OUTPUT_ERROR_IO on write errors
+ */
+output_result_t output_flush(output_writer_t *writer);
+
+/**
+ * @brief Get the shared standard output writer
+ * @details Lazily initialized over STDOUT_FILENO with a static buffer of
+ *          OUTPUT_STDOUT_BUFFER_SIZE bytes. Its owner flushes it before
+ *          waiting for input and before exiting.
+ * @return Writer for standard output
+ */
+output_writer_t *output_stdout(void);
+
+#endif /* OUTPUT_H */
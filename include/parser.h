@@ -0,0 +1,188 @@
+// ==========================================
+// FILE: parser.h
+// ==========================================
+/**
+ * @file parser.h
+ * @brief Parser subsystem header - Buffered line input and number parsing
+ * @details Defines a locale-independent number parser and a line reader that
+ *          works over a caller-provided input window. Doubles are correctly
+ *          rounded: exact small cases take Clinger's fast path, everything
+ *          else goes through the Eisel-Lemire algorithm over a table of
+ *          128-bit powers of five. Lines are found with memchr, so neither
+ *          the menu nor batch mode reads input one character at a time.
+ *          Regular files can instead be mapped whole and cut into lines in
+ *          place, without read() copying them into a window first.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ==========================================
+// MARK: - Parser Constants
+// ==========================================
+
+/** Significant decimal digits that fit a 64-bit mantissa exactly */
+#define PARSER_MAX_DIGITS 19
+
+/** Smallest and largest decimal exponents covered by the power-of-five table */
+#define PARSER_POW5_MIN (-342)
+#define PARSER_POW5_MAX 308
+
+// ==========================================
+// MARK: - Parser Types
+// ==========================================
+
+/** Parser operation result codes */
+typedef enum {
+    PARSER_SUCCESS = 0,         ///< Line returned
+    PARSER_ERROR_INVALID_INPUT, ///< Invalid argument
+    PARSER_ERROR_OVERLONG,      ///< Line exceeded the input window and was skipped
+    PARSER_ERROR_IO,            ///< read() failed
+    PARSER_ERROR_EOF            ///< No more input
+} parser_result_t;
+
+/**
+ * Line reader over a file descriptor. Returned lines point into the window
+ * and stay valid until the next call on the same reader.
+ */
+typedef struct {
+    int fd;                     ///< Input file descriptor
+    char *buffer;               ///< Caller-provided input window
+    size_t capacity;            ///< Size of the window in bytes
+    size_t start;               ///< Offset of the first unconsumed byte
+    size_t end;                 ///< Offset one past the last buffered byte
+    bool eof;                   ///< read() has reported end of input
+    bool skipping;              ///< Discarding the rest of an overlong line
+} parser_reader_t;
+
+/** Read-only mapping of a whole input file, advised for sequential access */
+typedef struct {
+    const char *data;           ///< First byte of the file, NULL when empty
+    size_t size;                ///< File size in bytes
+    size_t released;            ///< Offset below which pages were handed back
+} parser_map_t;
+
+/**
+ * Line cutter over bytes already in memory. Lines follow the same rules as
+ * parser_reader_next_line() with a window of max_length bytes and point
+ * straight into the bytes.
+ */
+typedef struct {
+    const char *cursor;         ///< First byte not yet returned
+    const char *end;            ///< One past the last byte
+    size_t max_length;          ///< Lines this long or longer are overlong
+} parser_span_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Initialize a line reader
+ * @param reader Reader to initialize
+ * @param fd File descriptor to read from
+ * @param buffer Input window, which also bounds the longest accepted line
+ * @param capacity Size of buffer in bytes
+ * @return PARSER_SUCCESS on success, PARSER_ERROR_INVALID_INPUT on bad arguments
+ */
+parser_result_t parser_reader_init(parser_reader_t *reader, int fd, char *buffer, size_t capacity);
+
+/**
+ * @brief Get the next line
+ * @details Refills the window with read() as needed and locates the newline
+ *          with memchr. The newline and a preceding '\r' are not included.
+ *          A final line without a newline is returned at end of input.
+ * @param reader Initialized reader
+ * @param line Pointer to store the start of the line
+ * @param length Pointer to store the line length
+ * @return PARSER_SUCCESS with a line, PARSER_ERROR_OVERLONG if a line did
+ *         not fit the window (it is skipped whole), PARSER_ERROR_EOF at end
+ *         of input, PARSER_ERROR_IO on read errors
+ */
+parser_result_t parser_reader_next_line(parser_reader_t *reader, const char **line, size_t *length);
+
+/**
+ * @brief Map a file for reading
+ * @details Maps the whole file read-only and advises the kernel that it is
+ *          read front to back (MADV_SEQUENTIAL), so readahead runs ahead of
+ *          the parser. Does not move the file offset.
+ * @param map Mapping to fill in
+ * @param fd File descriptor of a regular file
+ * @return PARSER_SUCCESS on success, PARSER_ERROR_IO if fd is not a regular
+ *         file or cannot be mapped (read it with a parser_reader_t instead)
+ */
+parser_result_t parser_map_open(parser_map_t *map, int fd);
+
+/**
+ * @brief Hand back the pages before an offset
+ * @details Drops the whole pages below offset from the process
+ *          (MADV_DONTNEED), so a run over a file larger than memory keeps a
+ *          bounded footprint. Bytes below offset must not be read again.
+ * @param map Open mapping
+ * @param offset Offset up to which the input has been consumed
+ */
+void parser_map_release(parser_map_t *map, size_t offset);
+
+/**
+ * @brief Unmap a file
+ * @param map Mapping to close; safe to call on an empty mapping
+ */
+void parser_map_close(parser_map_t *map);
+
+/**
+ * @brief Initialize a line cutter
+ * @param span Cutter to initialize
+ * @param begin First byte
+ * @param end One past the last byte
+ * @param max_length Length at which a line counts as overlong
+ * @return PARSER_SUCCESS on success, PARSER_ERROR_INVALID_INPUT on bad arguments
+ */
+parser_result_t parser_span_init(parser_span_t *span, const char *begin, const char *end,
+                                 size_t max_length);
+
+/**
+ * @brief Get the next line of a span
+ * @param span Initialized cutter
+ * @param line Pointer to store the start of the line
+ * @param length Pointer to store the line length
+ * @return PARSER_SUCCESS with a line, PARSER_ERROR_OVERLONG for a line of
+ *         max_length bytes or more, PARSER_ERROR_EOF at the end of the span
+ */
+parser_result_t parser_span_next_line(parser_span_t *span, const char **line, size_t *length);
+
+/**
+ * @brief Parse a double
+ * @details Accepts [+-]digits[.digits][(e|E)[+-]digits] as well as inf,
+ *          infinity and nan in any case. The decimal point is always '.'.
+ * @param begin Start of the text
+ * @param end End of the text (exclusive)
+ * @param value Pointer to store the correctly rounded value
+ * @return Pointer one past the number, or NULL if no number starts at begin
+ */
+const char *parser_parse_double(const char *begin, const char *end, double *value);
+
+/**
+ * @brief Parse a decimal int
+ * @param begin Start of the text
+ * @param end End of the text (exclusive)
+ * @param value Pointer to store the value
+ * @return Pointer one past the number, or NULL if there is no number or it
+ *         does not fit an int
+ */
+const char *parser_parse_int(const char *begin, const char *end, int *value);
+
+/**
+ * @brief Skip spaces and tabs
+ * @param begin Start of the text
+ * @param end End of the text (exclusive)
+ * @return Pointer to the first non-blank character, or end
+ */
+const char *parser_skip_blanks(const char *begin, const char *end);
+
+#endif /* PARSER_H */
@@ -0,0 +1,119 @@
+// ==========================================
+// FILE: pool.h
+// ==========================================
+/**
+ * @file pool.h
+ * @brief Thread pool header - Work-stealing parallel loops
+ * @details Defines a process-wide pool of worker threads for data-parallel
+ *          loops. Every worker owns a deque of index ranges: it splits its
+ *          range in halves, pushes the upper halves onto the bottom of its
+ *          deque and works on the lower one, and when its deque runs dry it
+ *          steals the oldest (largest) range from a randomly chosen victim.
+ *          The submitting thread takes part as one more worker, so a pool
+ *          of N threads starts N - 1 of them. Idle threads park on a
+ *          condition variable instead of spinning.
+ *
+ *          The pool runs one loop at a time. Loops submitted from
+ *          different threads are serialized on one submit lock, so each
+ *          waits until the loop in flight has finished and concurrent
+ *          callers gain no throughput over a single one. A loop submitted
+ *          from inside a running one runs inline.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ==========================================
+// MARK: - Pool Constants
+// ==========================================
+
+/** Environment variable with the thread count (submitting thread included) */
+#define POOL_THREADS_ENV "CALC_THREADS"
+
+/** Environment variable that pins workers to CPUs when set to 1 */
+#define POOL_PIN_ENV "CALC_PIN_THREADS"
+
+/** Largest accepted thread count */
+#define POOL_MAX_THREADS 1024
+
+/** Ranges one deque can hold; a full deque runs its overflow inline */
+#define POOL_DEQUE_CAPACITY 128
+
+// ==========================================
+// MARK: - Pool Types
+// ==========================================
+
+/** Pool result codes */
+typedef enum {
+    POOL_SUCCESS = 0,           ///< Pool started or stopped
+    POOL_ERROR_INVALID_INPUT,   ///< Bad thread count in the config or environment
+    POOL_ERROR_MEMORY,          ///< Allocation failed
+    POOL_ERROR_THREAD           ///< A worker thread could not be started
+} pool_result_t;
+
+/** Pool configuration */
+typedef struct {
+    size_t threads;             ///< Threads including the submitting one; 0 for CALC_THREADS or one per online CPU
+    bool pin;                   ///< Pin worker i to the i + 1-th allowed CPU (also set by CALC_PIN_THREADS=1)
+} pool_config_t;
+
+/**
+ * Loop body: handles units [begin, end). Ranges passed to one call of
+ * pool_parallel_for() are disjoint, cover [0, count) and hold at most
+ * grain units each; they may run on any thread in any order.
+ */
+typedef void (*pool_range_fn_t)(void *context, size_t begin, size_t end);
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Start the process-wide pool
+ * @details Stops a running pool first, after waiting for a loop in
+ *          flight on another thread. With a single thread no worker is
+ *          started and every loop runs inline. Must not be called from
+ *          inside a loop body.
+ * @param config Configuration, or NULL for the defaults
+ * @return POOL_SUCCESS on success, POOL_ERROR_INVALID_INPUT from inside a
+ *         loop body, otherwise the reason the pool is not running
+ */
+pool_result_t pool_initialize(const pool_config_t *config);
+
+/**
+ * @brief Stop the pool and join its workers
+ * @details Waits for a loop in flight on another thread before stopping.
+ *          Safe to call when the pool is not running; does nothing from
+ *          inside a loop body. A later loop starts the pool again with the
+ *          defaults.
+ */
+void pool_shutdown(void);
+
+/**
+ * @brief Get the number of threads loops run on
+ * @return Worker threads plus the submitting thread; 1 if the pool is not running
+ */
+size_t pool_thread_count(void);
+
+/**
+ * @brief Run a loop body over [0, count) on the pool
+ * @details Starts the pool with the defaults if it was never started and
+ *          returns once every unit has been handled. Any thread may call
+ *          it, but only one loop runs at a time: a call made while another
+ *          thread's loop is in flight blocks until that loop finishes. Runs
+ *          inline when the pool has no workers, when count fits in one
+ *          grain, or when called from inside a loop body.
+ * @param count Number of units
+ * @param grain Largest range handed to one fn call (0 is treated as 1)
+ * @param fn Loop body
+ * @param context Passed to fn unchanged
+ */
+void pool_parallel_for(size_t count, size_t grain, pool_range_fn_t fn, void *context);
+
+#endif /* POOL_H */
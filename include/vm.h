@@ -0,0 +1,138 @@
+// ==========================================
+// FILE: vm.h
+// ==========================================
+/**
+ * @file vm.h
+ * @brief Expression VM header - Bytecode compiler and register machine
+ * @details Defines a compile step that lowers a parsed expression into flat
+ *          bytecode over a small register file, and a threaded interpreter
+ *          for it. Registers hold the literals first, then the inputs, then
+ *          temporaries, so a row only loads its inputs before the
+ *          instructions run. Results and error codes match expr_evaluate().
+ *          The column entry point runs one program over columns of inputs
+ *          in chunks of VM_CHUNK_ROWS rows, using the batch kernels for
+ *          + - * / and falling back to the row interpreter only for chunks
+ *          that contain a failure.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#ifndef VM_H
+#define VM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+#include "calculator_batch.h"
+#include "expr.h"
+#include "calc_api.h"
+
+// ==========================================
+// MARK: - VM Constants
+// ==========================================
+
+/** Size of the register file (literals + inputs + temporaries) */
+#define VM_MAX_REGISTERS 64
+
+/** Rows per chunk in column mode */
+#define VM_CHUNK_ROWS 128
+
+// ==========================================
+// MARK: - VM Types
+// ==========================================
+
+/** VM compiler result codes */
+typedef enum {
+    VM_SUCCESS = 0,             ///< Program compiled
+    VM_ERROR_INVALID_INPUT,     ///< Invalid argument
+    VM_ERROR_TOO_COMPLEX,       ///< Register file exceeded
+    VM_ERROR_MEMORY             ///< Arena allocation failed
+} vm_result_t;
+
+/** Instruction opcodes */
+typedef enum {
+    VM_OP_ADD = 0,              ///< dst = a + b
+    VM_OP_SUBTRACT,             ///< dst = a - b
+    VM_OP_MULTIPLY,             ///< dst = a * b
+    VM_OP_DIVIDE,               ///< dst = a / b
+    VM_OP_MODULUS,              ///< dst = (int64_t)a % (int64_t)b
+    VM_OP_POWER,                ///< dst = a ^ b
+    VM_OP_NEGATE,               ///< dst = -a
+    VM_OP_HALT,                 ///< Return register a
+    VM_OP_COUNT
+} vm_opcode_t;
+
+/** One instruction: opcode and three register numbers */
+typedef struct {
+    uint8_t op;                 ///< vm_opcode_t
+    uint8_t dst;                ///< Destination register
+    uint8_t a;                  ///< First source register
+    uint8_t b;                  ///< Second source register (unused by NEGATE and HALT)
+} vm_instruction_t;
+
+/** Compiled program; the code lives in the arena it was compiled into */
+typedef struct {
+    vm_instruction_t *code;                     ///< Instructions, ending with HALT
+    double constants[VM_MAX_REGISTERS];         ///< Values of registers [0, constant_count)
+    uint32_t inputs[VM_MAX_REGISTERS];          ///< Input index of register constant_count + i
+    uint32_t code_length;                       ///< Number of instructions
+    uint32_t input_limit;                       ///< One past the highest input index read
+    uint8_t constant_count;                     ///< Number of literal registers
+    uint8_t input_count;                        ///< Number of input registers
+    uint8_t register_count;                     ///< Registers in use, temporaries included
+    bool invalid_constant;                      ///< A literal is not finite: every run is invalid input
+} vm_program_t;
+
+// ==========================================
+// MARK: - Function Prototypes
+// ==========================================
+
+/**
+ * @brief Compile a parsed expression
+ * @details Deduplicates literals and inputs into registers and allocates
+ *          temporaries as a stack, so registers are reused as soon as an
+ *          intermediate value has been consumed. Compiler scratch is
+ *          released back to the arena before returning.
+ * @param expr Expression produced by expr_parse()
+ * @param arena Arena that receives the code
+ * @param program Program to fill in
+ * @return VM_SUCCESS on success, VM_ERROR_TOO_COMPLEX if the expression
+ *         needs more than VM_MAX_REGISTERS registers, VM_ERROR_MEMORY if
+ *         the arena is exhausted
+ */
+CALC_API vm_result_t vm_compile(const expr_t *expr, arena_t *arena, vm_program_t *program);
+
+/**
+ * @brief Run a program for one row of inputs
+ * @param program Compiled program
+ * @param inputs Input values, inputs[N - 1] for colN
+ * @param input_count Number of input values, at least program->input_limit
+ * @param result Pointer to store the value
+ * @return CALC_SUCCESS on success, otherwise the same code expr_evaluate_inputs()
+ *         returns for the expression
+ */
+CALC_API calc_result_t vm_execute(const vm_program_t *program, const double *inputs,
+                                  size_t input_count, double *result);
+
+/**
+ * @brief Run a program over columns of inputs
+ * @details Computes out[r] for rows [0, rows), reading colN from
+ *          columns[N - 1][r], and reports per-row status through the batch
+ *          error channel. Large inputs are split into row ranges that
+ *          run on the thread pool.
+ * @param program Compiled program
+ * @param columns Input columns; entries the program does not read may be NULL
+ * @param column_count Number of entries in columns, at least program->input_limit
+ * @param out Result array (may alias an input column)
+ * @param rows Number of rows
+ * @param errors Per-row error channel, or NULL if not needed
+ * @return CALC_SUCCESS if every row succeeded, otherwise the error code of
+ *         the first failing row
+ */
+CALC_API calc_result_t vm_execute_columns(const vm_program_t *program, const double *const *columns,
+                                          size_t column_count, double *out, size_t rows,
+                                          calc_batch_errors_t *errors);
+
+#endif /* VM_H */
@@ -0,0 +1,179 @@
+// ==========================================
+// FILE: arena.c
+// ==========================================
+/**
+ * @file arena.c
+ * @brief Arena subsystem implementation
+ * @details Implements the bump allocator. Blocks are kept across resets and
+ *          releases and reused in chain order; a block's fill level is
+ *          cleared when allocation moves into it, so releasing a scope is
+ *          O(1) no matter how many blocks it touched.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// ==========================================
+// MARK: - Arena Types
+// ==========================================
+
+struct arena_block {
+    arena_block_t *next;        ///< Next block in the chain
+    size_t capacity;            ///< Bytes available in data
+    size_t offset;              ///< Bytes handed out from data
+    max_align_t data[];         ///< Storage, aligned for any type
+};
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static size_t arena_round_up(size_t size) {
+    return (size + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/** Create a block of at least size bytes and link it in after the current block */
+static arena_block_t *arena_add_block(arena_t *arena, size_t size) {
+    size_t capacity = (size > arena->block_size) ? size : arena->block_size;
+    size_t total = sizeof(arena_block_t) + capacity;
+
+    if (arena->limit != 0 && arena->reserved + total > arena->limit) {
+        return NULL;
+    }
+
+    arena_block_t *block = malloc(total);
+    if (block == NULL) {
+        return NULL;
+    }
+    block->capacity = capacity;
+    block->offset = 0;
+
+    if (arena->current == NULL) {
+        block->next = arena->first;
+        arena->first = block;
+    } else {
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+    arena->reserved += total;
+    return block;
+}
+
+// ==========================================
+// MARK: - Arena Lifecycle
+// ==========================================
+
+void arena_init(arena_t *arena, size_t block_size, size_t limit) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = arena_round_up(block_size != 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE);
+    arena->limit = limit;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->reserved = 0;
+}
+
+void arena_destroy(arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena_block_t *block = arena->first;
+    while (block != NULL) {
+        arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->used = 0;
+    arena->reserved = 0;
+}
+
+// ==========================================
+// MARK: - Allocation
+// ==========================================
+
+void *arena_alloc(arena_t *arena, size_t size) {
+    if (arena == NULL || size > SIZE_MAX - ARENA_ALIGNMENT) {
+        return NULL;
+    }
+
+    size_t needed = arena_round_up(size != 0 ? size : 1);
+    arena_block_t *block = arena->current;
+
+    if (block == NULL || block->capacity - block->offset < needed) {
+        // Move on to the next kept block that fits, or make a new one
+        block = (block == NULL) ? arena->first : block->next;
+        while (block != NULL && block->capacity < needed) {
+            block = block->next;
+        }
+        if (block == NULL) {
+            block = arena_add_block(arena, needed);
+            if (block == NULL) {
+                return NULL;
+            }
+        }
+        block->offset = 0;
+        arena->current = block;
+    }
+
+    void *memory = (char *)block->data + block->offset;
+    block->offset += needed;
+    arena->used += needed;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return memory;
+}
+
+// ==========================================
+// MARK: - Scopes
+// ==========================================
+
+void arena_reset(arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+    arena->current = NULL;
+    arena->used = 0;
+}
+
+arena_mark_t arena_mark(const arena_t *arena) {
+    arena_mark_t mark = { NULL, 0, 0 };
+    if (arena != NULL) {
+        mark.block = arena->current;
+        mark.offset = (arena->current != NULL) ? arena->current->offset : 0;
+        mark.used = arena->used;
+    }
+    return mark;
+}
+
+void arena_release(arena_t *arena, arena_mark_t mark) {
+    if (arena == NULL) {
+        return;
+    }
+    arena->current = mark.block;
+    if (mark.block != NULL) {
+        mark.block->offset = mark.offset;
+    }
+    arena->used = mark.used;
+}
+
+arena_stats_t arena_stats(const arena_t *arena) {
+    arena_stats_t stats = { 0, 0, 0 };
+    if (arena != NULL) {
+        stats.used = arena->used;
+        stats.peak = arena->peak;
+        stats.reserved = arena->reserved;
+    }
+    return stats;
+}
@@ -0,0 +1,408 @@
+// ==========================================
+// FILE: batch_mode.c
+// ==========================================
+/**
+ * @file batch_mode.c
+ * @brief Batch mode implementation
+ * @details Implements the headless front end: streams operation lines from a
+ *          file through the calculator engine without banners, menus or
+ *          pauses. Input is read through a 1 MiB parser window and parsed in
+ *          place; results are written in shortest round-trip form through a
+ *          1 MiB output buffer that is flushed with single write() calls.
+ *          Regular files skip the window: they are mapped, cut into
+ *          line-aligned chunks and evaluated on the thread pool, each chunk
+ *          formatting into its own result buffer.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "batch_mode.h"
+#include "arena.h"
+#include "output.h"
+#include "parser.h"
+#include "format.h"
+#include "pool.h"
+#include "calculator_inline.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/** Longest result line: "error: " plus a result name, or a formatted double */
+#define BATCH_RESULT_MAX_LENGTH 64
+
+/** Output buffer size of a mapped run; chunk results larger than this bypass it */
+#define BATCH_MAPPED_OUTPUT_SIZE (64 * 1024)
+
+// ==========================================
+// MARK: - Batch Types
+// ==========================================
+
+/** Formatted results of one chunk of a mapped file */
+typedef struct {
+    char *data;                 ///< Result lines, malloc'ed and kept across spans
+    size_t length;              ///< Bytes of result lines
+    size_t capacity;            ///< Size of data
+    size_t lines;               ///< Operation lines evaluated
+    size_t failed;              ///< Lines that produced an error
+    bool out_of_memory;         ///< data could not grow; the chunk is incomplete
+} batch_chunk_t;
+
+/** One span of a mapped run, shared by the pool threads */
+typedef struct {
+    const char *data;                           ///< Mapped file
+    size_t bounds[BATCH_MAPPED_CHUNKS + 1];     ///< Chunk k is bytes [bounds[k], bounds[k + 1])
+    batch_chunk_t *chunks;
+} batch_span_t;
+
+// ==========================================
+// MARK: - Operation Table
+// ==========================================
+
+/** Accepted spellings for each operation */
+static const struct {
+    const char *name;
+    batch_op_t op;
+} batch_op_names[] = {
+    { "add", BATCH_OP_ADD },      { "+", BATCH_OP_ADD },
+    { "sub", BATCH_OP_SUBTRACT }, { "subtract", BATCH_OP_SUBTRACT }, { "-", BATCH_OP_SUBTRACT },
+    { "mul", BATCH_OP_MULTIPLY }, { "multiply", BATCH_OP_MULTIPLY }, { "*", BATCH_OP_MULTIPLY },
+    { "div", BATCH_OP_DIVIDE },   { "divide", BATCH_OP_DIVIDE },     { "/", BATCH_OP_DIVIDE },
+    { "mod", BATCH_OP_MODULUS },  { "modulus", BATCH_OP_MODULUS },   { "%", BATCH_OP_MODULUS },
+    { "pow", BATCH_OP_POWER },    { "power", BATCH_OP_POWER },       { "^", BATCH_OP_POWER }
+};
+
+// ==========================================
+// MARK: - Line Evaluation
+// ==========================================
+
+/**
+ * Classify and evaluate one line from a reader or span
+ * @return false for blank and comment lines, which produce no output
+ */
+static bool batch_evaluate_line(parser_result_t read_result, const char *line, size_t length,
+                                calc_result_t *status, double *value) {
+    batch_operation_t operation;
+    batch_line_t kind = BATCH_LINE_INVALID;
+
+    *status = CALC_ERROR_INVALID_INPUT;
+    if (read_result == PARSER_SUCCESS) {
+        kind = batch_mode_parse_line(line, length, &operation);
+    }
+    if (kind == BATCH_LINE_SKIP) {
+        return false;
+    }
+    if (kind == BATCH_LINE_OPERATION) {
+        *status = batch_mode_evaluate(operation.op, operation.a, operation.b, value);
+    }
+    return true;
+}
+
+/** Evaluate one chunk of a span into its result buffer */
+static void batch_evaluate_chunk(batch_span_t *span, size_t index) {
+    batch_chunk_t *chunk = &span->chunks[index];
+    parser_span_t lines;
+    parser_result_t read_result;
+    const char *line;
+    size_t length;
+
+    chunk->length = 0;
+    chunk->lines = 0;
+    chunk->failed = 0;
+    chunk->out_of_memory = false;
+    parser_span_init(&lines, span->data + span->bounds[index], span->data + span->bounds[index + 1],
+                     BATCH_IO_BUFFER_SIZE);
+
+    while ((read_result = parser_span_next_line(&lines, &line, &length)) != PARSER_ERROR_EOF) {
+        calc_result_t status;
+        double value;
+
+        if (!batch_evaluate_line(read_result, line, length, &status, &value)) {
+            continue;
+        }
+
+        if (chunk->capacity - chunk->length < BATCH_RESULT_MAX_LENGTH) {
+            size_t capacity = (chunk->capacity > 0) ? 2 * chunk->capacity : BATCH_MAPPED_CHUNK_SIZE / 2;
+            char *data = realloc(chunk->data, capacity);
+            if (data == NULL) {
+                chunk->out_of_memory = true;
+                return;
+            }
+            chunk->data = data;
+            chunk->capacity = capacity;
+        }
+
+        char *cursor = chunk->data + chunk->length;
+        chunk->lines++;
+        if (status == CALC_SUCCESS) {
+            cursor += format_double_shortest(value, cursor);
+        } else {
+            const char *name = calculator_result_name(status);
+            size_t name_length = strlen(name);
+            chunk->failed++;
+            memcpy(cursor, "error: ", 7);
+            memcpy(cursor + 7, name, name_length);
+            cursor += 7 + name_length;
+        }
+        *cursor++ = '\n';
+        chunk->length = (size_t)(cursor - chunk->data);
+    }
+}
+
+/** Pool body: evaluate chunks [first, last) of a span */
+static void batch_evaluate_chunks(void *context, size_t first, size_t last) {
+    for (size_t index = first; index < last; index++) {
+        batch_evaluate_chunk(context, index);
+    }
+}
+
+/**
+ * Cut the next span of a mapped file at line ends
+ * @return Offset one past the span
+ */
+static size_t batch_cut_span(batch_span_t *span, const parser_map_t *map, size_t offset) {
+    span->bounds[0] = offset;
+    for (size_t k = 1; k <= BATCH_MAPPED_CHUNKS; k++) {
+        size_t bound = span->bounds[k - 1];
+        if (map->size - bound > BATCH_MAPPED_CHUNK_SIZE) {
+            const char *target = map->data + bound + BATCH_MAPPED_CHUNK_SIZE;
+            const char *newline = memchr(target, '\n', (size_t)(map->data + map->size - target));
+            bound = (newline != NULL) ? (size_t)(newline - map->data) + 1 : map->size;
+        } else {
+            bound = map->size;
+        }
+        span->bounds[k] = bound;
+    }
+    return span->bounds[BATCH_MAPPED_CHUNKS];
+}
+
+// ==========================================
+// MARK: - Batch Execution
+// ==========================================
+
+batch_result_t batch_mode_run_file(const char *path, int output_fd,
+                                   const output_flush_policy_t *policy, batch_stats_t *stats) {
+    if (path == NULL || output_fd < 0) {
+        return BATCH_ERROR_INVALID_INPUT;
+    }
+
+    if (strcmp(path, BATCH_STDIN_PATH) == 0) {
+        return batch_mode_run(STDIN_FILENO, output_fd, policy, stats);
+    }
+
+    int input_fd = open(path, O_RDONLY);
+    if (input_fd < 0) {
+        return BATCH_ERROR_IO;
+    }
+
+    // Mapped runs write a span at a time, which a flush policy would not get
+    batch_result_t result;
+    if (policy == NULL || (policy->max_records == 0 && policy->max_delay_us == 0)) {
+        result = batch_mode_run_mapped(input_fd, output_fd, stats);
+    } else {
+        result = batch_mode_run(input_fd, output_fd, policy, stats);
+    }
+    close(input_fd);
+    return result;
+}
+
+batch_result_t batch_mode_run_mapped(int input_fd, int output_fd, batch_stats_t *stats) {
+    batch_stats_t counters = { 0, 0, 0 };
+    batch_result_t result = BATCH_SUCCESS;
+    batch_chunk_t chunks[BATCH_MAPPED_CHUNKS] = { { NULL, 0, 0, 0, 0, false } };
+    batch_span_t span;
+    parser_map_t map;
+    output_writer_t writer;
+    arena_t arena;
+
+    if (input_fd < 0 || output_fd < 0) {
+        return BATCH_ERROR_INVALID_INPUT;
+    }
+    if (parser_map_open(&map, input_fd) != PARSER_SUCCESS) {
+        return batch_mode_run(input_fd, output_fd, NULL, stats);
+    }
+
+    arena_init(&arena, BATCH_MAPPED_OUTPUT_SIZE, 0);
+    char *output_buffer = arena_alloc(&arena, BATCH_MAPPED_OUTPUT_SIZE);
+    if (output_buffer == NULL) {
+        arena_destroy(&arena);
+        parser_map_close(&map);
+        return BATCH_ERROR_MEMORY;
+    }
+    output_init(&writer, output_fd, output_buffer, BATCH_MAPPED_OUTPUT_SIZE);
+    span.data = map.data;
+    span.chunks = chunks;
+
+    for (size_t offset = 0; offset < map.size && result == BATCH_SUCCESS; ) {
+        size_t span_end = batch_cut_span(&span, &map, offset);
+        pool_parallel_for(BATCH_MAPPED_CHUNKS, 1, batch_evaluate_chunks, &span);
+
+        // Results leave in input order; chunk buffers larger than the
+        // writer's go out with one writev() and are never copied
+        for (size_t k = 0; k < BATCH_MAPPED_CHUNKS; k++) {
+            if (chunks[k].out_of_memory) {
+                result = BATCH_ERROR_MEMORY;
+                break;
+            }
+            counters.lines += chunks[k].lines;
+            counters.failed += chunks[k].failed;
+            if (output_write(&writer, chunks[k].data, chunks[k].length) != OUTPUT_SUCCESS) {
+                result = BATCH_ERROR_IO;
+                break;
+            }
+        }
+
+        parser_map_release(&map, span_end);
+        offset = span_end;
+    }
+
+    if (output_flush(&writer) != OUTPUT_SUCCESS && result == BATCH_SUCCESS) {
+        result = BATCH_ERROR_IO;
+    }
+    counters.arena_peak = arena_stats(&arena).peak;
+    arena_destroy(&arena);
+    for (size_t k = 0; k < BATCH_MAPPED_CHUNKS; k++) {
+        free(chunks[k].data);
+    }
+    parser_map_close(&map);
+
+    if (stats != NULL) {
+        *stats = counters;
+    }
+
+    return result;
+}
+
+batch_result_t batch_mode_run(int input_fd, int output_fd,
+                              const output_flush_policy_t *policy, batch_stats_t *stats) {
+    batch_stats_t counters = { 0, 0, 0 };
+    batch_result_t result = BATCH_SUCCESS;
+    parser_reader_t reader;
+    parser_result_t read_result;
+    const char *line;
+    size_t length;
+    output_writer_t writer;
+    arena_t arena;
+
+    if (input_fd < 0 || output_fd < 0) {
+        return BATCH_ERROR_INVALID_INPUT;
+    }
+
+    // Batch scope: the input window and the output buffer live for the run
+    arena_init(&arena, 2 * BATCH_IO_BUFFER_SIZE, 0);
+    char *window = arena_alloc(&arena, BATCH_IO_BUFFER_SIZE);
+    char *output_buffer = arena_alloc(&arena, BATCH_IO_BUFFER_SIZE);
+    if (window == NULL || output_buffer == NULL) {
+        arena_destroy(&arena);
+        return BATCH_ERROR_MEMORY;
+    }
+    parser_reader_init(&reader, input_fd, window, BATCH_IO_BUFFER_SIZE);
+    output_init(&writer, output_fd, output_buffer, BATCH_IO_BUFFER_SIZE);
+    output_set_policy(&writer, policy);
+
+    while ((read_result = parser_reader_next_line(&reader, &line, &length)) != PARSER_ERROR_EOF) {
+        calc_result_t calc_result;
+        double value;
+
+        if (read_result == PARSER_ERROR_IO) {
+            result = BATCH_ERROR_IO;
+            break;
+        }
+        if (!batch_evaluate_line(read_result, line, length, &calc_result, &value)) {
+            continue;
+        }
+
+        counters.lines++;
+        if (calc_result == CALC_SUCCESS) {
+            output_double(&writer, value);
+        } else {
+            counters.failed++;
+            output_puts(&writer, "error: ");
+            output_puts(&writer, calculator_result_name(calc_result));
+        }
+        output_write(&writer, "\n", 1);
+        if (output_end_record(&writer) != OUTPUT_SUCCESS) {
+            result = BATCH_ERROR_IO;
+            break;
+        }
+    }
+
+    if (output_flush(&writer) != OUTPUT_SUCCESS) {
+        result = BATCH_ERROR_IO;
+    }
+    counters.arena_peak = arena_stats(&arena).peak;
+    arena_destroy(&arena);
+
+    if (stats != NULL) {
+        *stats = counters;
+    }
+
+    return result;
+}
+
+batch_line_t batch_mode_parse_line(const char *line, size_t length, batch_operation_t *operation) {
+    const char *end = line + length;
+    const char *cursor;
+
+    if (line == NULL || operation == NULL) {
+        return BATCH_LINE_INVALID;
+    }
+
+    // Blank lines and comments
+    cursor = parser_skip_blanks(line, end);
+    if (cursor == end || *cursor == '#') {
+        return BATCH_LINE_SKIP;
+    }
+
+    // Operation name runs up to the next blank
+    const char *name = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t') {
+        cursor++;
+    }
+    operation->op = batch_mode_parse_op(name, (size_t)(cursor - name));
+
+    // Two operands and nothing but blanks after them
+    cursor = parser_parse_double(parser_skip_blanks(cursor, end), end, &operation->a);
+    if (cursor == NULL) {
+        return BATCH_LINE_INVALID;
+    }
+    cursor = parser_parse_double(parser_skip_blanks(cursor, end), end, &operation->b);
+    if (cursor == NULL || parser_skip_blanks(cursor, end) != end) {
+        return BATCH_LINE_INVALID;
+    }
+
+    return (operation->op == BATCH_OP_INVALID) ? BATCH_LINE_INVALID : BATCH_LINE_OPERATION;
+}
+
+// ==========================================
+// MARK: - Operation Helpers
+// ==========================================
+
+batch_op_t batch_mode_parse_op(const char *name, size_t length) {
+    if (name == NULL) {
+        return BATCH_OP_INVALID;
+    }
+
+    for (size_t i = 0; i < sizeof(batch_op_names) / sizeof(batch_op_names[0]); i++) {
+        if (strlen(batch_op_names[i].name) == length &&
+            memcmp(batch_op_names[i].name, name, length) == 0) {
+            return batch_op_names[i].op;
+        }
+    }
+
+    return BATCH_OP_INVALID;
+}
+
+calc_result_t batch_mode_evaluate(batch_op_t op, double a, double b, double *result) {
+    switch (op) {
+        case BATCH_OP_ADD:      return calculator_inline_add(a, b, result);
+        case BATCH_OP_SUBTRACT: return calculator_inline_subtract(a, b, result);
+        case BATCH_OP_MULTIPLY: return calculator_inline_multiply(a, b, result);
+        case BATCH_OP_DIVIDE:   return calculator_inline_divide(a, b, result);
+        case BATCH_OP_POWER:    return calculator_inline_power(a, b, result);
+        case BATCH_OP_MODULUS:  return calculator_inline_modulus_truncated(a, b, result);
+        default:
+            return CALC_ERROR_INVALID_INPUT;
+    }
+}
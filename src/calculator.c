@@ -14,9 +14,32 @@
  */
 
 #include "calculator.h"
+#include "calculator_inline.h"
+#include "calculator_dispatch.h"
 #include <stdio.h>
 #include <float.h>
 #include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==========================================
+// MARK: - Error Mode
+// ==========================================
+
+/** Active error mode */
+static calc_error_mode_t calculator_error_mode = CALC_ERROR_MODE_ERRNO;
+
+static const char *const calculator_error_mode_names[] = {
+    "errno", "fenv"
+};
+
+/** Active denormal mode */
+static calc_denormal_mode_t calculator_denormal_mode = CALC_DENORMAL_MODE_PRESERVE;
+
+static const char *const calculator_denormal_mode_names[] = {
+    "preserve", "flush"
+};
 
 // ==========================================
 // MARK: - Calculator Lifecycle
@@ -31,187 +54,164 @@ calc_result_t calculator_initialize(void) {
     // Reset errno for mathematical operations
     errno = 0;
     
-    return CALC_SUCCESS;
-}
-
-void calculator_cleanup(void) {
-    // Calculator engine is stateless, no cleanup required
-}
-
-// ==========================================
-// MARK: - Arithmetic Operations
-// ==========================================
-
-calc_result_t calculator_add(double a, double b, double *result) {
-    if (result == NULL) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Validate inputs
-    if (!calculator_is_valid_number(a) || !calculator_is_valid_number(b)) {
-        return CALC_ERROR_INVALID_INPUT;
+    // A forced mode must be honoured exactly, as CALC_CPU_LEVEL is
+    const char *mode = getenv(CALC_ERROR_MODE_ENV);
+    if (mode != NULL && mode[0] != '\0') {
+        if (strcmp(mode, calculator_error_mode_names[CALC_ERROR_MODE_ERRNO]) == 0) {
+            calculator_error_mode = CALC_ERROR_MODE_ERRNO;
+        } else if (strcmp(mode, calculator_error_mode_names[CALC_ERROR_MODE_FENV]) == 0) {
+            calculator_error_mode = CALC_ERROR_MODE_FENV;
+        } else {
+            return CALC_ERROR_INIT;
+        }
     }
     
-    // Perform subtraction
-    *result = a + b;
-    
-    // Check for overflow/underflow
-    if (calculator_is_overflow(*result)) {
-        return CALC_ERROR_OVERFLOW;
-    }
-    if (calculator_is_underflow(*result)) {
-        return CALC_ERROR_UNDERFLOW;
+    // Flushing is refused like an unknown mode where the CPU lacks MXCSR
+    const char *denormals = getenv(CALC_DENORMAL_MODE_ENV);
+    if (denormals != NULL && denormals[0] != '\0') {
+        if (strcmp(denormals, calculator_denormal_mode_names[CALC_DENORMAL_MODE_PRESERVE]) == 0) {
+            calculator_denormal_mode = CALC_DENORMAL_MODE_PRESERVE;
+        } else if (strcmp(denormals, calculator_denormal_mode_names[CALC_DENORMAL_MODE_FLUSH]) != 0 ||
+                   calculator_set_denormal_mode(CALC_DENORMAL_MODE_FLUSH) != CALC_SUCCESS) {
+            return CALC_ERROR_INIT;
+        }
     }
     
-    return CALC_SUCCESS;
+    // Select the batch kernels for this CPU (honours CALC_CPU_LEVEL)
+    return calculator_dispatch_initialize();
 }
 
-calc_result_t calculator_subtract(double a, double b, double *result) {
-    if (result == NULL) {
+calc_result_t calculator_set_error_mode(calc_error_mode_t mode) {
+    if (mode != CALC_ERROR_MODE_ERRNO && mode != CALC_ERROR_MODE_FENV) {
         return CALC_ERROR_INVALID_INPUT;
     }
-    
-    // Validate inputs
-    if (!calculator_is_valid_number(a) || !calculator_is_valid_number(b)) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Perform subtraction
-    *result = a - b;
-    
-    // Check for overflow/underflow
-    if (calculator_is_overflow(*result)) {
-        return CALC_ERROR_OVERFLOW;
-    }
-    if (calculator_is_underflow(*result)) {
-        return CALC_ERROR_UNDERFLOW;
-    }
-    
+    calculator_error_mode = mode;
     return CALC_SUCCESS;
 }
 
-calc_result_t calculator_multiply(double a, double b, double *result) {
-    if (result == NULL) {
-        return CALC_ERROR_INVALID_INPUT;
+calc_error_mode_t calculator_get_error_mode(void) {
+    return calculator_error_mode;
+}
+
+const char *calculator_error_mode_name(calc_error_mode_t mode) {
+    if (mode != CALC_ERROR_MODE_ERRNO && mode != CALC_ERROR_MODE_FENV) {
+        return "unknown";
     }
-    
-    // Validate inputs
-    if (!calculator_is_valid_number(a) || !calculator_is_valid_number(b)) {
+    return calculator_error_mode_names[mode];
+}
+
+calc_result_t calculator_set_denormal_mode(calc_denormal_mode_t mode) {
+    if (mode != CALC_DENORMAL_MODE_PRESERVE && mode != CALC_DENORMAL_MODE_FLUSH) {
         return CALC_ERROR_INVALID_INPUT;
     }
-    
-    // Perform multiplication
-    *result = a * b;
-    
-    // Check for overflow/underflow
-    if (calculator_is_overflow(*result)) {
-        return CALC_ERROR_OVERFLOW;
-    }
-    if (calculator_is_underflow(*result)) {
-        return CALC_ERROR_UNDERFLOW;
+    // DAZ and FTZ live in MXCSR, which comes with SSE2
+    if (mode == CALC_DENORMAL_MODE_FLUSH && calculator_dispatch_detect() < CALC_CPU_LEVEL_SSE2) {
+        return CALC_ERROR_INVALID_INPUT;
     }
-    
+    calculator_denormal_mode = mode;
     return CALC_SUCCESS;
 }
 
-calc_result_t calculator_divide(double a, double b, double *result) {
-    if (result == NULL) {
-        return CALC_ERROR_INVALID_INPUT;
+calc_denormal_mode_t calculator_get_denormal_mode(void) {
+    return calculator_denormal_mode;
+}
+
+const char *calculator_denormal_mode_name(calc_denormal_mode_t mode) {
+    if (mode != CALC_DENORMAL_MODE_PRESERVE && mode != CALC_DENORMAL_MODE_FLUSH) {
+        return "unknown";
     }
-    
-    // Validate inputs
-    if (!calculator_is_valid_number(a) || !calculator_is_valid_number(b)) {
-        return CALC_ERROR_INVALID_INPUT;
+    return calculator_denormal_mode_names[mode];
+}
+
+calc_result_t calculator_fenv_result(int flags) {
+    if (flags & FE_INVALID) {
+        return CALC_ERROR_DOMAIN;
     }
-    
-    // Check for division by zero
-    if (fabs(b) < CALC_PRECISION_EPSILON) {
+    if (flags & FE_DIVBYZERO) {
         return CALC_ERROR_DIVISION_BY_ZERO;
     }
-    
-    // Perform division
-    *result = a / b;
-    
-    // Check for overflow/underflow
-    if (calculator_is_overflow(*result)) {
+    if (flags & FE_OVERFLOW) {
         return CALC_ERROR_OVERFLOW;
     }
-    if (calculator_is_underflow(*result)) {
+    if (flags & FE_UNDERFLOW) {
         return CALC_ERROR_UNDERFLOW;
     }
-    
     return CALC_SUCCESS;
 }
 
+void calculator_cleanup(void) {
+    // Calculator engine is stateless, no cleanup required
+}
+
+// ==========================================
+// MARK: - Arithmetic Operations
+// ==========================================
+
+// The bodies live in calculator_inline.h so hot loops can inline them
+
+calc_result_t calculator_add(double a, double b, double *result) {
+    return calculator_inline_add(a, b, result);
+}
+
+calc_result_t calculator_subtract(double a, double b, double *result) {
+    return calculator_inline_subtract(a, b, result);
+}
+
+calc_result_t calculator_multiply(double a, double b, double *result) {
+    return calculator_inline_multiply(a, b, result);
+}
+
+calc_result_t calculator_divide(double a, double b, double *result) {
+    return calculator_inline_divide(a, b, result);
+}
+
+calc_result_t calculator_fma(double a, double b, double c, double *result) {
+    return calculator_inline_fma(a, b, c, result);
+}
+
+calc_result_t calculator_lerp(double a, double b, double t, double *result) {
+    return calculator_inline_lerp(a, b, t, result);
+}
+
 calc_result_t calculator_modulus(int a, int b, double *result) {
-    if (result == NULL) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Validate input ranges for integer operations
-    if (a > CALC_MAX_SAFE_INTEGER || a < CALC_MIN_SAFE_INTEGER ||
-        b > CALC_MAX_SAFE_INTEGER || b < CALC_MIN_SAFE_INTEGER) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Check for modulus by zero
-    if (b == 0) {
-        return CALC_ERROR_DIVISION_BY_ZERO;
-    }
-    
-    // Perform modulus operation
-    *result = (double)(a % b);
-    
-    return CALC_SUCCESS;
+    return calculator_inline_modulus(a, b, result);
 }
 
-calc_result_t calculator_power(double base, double exponent, double *result) {
-    if (result == NULL) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Validate inputs
-    if (!calculator_is_valid_number(base) || !calculator_is_valid_number(exponent)) {
-        return CALC_ERROR_INVALID_INPUT;
-    }
-    
-    // Handle special cases
-    if (base == 0.0 && exponent < 0.0) {
-        return CALC_ERROR_DIVISION_BY_ZERO;
-    }
-    
-    if (base < 0.0 && floor(exponent) != exponent) {
-        return CALC_ERROR_DOMAIN; // Negative base with non-integer exponent
+calc_result_t calculator_modulus_i64(int64_t a, int64_t b, int64_t *result) {
+    return calculator_inline_modulus_i64(a, b, result);
+}
+
+calc_result_t calculator_power_general(double base, double exponent, double *result) {
+    bool zero_is_exact = calculator_inline_is_zero(base);
+    base = calculator_inline_as_daz(base);
+
+    if (calculator_error_mode == CALC_ERROR_MODE_FENV) {
+        // Finite operands that passed the domain checks can only fail by
+        // leaving the normal range, which the value shows
+        *result = calculator_inline_as_daz(pow(base, exponent));
+        return calculator_inline_range(*result, zero_is_exact);
     }
     
     // Clear errno before math operation
     errno = 0;
     
     // Perform power operation
-    *result = pow(base, exponent);
+    *result = calculator_inline_as_daz(pow(base, exponent));
     
-    // Check for math errors
+    // Check for math errors; ERANGE is left to the value, which also
+    // shows exact subnormal results that do not set it
     if (errno == EDOM) {
         return CALC_ERROR_DOMAIN;
     }
-    if (errno == ERANGE) {
-        if (calculator_is_overflow(*result)) {
-            return CALC_ERROR_OVERFLOW;
-        }
-        if (calculator_is_underflow(*result)) {
-            return CALC_ERROR_UNDERFLOW;
-        }
-    }
-    
-    // Additional overflow/underflow checks
-    if (calculator_is_overflow(*result)) {
-        return CALC_ERROR_OVERFLOW;
-    }
-    if (calculator_is_underflow(*result)) {
-        return CALC_ERROR_UNDERFLOW;
-    }
-    
-    return CALC_SUCCESS;
+    return calculator_inline_range(*result, zero_is_exact);
+}
+
+calc_result_t calculator_power(double base, double exponent, double *result) {
+    return calculator_inline_power(base, exponent, result);
+}
+
+calc_result_t calculator_power_int(double base, int exponent, double *result) {
+    return calculator_inline_power_int(base, exponent, result);
 }
 
 // ==========================================
@@ -219,14 +219,30 @@ calc_result_t calculator_power(double base, double exponent, double *result) {
 // ==========================================
 
 bool calculator_is_valid_number(double value) {
-    return isfinite(value) && !isnan(value);
+    return calculator_inline_is_valid_number(value);
 }
 
 bool calculator_is_overflow(double value) {
-    return isinf(value) && value > 0.0;
+    return calculator_inline_is_overflow(value);
 }
 
 bool calculator_is_underflow(double value) {
-    return (value == 0.0 && !calculator_is_valid_number(value)) || 
-           (isinf(value) && value < 0.0);
+    return calculator_inline_is_underflow(value);
+}
+
+// ==========================================
+// MARK: - Utility Functions
+// ==========================================
+
+const char *calculator_result_name(calc_result_t result) {
+    switch (result) {
+        case CALC_SUCCESS:                return "success";
+        case CALC_ERROR_DIVISION_BY_ZERO: return "division_by_zero";
+        case CALC_ERROR_DOMAIN:           return "domain";
+        case CALC_ERROR_OVERFLOW:         return "overflow";
+        case CALC_ERROR_UNDERFLOW:        return "underflow";
+        case CALC_ERROR_INVALID_INPUT:    return "invalid_input";
+        case CALC_ERROR_INIT:             return "init";
+        default:                          return "unknown";
+    }
 }
\ No newline at end of file
@@ -0,0 +1,663 @@
+// ==========================================
+// FILE: calculator_batch.c
+// ==========================================
+/**
+ * @file calculator_batch.c
+ * @brief Calculator batch engine implementation
+ * @details Implements the array entry points on top of the kernel table
+ *          chosen by the dispatch layer. A kernel computes whole vectors and
+ *          validates every lane with one compare, then stops in front of the
+ *          first vector that contains a failure. That block is re-run through
+ *          the scalar operations, so each element reports exactly what the
+ *          scalar API would have reported. Large arrays are cut into
+ *          CALC_BATCH_PARALLEL_BLOCK-element blocks that run on the thread
+ *          pool; each block keeps its own summary and the summaries are
+ *          merged once the block is done. In CALC_DENORMAL_MODE_FLUSH every
+ *          block runs with DAZ and FTZ set in the MXCSR of its thread.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_batch.h"
+#include "calculator_dispatch.h"
+#include "calculator_inline.h"
+#include "pool.h"
+#include <pthread.h>
+#include <string.h>
+
+#ifdef CALC_KERNELS_X86
+#include <immintrin.h>
+
+/** MXCSR control bits of CALC_DENORMAL_MODE_FLUSH */
+#define BATCH_MXCSR_FLUSH (_MM_DENORMALS_ZERO_MASK | _MM_FLUSH_ZERO_MASK)
+#endif
+
+// ==========================================
+// MARK: - Batch Types
+// ==========================================
+
+/** Scalar operation used for failing blocks and tails */
+typedef calc_result_t (*batch_scalar_op_t)(double a, double b, double *result);
+
+/** Operands of one call, shared by all of its ranges */
+typedef struct {
+    calc_kernel_fn_t kernel;
+    batch_scalar_op_t scalar;
+    const double *a;
+    const double *b;
+    double *out;
+    const calc_divisor_f64_t *divisor;  ///< Prepared divide only
+    double alpha;                       ///< Axpy only
+    const int *ia;                      ///< Integer modulus only
+    const int *ib;
+    const int64_t *la;                  ///< 64-bit modulus only
+    const calc_divisor_i64_t *divisor_i64;
+    int64_t *lout;
+} batch_operands_t;
+
+/** One calculator_batch_parallel() call, shared by the pool threads */
+typedef struct {
+    calc_batch_range_fn_t fn;
+    void *context;
+    size_t n;
+    calc_batch_errors_t *errors;
+    bool flush;                         ///< Run blocks with DAZ and FTZ set
+    pthread_mutex_t lock;               ///< Guards the merge below
+    calc_result_t first_error;          ///< Code of the lowest failing block
+    size_t first_block;
+} batch_parallel_t;
+
+// ==========================================
+// MARK: - Error Channel
+// ==========================================
+
+void calculator_batch_errors_reset(calc_batch_errors_t *errors, size_t n) {
+    if (errors == NULL) {
+        return;
+    }
+
+    if (errors->codes != NULL) {
+        memset(errors->codes, CALC_SUCCESS, n);
+    }
+    if (errors->mask != NULL) {
+        memset(errors->mask, 0, CALC_BATCH_MASK_WORDS(n) * sizeof(uint64_t));
+    }
+    memset(&errors->summary, 0, sizeof(errors->summary));
+}
+
+calc_result_t calculator_batch_errors_record(calc_batch_errors_t *errors, size_t index,
+                                             calc_result_t code) {
+    // Under FTZ an underflow is the zero the caller chose over a failure
+    if (code == CALC_ERROR_UNDERFLOW && calculator_batch_flushing()) {
+        if (errors != NULL) {
+            errors->summary.flushed++;
+        }
+        return CALC_SUCCESS;
+    }
+    if (errors == NULL) {
+        return code;
+    }
+
+    if (errors->codes != NULL) {
+        errors->codes[index] = (uint8_t)code;
+    }
+    if (errors->mask != NULL) {
+        errors->mask[index / 64] |= (uint64_t)1 << (index % 64);
+    }
+    errors->summary.failed++;
+    errors->summary.counts[code]++;
+    return code;
+}
+
+// ==========================================
+// MARK: - Denormal Mode
+// ==========================================
+
+#ifdef CALC_KERNELS_X86
+
+/** Set DAZ and FTZ; returns the MXCSR they were set in */
+__attribute__((target("sse2")))
+static unsigned int batch_flush_begin(void) {
+    unsigned int saved = _mm_getcsr();
+    _mm_setcsr(saved | BATCH_MXCSR_FLUSH);
+    return saved;
+}
+
+/** Put back the saved DAZ and FTZ bits, keeping the flags raised meanwhile */
+__attribute__((target("sse2")))
+static void batch_flush_end(unsigned int saved) {
+    _mm_setcsr((_mm_getcsr() & ~BATCH_MXCSR_FLUSH) | (saved & BATCH_MXCSR_FLUSH));
+}
+
+__attribute__((target("sse2")))
+static bool batch_ftz_set(void) {
+    return (_mm_getcsr() & _MM_FLUSH_ZERO_MASK) != 0;
+}
+
+#endif /* CALC_KERNELS_X86 */
+
+bool calculator_batch_flushing(void) {
+#ifdef CALC_KERNELS_X86
+    // The mode is only set where the CPU has MXCSR
+    return calculator_get_denormal_mode() == CALC_DENORMAL_MODE_FLUSH && batch_ftz_set();
+#else
+    return false;
+#endif
+}
+
+/** Run fn over [begin, end), with DAZ and FTZ set if flush is true */
+static calc_result_t batch_run_range(calc_batch_range_fn_t fn, void *context, size_t begin, size_t end,
+                                     calc_batch_errors_t *errors, bool flush) {
+#ifdef CALC_KERNELS_X86
+    if (flush) {
+        unsigned int saved = batch_flush_begin();
+        calc_result_t result = fn(context, begin, end, errors);
+        batch_flush_end(saved);
+        return result;
+    }
+#else
+    (void)flush;
+#endif
+    return fn(context, begin, end, errors);
+}
+
+// ==========================================
+// MARK: - Parallel Driver
+// ==========================================
+
+/** Pool body: run the blocks of one range, each with its own summary */
+static void batch_parallel_blocks(void *context, size_t first, size_t last) {
+    batch_parallel_t *job = context;
+
+    for (size_t block = first; block < last; block++) {
+        size_t begin = block * CALC_BATCH_PARALLEL_BLOCK;
+        size_t end = (job->n - begin < CALC_BATCH_PARALLEL_BLOCK) ? job->n : begin + CALC_BATCH_PARALLEL_BLOCK;
+        calc_batch_errors_t local = { NULL, NULL, { 0, { 0 }, 0 } };
+        if (job->errors != NULL) {
+            local.codes = job->errors->codes;
+            local.mask = job->errors->mask;
+        }
+
+        calc_result_t result = batch_run_range(job->fn, job->context, begin, end, &local, job->flush);
+        if (result == CALC_SUCCESS && local.summary.failed == 0 && local.summary.flushed == 0) {
+            continue;
+        }
+
+        pthread_mutex_lock(&job->lock);
+        if (job->errors != NULL) {
+            job->errors->summary.failed += local.summary.failed;
+            for (size_t code = 0; code < CALC_RESULT_COUNT; code++) {
+                job->errors->summary.counts[code] += local.summary.counts[code];
+            }
+            job->errors->summary.flushed += local.summary.flushed;
+        }
+        if (result != CALC_SUCCESS && block < job->first_block) {
+            job->first_block = block;
+            job->first_error = result;
+        }
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+calc_result_t calculator_batch_parallel(size_t n, calc_batch_range_fn_t fn, void *context,
+                                        calc_batch_errors_t *errors) {
+    bool flush = calculator_get_denormal_mode() == CALC_DENORMAL_MODE_FLUSH;
+
+    calculator_batch_errors_reset(errors, n);
+    if (n < CALC_BATCH_PARALLEL_MIN) {
+        return batch_run_range(fn, context, 0, n, errors, flush);
+    }
+
+    // Blocks are multiples of 64 elements, so no two threads share a mask word
+    batch_parallel_t job = { fn, context, n, errors, flush, PTHREAD_MUTEX_INITIALIZER, CALC_SUCCESS, SIZE_MAX };
+    pool_parallel_for((n + CALC_BATCH_PARALLEL_BLOCK - 1) / CALC_BATCH_PARALLEL_BLOCK, 1,
+                      batch_parallel_blocks, &job);
+    pthread_mutex_destroy(&job.lock);
+    return job.first_error;
+}
+
+// ==========================================
+// MARK: - Batch Driver
+// ==========================================
+
+/**
+ * @brief Run a kernel over elements [begin, end), falling back to the scalar operation
+ * @details The kernel runs until it reaches a failing vector or the tail;
+ *          the next CALC_BATCH_BLOCK elements then go through the scalar
+ *          operation, which classifies each failing element.
+ */
+static calc_result_t batch_binary_range(void *context, size_t begin, size_t end,
+                                        calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    const double *a = op->a;
+    const double *b = op->b;
+    double *out = op->out;
+    calc_result_t first_error = CALC_SUCCESS;
+    size_t i = begin;
+
+    while (i < end) {
+        i += op->kernel(a + i, b + i, out + i, end - i);
+
+        size_t block_end = (end - i < CALC_BATCH_BLOCK) ? end : i + CALC_BATCH_BLOCK;
+        for (; i < block_end; i++) {
+            calc_result_t element_result = op->scalar(a[i], b[i], &out[i]);
+            if (element_result != CALC_SUCCESS) {
+                element_result = calculator_batch_errors_record(errors, i, element_result);
+                if (first_error == CALC_SUCCESS) {
+                    first_error = element_result;
+                }
+            }
+        }
+    }
+
+    return first_error;
+}
+
+static calc_result_t batch_run(calc_kernel_fn_t kernel, batch_scalar_op_t scalar,
+                               const double *a, const double *b, double *out,
+                               size_t n, calc_batch_errors_t *errors) {
+    if (n > 0 && (a == NULL || b == NULL || out == NULL)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .kernel = kernel, .scalar = scalar, .a = a, .b = b, .out = out };
+    return calculator_batch_parallel(n, batch_binary_range, &op, errors);
+}
+
+// ==========================================
+// MARK: - Batch Operations
+// ==========================================
+
+calc_result_t calculator_add_batch(const double *a, const double *b, double *out,
+                                   size_t n, calc_batch_errors_t *errors) {
+    return batch_run(calculator_dispatch_kernels()->add, calculator_add, a, b, out, n, errors);
+}
+
+calc_result_t calculator_subtract_batch(const double *a, const double *b, double *out,
+                                        size_t n, calc_batch_errors_t *errors) {
+    return batch_run(calculator_dispatch_kernels()->subtract, calculator_subtract, a, b, out, n, errors);
+}
+
+calc_result_t calculator_multiply_batch(const double *a, const double *b, double *out,
+                                        size_t n, calc_batch_errors_t *errors) {
+    return batch_run(calculator_dispatch_kernels()->multiply, calculator_multiply, a, b, out, n, errors);
+}
+
+calc_result_t calculator_divide_batch(const double *a, const double *b, double *out,
+                                      size_t n, calc_batch_errors_t *errors) {
+    return batch_run(calculator_dispatch_kernels()->divide, calculator_divide, a, b, out, n, errors);
+}
+
+/** Same loop as batch_binary_range(), with a = x and b = y */
+static calc_result_t batch_axpy_range(void *context, size_t begin, size_t end,
+                                      calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    calc_axpy_fn_t kernel = calculator_dispatch_kernels()->axpy;
+    calc_result_t first_error = CALC_SUCCESS;
+    size_t i = begin;
+
+    while (i < end) {
+        i += kernel(op->alpha, op->a + i, op->b + i, op->out + i, end - i);
+
+        size_t block_end = (end - i < CALC_BATCH_BLOCK) ? end : i + CALC_BATCH_BLOCK;
+        for (; i < block_end; i++) {
+            calc_result_t element_result = calculator_fma(op->alpha, op->a[i], op->b[i], &op->out[i]);
+            if (element_result != CALC_SUCCESS) {
+                element_result = calculator_batch_errors_record(errors, i, element_result);
+                if (first_error == CALC_SUCCESS) {
+                    first_error = element_result;
+                }
+            }
+        }
+    }
+
+    return first_error;
+}
+
+calc_result_t calculator_axpy(double alpha, const double *x, const double *y, double *out,
+                              size_t n, calc_batch_errors_t *errors) {
+    if (n > 0 && (x == NULL || y == NULL || out == NULL)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .a = x, .b = y, .out = out, .alpha = alpha };
+    return calculator_batch_parallel(n, batch_axpy_range, &op, errors);
+}
+
+calc_result_t calculator_divisor_f64_init(calc_divisor_f64_t *divisor, double d) {
+    if (divisor == NULL || !calculator_is_valid_number(d)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (fabs(d) < CALC_PRECISION_EPSILON) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+
+    divisor->divisor = d;
+    divisor->reciprocal = 1.0 / d;
+    if (fabs(d) > 0x1p1021) {
+        // The reciprocal is too close to the subnormal range to be exact
+        divisor->dividend_min = INFINITY;
+        divisor->dividend_max = 0.0;
+    } else {
+        // Keep |a| and |a / d| within [2^-969, 2^1021]: the residual stays
+        // normal and no intermediate can overflow
+        divisor->dividend_min = 0x1p-969 * fmax(1.0, fabs(d));
+        divisor->dividend_max = 0x1p1021 * fmin(1.0, fabs(d));
+    }
+    return CALC_SUCCESS;
+}
+
+calc_result_t calculator_divide_prepared(double a, const calc_divisor_f64_t *divisor, double *result) {
+    if (result == NULL || divisor == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (!calculator_is_valid_number(a)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    *result = a / divisor->divisor;
+    return calculator_inline_range(*result, calculator_inline_is_zero(a));
+}
+
+/** Same loop as batch_binary_range(), with the divisor fixed */
+static calc_result_t batch_divide_prepared_range(void *context, size_t begin, size_t end,
+                                                 calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    calc_divide_prepared_fn_t kernel = calculator_dispatch_kernels()->divide_prepared;
+    calc_result_t first_error = CALC_SUCCESS;
+    size_t i = begin;
+
+    while (i < end) {
+        i += kernel(op->a + i, op->divisor, op->out + i, end - i);
+
+        size_t block_end = (end - i < CALC_BATCH_BLOCK) ? end : i + CALC_BATCH_BLOCK;
+        for (; i < block_end; i++) {
+            calc_result_t element_result = calculator_divide_prepared(op->a[i], op->divisor, &op->out[i]);
+            if (element_result != CALC_SUCCESS) {
+                element_result = calculator_batch_errors_record(errors, i, element_result);
+                if (first_error == CALC_SUCCESS) {
+                    first_error = element_result;
+                }
+            }
+        }
+    }
+
+    return first_error;
+}
+
+calc_result_t calculator_divide_prepared_batch(const double *a, const calc_divisor_f64_t *divisor,
+                                               double *out, size_t n, calc_batch_errors_t *errors) {
+    if (divisor == NULL || (n > 0 && (a == NULL || out == NULL))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .a = a, .out = out, .divisor = divisor };
+    return calculator_batch_parallel(n, batch_divide_prepared_range, &op, errors);
+}
+
+static calc_result_t batch_modulus_range(void *context, size_t begin, size_t end,
+                                         calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    calc_result_t first_error = CALC_SUCCESS;
+
+    // No SIMD integer division exists, so modulus stays element-wise
+    for (size_t i = begin; i < end; i++) {
+        calc_result_t element_result = calculator_inline_modulus(op->ia[i], op->ib[i], &op->out[i]);
+        if (element_result != CALC_SUCCESS) {
+            calculator_batch_errors_record(errors, i, element_result);
+            if (first_error == CALC_SUCCESS) {
+                first_error = element_result;
+            }
+        }
+    }
+
+    return first_error;
+}
+
+calc_result_t calculator_modulus_batch(const int *a, const int *b, double *out,
+                                       size_t n, calc_batch_errors_t *errors) {
+    if (n > 0 && (a == NULL || b == NULL || out == NULL)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .ia = a, .ib = b, .out = out };
+    return calculator_batch_parallel(n, batch_modulus_range, &op, errors);
+}
+
+/** High 64 bits of a * b */
+static inline uint64_t batch_mulhi_u64(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 batch_u128_t;
+    return (uint64_t)(((batch_u128_t)a * b) >> 64);
+#else
+    uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    uint64_t cross = (a_lo * b_lo >> 32) + (a_hi * b_lo & 0xFFFFFFFFu) + a_lo * b_hi;
+    return a_hi * b_hi + (a_hi * b_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/** (high * 2^64 + low) / d for high < d, by shift and subtract; only run while preparing */
+static uint64_t batch_divide_u128(uint64_t high, uint64_t low, uint64_t d, uint64_t *remainder) {
+    uint64_t quotient = 0;
+    for (int bit = 0; bit < 64; bit++) {
+        uint64_t carry = high >> 63;
+        high = (high << 1) | (low >> 63);
+        low <<= 1;
+        quotient <<= 1;
+        if (carry != 0 || high >= d) {
+            high -= d;
+            quotient |= 1;
+        }
+    }
+    *remainder = high;
+    return quotient;
+}
+
+/** n / |d| for a prepared divisor */
+static inline uint64_t batch_divide_prepared(uint64_t n, const calc_divisor_i64_t *divisor) {
+    uint64_t q = batch_mulhi_u64(divisor->magic, n);
+    if (divisor->add) {
+        q += (n - q) >> 1;
+    }
+    return q >> divisor->shift;
+}
+
+calc_result_t calculator_divisor_i64_init(calc_divisor_i64_t *divisor, int64_t d) {
+    if (divisor == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (d == 0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+
+    uint64_t magnitude = (d < 0) ? 0 - (uint64_t)d : (uint64_t)d;
+    int log2_d = 63;
+    while ((magnitude >> log2_d) == 0) {
+        log2_d--;
+    }
+
+    divisor->divisor = magnitude;
+    divisor->magic = 0;
+    divisor->shift = (uint8_t)log2_d;
+    divisor->add = false;
+    if ((magnitude & (magnitude - 1)) == 0) {
+        return CALC_SUCCESS;
+    }
+
+    // m = floor(2^(64 + l) / |d|) + 1 is exact for every n when its error
+    // e = |d| - 2^(64 + l) mod |d| is below 2^l; otherwise take one more bit
+    // of precision and apply the 65th bit through the add-and-halve fixup
+    uint64_t remainder;
+    uint64_t magic = batch_divide_u128((uint64_t)1 << log2_d, 0, magnitude, &remainder);
+    if (magnitude - remainder >= (uint64_t)1 << log2_d) {
+        uint64_t twice_remainder = remainder + remainder;
+        magic += magic;
+        if (twice_remainder >= magnitude || twice_remainder < remainder) {
+            magic++;
+        }
+        divisor->add = true;
+    }
+    divisor->magic = magic + 1;
+    return CALC_SUCCESS;
+}
+
+static calc_result_t batch_modulus_i64_range(void *context, size_t begin, size_t end,
+                                             calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    const calc_divisor_i64_t *divisor = op->divisor_i64;
+    const int64_t *a = op->la;
+    int64_t *out = op->lout;
+    (void)errors;
+
+    // Work on |a| and give the remainder a's sign, as % truncates toward
+    // zero; |INT64_MIN| still fits in uint64_t
+    uint64_t d = divisor->divisor;
+    if (divisor->magic == 0) {
+        uint64_t mask = d - 1;
+        for (size_t i = begin; i < end; i++) {
+            uint64_t sign = 0 - (uint64_t)(a[i] < 0);
+            uint64_t remainder = (((uint64_t)a[i] ^ sign) - sign) & mask;
+            out[i] = (int64_t)((remainder ^ sign) - sign);
+        }
+        return CALC_SUCCESS;
+    }
+
+    for (size_t i = begin; i < end; i++) {
+        uint64_t sign = 0 - (uint64_t)(a[i] < 0);
+        uint64_t magnitude = ((uint64_t)a[i] ^ sign) - sign;
+        uint64_t remainder = magnitude - batch_divide_prepared(magnitude, divisor) * d;
+        out[i] = (int64_t)((remainder ^ sign) - sign);
+    }
+    return CALC_SUCCESS;
+}
+
+calc_result_t calculator_modulus_i64_batch(const int64_t *a, const calc_divisor_i64_t *divisor,
+                                           int64_t *out, size_t n) {
+    if (divisor == NULL || (n > 0 && (a == NULL || out == NULL))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .la = a, .divisor_i64 = divisor, .lout = out };
+    return calculator_batch_parallel(n, batch_modulus_i64_range, &op, NULL);
+}
+
+/**
+ * calculator_power() over one block with the flags checked once, for
+ * CALC_ERROR_MODE_FENV. Domain and operand errors are known before pow()
+ * runs; pow() results are only inspected if the block raised an error flag
+ * or produced a zero or subnormal, as libm builds exact subnormal results
+ * without raising FE_UNDERFLOW. Results go to a scratch block first because
+ * out may alias the operands; it starts from out, so a failing element keeps
+ * whatever calculator_power() leaves in its result. The caller's sticky
+ * flags are saved around the block and restored after it.
+ * @return Error code of the block's first failing element, or CALC_SUCCESS
+ */
+static calc_result_t batch_power_fenv_block(const double *base, const double *exponent,
+                                            double *out, size_t n, size_t offset,
+                                            calc_batch_errors_t *errors) {
+    double values[CALC_BATCH_FENV_BLOCK];
+    bool settled[CALC_BATCH_FENV_BLOCK];
+    calc_result_t first_error = CALC_SUCCESS;
+    size_t first_index = n;
+    bool tiny = false;
+    fexcept_t saved;
+
+    fegetexceptflag(&saved, CALC_FENV_FLAGS);
+    feclearexcept(CALC_FENV_FLAGS);
+    for (size_t i = 0; i < n; i++) {
+        double b = base[i];
+        double e = exponent[i];
+        calc_result_t code = CALC_SUCCESS;
+        values[i] = out[i];
+        settled[i] = true;
+        if (!calculator_inline_is_valid_number(b) || !calculator_inline_is_valid_number(e)) {
+            code = CALC_ERROR_INVALID_INPUT;
+        } else if (fabs(e) <= CALC_POWER_INTEGER_MAX && e == (double)(int)e) {
+            // Same route calculator_power() takes, so results stay bit-identical
+            code = calculator_inline_power_int(b, (int)e, &values[i]);
+        } else if (b == 0.0 && e < 0.0) {
+            code = CALC_ERROR_DIVISION_BY_ZERO;
+        } else if (b < 0.0 && floor(e) != e) {
+            code = CALC_ERROR_DOMAIN;
+        } else {
+            // As in calculator_power_general()
+            values[i] = calculator_inline_as_daz(pow(calculator_inline_as_daz(b), e));
+            tiny |= (calculator_inline_bits(values[i]) & CALC_F64_EXPONENT_MASK) == 0;
+            settled[i] = false;
+        }
+        if (code != CALC_SUCCESS) {
+            code = calculator_batch_errors_record(errors, offset + i, code);
+        }
+        if (code != CALC_SUCCESS) {
+            if (first_error == CALC_SUCCESS) {
+                first_error = code;
+                first_index = i;
+            }
+        }
+    }
+
+    if (tiny || calculator_fenv_result(fetestexcept(CALC_FENV_FLAGS)) != CALC_SUCCESS) {
+        for (size_t i = 0; i < n; i++) {
+            if (settled[i]) {
+                continue;
+            }
+            calc_result_t code = calculator_inline_range(values[i], calculator_inline_is_zero(base[i]));
+            if (code == CALC_SUCCESS) {
+                continue;
+            }
+            code = calculator_batch_errors_record(errors, offset + i, code);
+            if (code != CALC_SUCCESS && i < first_index) {
+                first_error = code;
+                first_index = i;
+            }
+        }
+    }
+
+    fesetexceptflag(&saved, CALC_FENV_FLAGS);
+    memcpy(out, values, n * sizeof(double));
+    return first_error;
+}
+
+/** Power over [begin, end); fenv blocks start at begin, which is a multiple of the block size */
+static calc_result_t batch_power_range(void *context, size_t begin, size_t end,
+                                       calc_batch_errors_t *errors) {
+    const batch_operands_t *op = context;
+    calc_result_t first_error = CALC_SUCCESS;
+
+    if (calculator_get_error_mode() == CALC_ERROR_MODE_FENV) {
+        for (size_t start = begin; start < end; start += CALC_BATCH_FENV_BLOCK) {
+            size_t count = (end - start < CALC_BATCH_FENV_BLOCK) ? end - start : CALC_BATCH_FENV_BLOCK;
+            calc_result_t block_result = batch_power_fenv_block(op->a + start, op->b + start,
+                                                                op->out + start, count, start, errors);
+            if (first_error == CALC_SUCCESS) {
+                first_error = block_result;
+            }
+        }
+        return first_error;
+    }
+
+    // pow() has no vector form in libm, so power stays element-wise
+    for (size_t i = begin; i < end; i++) {
+        calc_result_t element_result = calculator_inline_power(op->a[i], op->b[i], &op->out[i]);
+        if (element_result != CALC_SUCCESS) {
+            element_result = calculator_batch_errors_record(errors, i, element_result);
+            if (first_error == CALC_SUCCESS) {
+                first_error = element_result;
+            }
+        }
+    }
+
+    return first_error;
+}
+
+calc_result_t calculator_power_batch(const double *base, const double *exponent, double *out,
+                                     size_t n, calc_batch_errors_t *errors) {
+    if (n > 0 && (base == NULL || exponent == NULL || out == NULL)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    batch_operands_t op = { .a = base, .b = exponent, .out = out };
+    return calculator_batch_parallel(n, batch_power_range, &op, errors);
+}
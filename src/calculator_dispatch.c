@@ -0,0 +1,167 @@
+// ==========================================
+// FILE: calculator_dispatch.c
+// ==========================================
+/**
+ * @file calculator_dispatch.c
+ * @brief Calculator dispatch implementation
+ * @details Implements kernel level detection and selection. The active level
+ *          is an atomic rather than a GNU ifunc so that it can be overridden
+ *          from the environment and switched at runtime; pool workers read
+ *          it concurrently, and the first read selects it exactly once.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_dispatch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==========================================
+// MARK: - Dispatch State
+// ==========================================
+
+/** Level names, indexed by calc_cpu_level_t */
+static const char *const dispatch_level_names[] = {
+    "scalar", "sse2", "avx2", "avx512"
+};
+
+/** Number of kernel levels */
+#define DISPATCH_LEVEL_COUNT (sizeof(dispatch_level_names) / sizeof(dispatch_level_names[0]))
+
+/** dispatch_active_level before the first selection */
+#define DISPATCH_LEVEL_UNSET (-1)
+
+/** Active level, published with release and read with acquire */
+static atomic_int dispatch_active_level = DISPATCH_LEVEL_UNSET;
+
+/** Runs the lazy selection of a process that never called the initializer */
+static pthread_once_t dispatch_default_once = PTHREAD_ONCE_INIT;
+
+// ==========================================
+// MARK: - Internal Helpers
+// ==========================================
+
+static const calc_kernel_table_t *dispatch_table_for(calc_cpu_level_t level) {
+    switch (level) {
+#ifdef CALC_KERNELS_X86
+        case CALC_CPU_LEVEL_SSE2:   return &calc_kernels_sse2;
+        case CALC_CPU_LEVEL_AVX2:   return &calc_kernels_avx2;
+        case CALC_CPU_LEVEL_AVX512: return &calc_kernels_avx512;
+#endif
+        default:                    return &calc_kernels_scalar;
+    }
+}
+
+static void dispatch_activate(calc_cpu_level_t level) {
+    atomic_store_explicit(&dispatch_active_level, (int)level, memory_order_release);
+}
+
+/**
+ * Level CALC_CPU_LEVEL asks for, or the detected one
+ * @return CALC_SUCCESS, or CALC_ERROR_INIT if the variable names an unknown
+ *         or unsupported level (level is then the detected one)
+ */
+static calc_result_t dispatch_configured_level(calc_cpu_level_t *level) {
+    const char *forced = getenv(CALC_CPU_LEVEL_ENV);
+    calc_cpu_level_t detected = calculator_dispatch_detect();
+
+    *level = detected;
+    if (forced == NULL || forced[0] == '\0') {
+        return CALC_SUCCESS;
+    }
+
+    // A forced level must be honoured exactly, so a typo is an error rather
+    // than a silent fallback that would skew benchmarks
+    for (size_t candidate = 0; candidate < DISPATCH_LEVEL_COUNT; candidate++) {
+        if (strcmp(forced, dispatch_level_names[candidate]) == 0) {
+            if ((calc_cpu_level_t)candidate > detected) {
+                return CALC_ERROR_INIT;
+            }
+            *level = (calc_cpu_level_t)candidate;
+            return CALC_SUCCESS;
+        }
+    }
+
+    return CALC_ERROR_INIT;
+}
+
+/** pthread_once body: select the configured level unless a caller already chose one */
+static void dispatch_select_default(void) {
+    calc_cpu_level_t level;
+    int unset = DISPATCH_LEVEL_UNSET;
+
+    (void)dispatch_configured_level(&level);
+    atomic_compare_exchange_strong_explicit(&dispatch_active_level, &unset, (int)level,
+                                            memory_order_release, memory_order_relaxed);
+}
+
+/** Active level, selected on first use */
+static calc_cpu_level_t dispatch_current_level(void) {
+    int level = atomic_load_explicit(&dispatch_active_level, memory_order_acquire);
+    if (level == DISPATCH_LEVEL_UNSET) {
+        pthread_once(&dispatch_default_once, dispatch_select_default);
+        level = atomic_load_explicit(&dispatch_active_level, memory_order_acquire);
+    }
+    return (calc_cpu_level_t)level;
+}
+
+// ==========================================
+// MARK: - Dispatch Lifecycle
+// ==========================================
+
+calc_result_t calculator_dispatch_initialize(void) {
+    calc_cpu_level_t level;
+    calc_result_t result = dispatch_configured_level(&level);
+
+    dispatch_activate(level);
+    return result;
+}
+
+// ==========================================
+// MARK: - Level Selection
+// ==========================================
+
+calc_cpu_level_t calculator_dispatch_detect(void) {
+#ifdef CALC_KERNELS_X86
+    // cpuid plus the XGETBV check that the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        // The AVX-512 kernels are also compiled with -mavx2 -mfma
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+            return CALC_CPU_LEVEL_AVX512;
+        }
+        return CALC_CPU_LEVEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return CALC_CPU_LEVEL_SSE2;
+    }
+#endif
+    return CALC_CPU_LEVEL_SCALAR;
+}
+
+calc_cpu_level_t calculator_dispatch_level(void) {
+    return dispatch_current_level();
+}
+
+calc_result_t calculator_dispatch_set_level(calc_cpu_level_t level) {
+    if ((size_t)level >= DISPATCH_LEVEL_COUNT || level > calculator_dispatch_detect()) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    dispatch_activate(level);
+    return CALC_SUCCESS;
+}
+
+const char *calculator_dispatch_level_name(calc_cpu_level_t level) {
+    if ((size_t)level >= DISPATCH_LEVEL_COUNT) {
+        return "unknown";
+    }
+    return dispatch_level_names[level];
+}
+
+const calc_kernel_table_t *calculator_dispatch_kernels(void) {
+    return dispatch_table_for(dispatch_current_level());
+}
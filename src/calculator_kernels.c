@@ -0,0 +1,308 @@
+// ==========================================
+// FILE: calculator_kernels.c
+// ==========================================
+/**
+ * @file calculator_kernels.c
+ * @brief Calculator kernels - Scalar and SSE2 levels
+ * @details Implements the baseline kernel tables. The scalar kernels are
+ *          plain C and build everywhere; the SSE2 kernels are compiled with
+ *          a target attribute so they need no extra Makefile flags.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_kernels.h"
+#include "calculator_lanes.h"
+
+// ==========================================
+// MARK: - Scalar Kernels
+// ==========================================
+
+/*
+ * For add, subtract and multiply a non-finite operand always produces a
+ * non-finite result, so a finite result that passes the range check proves
+ * the whole element succeeded. Division additionally needs the divisor
+ * checked: x / inf is a finite zero.
+ */
+
+static size_t kernel_add_scalar(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = a[i] + b[i];
+        if (!calculator_inline_is_valid_number(r) ||
+            calculator_inline_range(r, calculator_inline_cancels(a[i], b[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+static size_t kernel_subtract_scalar(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = a[i] - b[i];
+        if (!calculator_inline_is_valid_number(r) ||
+            calculator_inline_range(r, calculator_inline_cancels(a[i], -b[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+static size_t kernel_multiply_scalar(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = a[i] * b[i];
+        if (!calculator_inline_is_valid_number(r) ||
+            calculator_inline_range(r, calculator_inline_is_zero(a[i]) | calculator_inline_is_zero(b[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+static size_t kernel_divide_scalar(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = a[i] / b[i];
+        if (!(fabs(b[i]) >= CALC_PRECISION_EPSILON) || !calculator_inline_are_valid(b[i], r) ||
+            calculator_inline_range(r, calculator_inline_is_zero(a[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+/* Without hardware FMA the correction step would cost more than the
+ * division it replaces, so the prepared kernels below only drop the
+ * per-element divisor check. */
+
+static size_t kernel_divide_prepared_scalar(const double *a, const calc_divisor_f64_t *divisor,
+                                            double *out, size_t n) {
+    double d = divisor->divisor;
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = a[i] / d;
+        if (!calculator_inline_is_valid_number(r) ||
+            calculator_inline_range(r, calculator_inline_is_zero(a[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+static size_t kernel_axpy_scalar(double alpha, const double *x, const double *y, double *out, size_t n) {
+    size_t i = 0;
+    for (; i < n; i++) {
+        double r = fma(alpha, x[i], y[i]);
+        if (!calculator_inline_is_valid_number(r) ||
+            calculator_inline_range(r, calculator_inline_is_zero(r) &&
+                                       calculator_inline_fma_cancels(alpha, x[i], y[i])) != CALC_SUCCESS) {
+            break;
+        }
+        out[i] = r;
+    }
+    return i;
+}
+
+/*
+ * Reduction steps, one lane at a time. Sum and dot use Knuth's branch-free
+ * TwoSum and the FMA product error, both exact, so value + compensation
+ * carries the rounding that plain accumulation would lose. fma() resolves
+ * to the hardware instruction where glibc finds one.
+ */
+
+static inline void reduce_sum_step(calc_reduce_lanes_t *lanes, size_t lane, double x) {
+    double s = lanes->value[lane];
+    double t = s + x;
+    double z = t - s;
+    lanes->compensation[lane] += (s - (t - z)) + (x - z);
+    lanes->value[lane] = t;
+}
+
+static inline void reduce_product_step(calc_reduce_lanes_t *lanes, size_t lane, double x) {
+    double p = lanes->value[lane];
+    double q = p * x;
+    lanes->compensation[lane] = lanes->compensation[lane] * x + fma(p, x, -q);
+    lanes->value[lane] = q;
+}
+
+static inline void reduce_dot_step(calc_reduce_lanes_t *lanes, size_t lane, double x, double y) {
+    double p = x * y;
+    double product_error = fma(x, y, -p);
+    double s = lanes->value[lane];
+    double t = s + p;
+    double z = t - s;
+    lanes->compensation[lane] += ((s - (t - z)) + (p - z)) + product_error;
+    lanes->value[lane] = t;
+}
+
+static void kernel_sum_scalar(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    (void)b;
+    for (size_t i = 0; i < n; i += CALC_REDUCE_LANES) {
+        for (size_t lane = 0; lane < CALC_REDUCE_LANES; lane++) {
+            reduce_sum_step(lanes, lane, (i + lane < n) ? a[i + lane] : 0.0);
+        }
+    }
+}
+
+static void kernel_product_scalar(const double *a, const double *b, size_t n,
+                                  calc_reduce_lanes_t *lanes) {
+    (void)b;
+    for (size_t i = 0; i < n; i += CALC_REDUCE_LANES) {
+        for (size_t lane = 0; lane < CALC_REDUCE_LANES; lane++) {
+            reduce_product_step(lanes, lane, (i + lane < n) ? a[i + lane] : 1.0);
+        }
+    }
+}
+
+static void kernel_dot_scalar(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    for (size_t i = 0; i < n; i += CALC_REDUCE_LANES) {
+        for (size_t lane = 0; lane < CALC_REDUCE_LANES; lane++) {
+            bool inside = i + lane < n;
+            reduce_dot_step(lanes, lane, inside ? a[i + lane] : 0.0, inside ? b[i + lane] : 0.0);
+        }
+    }
+}
+
+const calc_kernel_table_t calc_kernels_scalar = {
+    kernel_add_scalar, kernel_subtract_scalar, kernel_multiply_scalar, kernel_divide_scalar,
+    kernel_divide_prepared_scalar, kernel_axpy_scalar,
+    kernel_sum_scalar, kernel_product_scalar, kernel_dot_scalar
+};
+
+#ifdef CALC_KERNELS_X86
+
+// ==========================================
+// MARK: - SSE2 Kernels
+// ==========================================
+
+__attribute__((target("sse2")))
+static size_t kernel_add_sse2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d r = _mm_add_pd(va, vb);
+        if (calculator_lanes_sum_sse2(va, vb, r) != CALC_LANES_ALL_SSE2) {
+            break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t kernel_subtract_sse2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d r = _mm_sub_pd(va, vb);
+        if (calculator_lanes_difference_sse2(va, vb, r) != CALC_LANES_ALL_SSE2) {
+            break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t kernel_multiply_sse2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d r = _mm_mul_pd(va, vb);
+        if (calculator_lanes_product_sse2(va, vb, r) != CALC_LANES_ALL_SSE2) {
+            break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t kernel_divide_sse2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d r = _mm_div_pd(va, vb);
+        if ((calculator_lanes_quotient_sse2(va, r) & calculator_lanes_divisor_sse2(vb)) != CALC_LANES_ALL_SSE2) {
+            break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static size_t kernel_divide_prepared_sse2(const double *a, const calc_divisor_f64_t *divisor,
+                                          double *out, size_t n) {
+    __m128d vd = _mm_set1_pd(divisor->divisor);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d r = _mm_div_pd(va, vd);
+        if (calculator_lanes_quotient_sse2(va, r) != CALC_LANES_ALL_SSE2) {
+            break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static inline void sse2_two_sum(__m128d *s, __m128d *c, __m128d x) {
+    __m128d t = _mm_add_pd(*s, x);
+    __m128d z = _mm_sub_pd(t, *s);
+    *c = _mm_add_pd(*c, _mm_add_pd(_mm_sub_pd(*s, _mm_sub_pd(t, z)), _mm_sub_pd(x, z)));
+    *s = t;
+}
+
+/* Lanes 2k and 2k + 1 live in register k; the tail is padded with zeros */
+__attribute__((target("sse2")))
+static void kernel_sum_sse2(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    __m128d s[CALC_REDUCE_LANES / 2], c[CALC_REDUCE_LANES / 2];
+    double tail[CALC_REDUCE_LANES] = { 0.0 };
+    size_t i = 0;
+
+    (void)b;
+    for (size_t k = 0; k < CALC_REDUCE_LANES / 2; k++) {
+        s[k] = _mm_loadu_pd(lanes->value + 2 * k);
+        c[k] = _mm_loadu_pd(lanes->compensation + 2 * k);
+    }
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        for (size_t k = 0; k < CALC_REDUCE_LANES / 2; k++) {
+            sse2_two_sum(&s[k], &c[k], _mm_loadu_pd(a + i + 2 * k));
+        }
+    }
+    if (i < n) {
+        for (size_t lane = 0; i + lane < n; lane++) {
+            tail[lane] = a[i + lane];
+        }
+        for (size_t k = 0; k < CALC_REDUCE_LANES / 2; k++) {
+            sse2_two_sum(&s[k], &c[k], _mm_loadu_pd(tail + 2 * k));
+        }
+    }
+    for (size_t k = 0; k < CALC_REDUCE_LANES / 2; k++) {
+        _mm_storeu_pd(lanes->value + 2 * k, s[k]);
+        _mm_storeu_pd(lanes->compensation + 2 * k, c[k]);
+    }
+}
+
+/* SSE2 has no FMA, so axpy, product and dot share the scalar kernels */
+const calc_kernel_table_t calc_kernels_sse2 = {
+    kernel_add_sse2, kernel_subtract_sse2, kernel_multiply_sse2, kernel_divide_sse2,
+    kernel_divide_prepared_sse2, kernel_axpy_scalar,
+    kernel_sum_sse2, kernel_product_scalar, kernel_dot_scalar
+};
+
+#endif /* CALC_KERNELS_X86 */
@@ -0,0 +1,241 @@
+// ==========================================
+// FILE: calculator_kernels_avx2.c
+// ==========================================
+/**
+ * @file calculator_kernels_avx2.c
+ * @brief Calculator kernels - AVX2 + FMA level
+ * @details Implements the 4-lane kernel table. The Makefile compiles this
+ *          file with -mavx2 -mfma, so it must only be entered after the
+ *          dispatch layer has confirmed CPU support.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_kernels.h"
+#include "calculator_lanes.h"
+
+// ==========================================
+// MARK: - AVX2 Kernels
+// ==========================================
+
+static size_t kernel_add_avx2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d r = _mm256_add_pd(va, vb);
+        if (calculator_lanes_sum_avx2(va, vb, r) != CALC_LANES_ALL_AVX2) {
+            break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_subtract_avx2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d r = _mm256_sub_pd(va, vb);
+        if (calculator_lanes_difference_avx2(va, vb, r) != CALC_LANES_ALL_AVX2) {
+            break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_multiply_avx2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d r = _mm256_mul_pd(va, vb);
+        if (calculator_lanes_product_avx2(va, vb, r) != CALC_LANES_ALL_AVX2) {
+            break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_divide_avx2(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d r = _mm256_div_pd(va, vb);
+        if ((calculator_lanes_quotient_avx2(va, r) & calculator_lanes_divisor_avx2(vb)) != CALC_LANES_ALL_AVX2) {
+            break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+/*
+ * q = a * (1/d) is within one ulp of a / d, and fma(-q, d, a) is its exact
+ * residual, so q + residual * (1/d) rounds to the correctly rounded
+ * quotient. Zero dividends take q itself, which already has the right
+ * sign; vectors with a lane outside the exact range take a true division.
+ * Zeros are told by their bits, so under DAZ a subnormal dividend is out
+ * of range rather than zero and its flush is seen.
+ */
+static size_t kernel_divide_prepared_avx2(const double *a, const calc_divisor_f64_t *divisor,
+                                          double *out, size_t n) {
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d vd = _mm256_set1_pd(divisor->divisor);
+    __m256d vr = _mm256_set1_pd(divisor->reciprocal);
+    __m256d lo = _mm256_set1_pd(divisor->dividend_min);
+    __m256d hi = _mm256_set1_pd(divisor->dividend_max);
+    __m256d zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d magnitude = _mm256_and_pd(va, abs_mask);
+        __m256d in_range = _mm256_and_pd(_mm256_cmp_pd(magnitude, lo, _CMP_GE_OQ),
+                                         _mm256_cmp_pd(magnitude, hi, _CMP_LE_OQ));
+        __m256d is_zero = _mm256_cmp_pd(va, zero, _CMP_EQ_OQ);
+        __m256d r;
+        if ((_mm256_movemask_pd(in_range) | calculator_lanes_zero_avx2(va)) == CALC_LANES_ALL_AVX2) {
+            __m256d q = _mm256_mul_pd(va, vr);
+            __m256d residual = _mm256_fnmadd_pd(q, vd, va);
+            r = _mm256_blendv_pd(_mm256_fmadd_pd(residual, vr, q), q, is_zero);
+        } else {
+            r = _mm256_div_pd(va, vd);
+            if (calculator_lanes_quotient_avx2(va, r) != CALC_LANES_ALL_AVX2) {
+                break;
+            }
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+/* One vfmadd per vector: the product is never rounded on its own */
+static size_t kernel_axpy_avx2(double alpha, const double *x, const double *y, double *out, size_t n) {
+    __m256d va = _mm256_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d vy = _mm256_loadu_pd(y + i);
+        __m256d r = _mm256_fmadd_pd(va, vx, vy);
+        if (calculator_lanes_fused_avx2(va, vx, vy, r) != CALC_LANES_ALL_AVX2) {
+            break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+/*
+ * Reductions: lanes 0-3 live in the first register and 4-7 in the second.
+ * Each step matches the scalar kernels operation for operation; the
+ * Makefile builds this file with -ffp-contract=off so the separate
+ * multiply and add of the product step are not fused.
+ */
+
+static inline void avx2_sum_step(__m256d *s, __m256d *c, __m256d x) {
+    __m256d t = _mm256_add_pd(*s, x);
+    __m256d z = _mm256_sub_pd(t, *s);
+    *c = _mm256_add_pd(*c, _mm256_add_pd(_mm256_sub_pd(*s, _mm256_sub_pd(t, z)), _mm256_sub_pd(x, z)));
+    *s = t;
+}
+
+static inline void avx2_product_step(__m256d *p, __m256d *c, __m256d x) {
+    __m256d q = _mm256_mul_pd(*p, x);
+    *c = _mm256_add_pd(_mm256_mul_pd(*c, x), _mm256_fmsub_pd(*p, x, q));
+    *p = q;
+}
+
+static inline void avx2_dot_step(__m256d *s, __m256d *c, __m256d x, __m256d y) {
+    __m256d p = _mm256_mul_pd(x, y);
+    __m256d product_error = _mm256_fmsub_pd(x, y, p);
+    __m256d t = _mm256_add_pd(*s, p);
+    __m256d z = _mm256_sub_pd(t, *s);
+    __m256d sum_error = _mm256_add_pd(_mm256_sub_pd(*s, _mm256_sub_pd(t, z)), _mm256_sub_pd(p, z));
+    *c = _mm256_add_pd(*c, _mm256_add_pd(sum_error, product_error));
+    *s = t;
+}
+
+/** Copy a partial last block into a buffer padded with fill */
+static inline void avx2_pad_tail(const double *a, size_t count, double fill, double *tail) {
+    for (size_t lane = 0; lane < CALC_REDUCE_LANES; lane++) {
+        tail[lane] = (lane < count) ? a[lane] : fill;
+    }
+}
+
+static void kernel_sum_avx2(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    __m256d s0 = _mm256_loadu_pd(lanes->value), s1 = _mm256_loadu_pd(lanes->value + 4);
+    __m256d c0 = _mm256_loadu_pd(lanes->compensation), c1 = _mm256_loadu_pd(lanes->compensation + 4);
+    double tail[CALC_REDUCE_LANES];
+    size_t i = 0;
+
+    (void)b;
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx2_sum_step(&s0, &c0, _mm256_loadu_pd(a + i));
+        avx2_sum_step(&s1, &c1, _mm256_loadu_pd(a + i + 4));
+    }
+    if (i < n) {
+        avx2_pad_tail(a + i, n - i, 0.0, tail);
+        avx2_sum_step(&s0, &c0, _mm256_loadu_pd(tail));
+        avx2_sum_step(&s1, &c1, _mm256_loadu_pd(tail + 4));
+    }
+    _mm256_storeu_pd(lanes->value, s0);
+    _mm256_storeu_pd(lanes->value + 4, s1);
+    _mm256_storeu_pd(lanes->compensation, c0);
+    _mm256_storeu_pd(lanes->compensation + 4, c1);
+}
+
+static void kernel_product_avx2(const double *a, const double *b, size_t n,
+                                calc_reduce_lanes_t *lanes) {
+    __m256d p0 = _mm256_loadu_pd(lanes->value), p1 = _mm256_loadu_pd(lanes->value + 4);
+    __m256d c0 = _mm256_loadu_pd(lanes->compensation), c1 = _mm256_loadu_pd(lanes->compensation + 4);
+    double tail[CALC_REDUCE_LANES];
+    size_t i = 0;
+
+    (void)b;
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx2_product_step(&p0, &c0, _mm256_loadu_pd(a + i));
+        avx2_product_step(&p1, &c1, _mm256_loadu_pd(a + i + 4));
+    }
+    if (i < n) {
+        avx2_pad_tail(a + i, n - i, 1.0, tail);
+        avx2_product_step(&p0, &c0, _mm256_loadu_pd(tail));
+        avx2_product_step(&p1, &c1, _mm256_loadu_pd(tail + 4));
+    }
+    _mm256_storeu_pd(lanes->value, p0);
+    _mm256_storeu_pd(lanes->value + 4, p1);
+    _mm256_storeu_pd(lanes->compensation, c0);
+    _mm256_storeu_pd(lanes->compensation + 4, c1);
+}
+
+static void kernel_dot_avx2(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    __m256d s0 = _mm256_loadu_pd(lanes->value), s1 = _mm256_loadu_pd(lanes->value + 4);
+    __m256d c0 = _mm256_loadu_pd(lanes->compensation), c1 = _mm256_loadu_pd(lanes->compensation + 4);
+    double tail_a[CALC_REDUCE_LANES], tail_b[CALC_REDUCE_LANES];
+    size_t i = 0;
+
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx2_dot_step(&s0, &c0, _mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        avx2_dot_step(&s1, &c1, _mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+    }
+    if (i < n) {
+        avx2_pad_tail(a + i, n - i, 0.0, tail_a);
+        avx2_pad_tail(b + i, n - i, 0.0, tail_b);
+        avx2_dot_step(&s0, &c0, _mm256_loadu_pd(tail_a), _mm256_loadu_pd(tail_b));
+        avx2_dot_step(&s1, &c1, _mm256_loadu_pd(tail_a + 4), _mm256_loadu_pd(tail_b + 4));
+    }
+    _mm256_storeu_pd(lanes->value, s0);
+    _mm256_storeu_pd(lanes->value + 4, s1);
+    _mm256_storeu_pd(lanes->compensation, c0);
+    _mm256_storeu_pd(lanes->compensation + 4, c1);
+}
+
+const calc_kernel_table_t calc_kernels_avx2 = {
+    kernel_add_avx2, kernel_subtract_avx2, kernel_multiply_avx2, kernel_divide_avx2,
+    kernel_divide_prepared_avx2, kernel_axpy_avx2,
+    kernel_sum_avx2, kernel_product_avx2, kernel_dot_avx2
+};
@@ -0,0 +1,207 @@
+// ==========================================
+// FILE: calculator_kernels_avx512.c
+// ==========================================
+/**
+ * @file calculator_kernels_avx512.c
+ * @brief Calculator kernels - AVX-512 level
+ * @details Implements the 8-lane kernel table. The Makefile compiles this
+ *          file with -mavx512f -mavx512dq -mavx2 -mfma, so it must only be
+ *          entered after the dispatch layer has confirmed CPU support.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_kernels.h"
+#include "calculator_lanes.h"
+
+// ==========================================
+// MARK: - AVX-512 Kernels
+// ==========================================
+
+static size_t kernel_add_avx512(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d r = _mm512_add_pd(va, vb);
+        if (calculator_lanes_sum_avx512(va, vb, r) != CALC_LANES_ALL_AVX512) {
+            break;
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_subtract_avx512(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d r = _mm512_sub_pd(va, vb);
+        if (calculator_lanes_difference_avx512(va, vb, r) != CALC_LANES_ALL_AVX512) {
+            break;
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_multiply_avx512(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d r = _mm512_mul_pd(va, vb);
+        if (calculator_lanes_product_avx512(va, vb, r) != CALC_LANES_ALL_AVX512) {
+            break;
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_divide_avx512(const double *a, const double *b, double *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d r = _mm512_div_pd(va, vb);
+        if ((calculator_lanes_quotient_avx512(va, r) & calculator_lanes_divisor_avx512(vb)) != CALC_LANES_ALL_AVX512) {
+            break;
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+/* Reciprocal plus FMA correction, as in kernel_divide_prepared_avx2() */
+static size_t kernel_divide_prepared_avx512(const double *a, const calc_divisor_f64_t *divisor,
+                                            double *out, size_t n) {
+    __m512d vd = _mm512_set1_pd(divisor->divisor);
+    __m512d vr = _mm512_set1_pd(divisor->reciprocal);
+    __m512d lo = _mm512_set1_pd(divisor->dividend_min);
+    __m512d hi = _mm512_set1_pd(divisor->dividend_max);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d magnitude = _mm512_abs_pd(va);
+        __mmask8 in_range = _mm512_cmp_pd_mask(magnitude, lo, _CMP_GE_OQ) &
+                            _mm512_cmp_pd_mask(magnitude, hi, _CMP_LE_OQ);
+        __mmask8 is_zero = _mm512_cmp_pd_mask(va, _mm512_setzero_pd(), _CMP_EQ_OQ);
+        __m512d r;
+        if ((__mmask8)(in_range | calculator_lanes_zero_avx512(va)) == CALC_LANES_ALL_AVX512) {
+            __m512d q = _mm512_mul_pd(va, vr);
+            __m512d residual = _mm512_fnmadd_pd(q, vd, va);
+            r = _mm512_mask_mov_pd(_mm512_fmadd_pd(residual, vr, q), is_zero, q);
+        } else {
+            r = _mm512_div_pd(va, vd);
+            if (calculator_lanes_quotient_avx512(va, r) != CALC_LANES_ALL_AVX512) {
+                break;
+            }
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+static size_t kernel_axpy_avx512(double alpha, const double *x, const double *y, double *out, size_t n) {
+    __m512d va = _mm512_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d vy = _mm512_loadu_pd(y + i);
+        __m512d r = _mm512_fmadd_pd(va, vx, vy);
+        if (calculator_lanes_fused_avx512(va, vx, vy, r) != CALC_LANES_ALL_AVX512) {
+            break;
+        }
+        _mm512_storeu_pd(out + i, r);
+    }
+    return i;
+}
+
+/* Reductions: all eight lanes in one register, steps as in the AVX2 file */
+
+static inline void avx512_sum_step(__m512d *s, __m512d *c, __m512d x) {
+    __m512d t = _mm512_add_pd(*s, x);
+    __m512d z = _mm512_sub_pd(t, *s);
+    *c = _mm512_add_pd(*c, _mm512_add_pd(_mm512_sub_pd(*s, _mm512_sub_pd(t, z)), _mm512_sub_pd(x, z)));
+    *s = t;
+}
+
+static inline void avx512_product_step(__m512d *p, __m512d *c, __m512d x) {
+    __m512d q = _mm512_mul_pd(*p, x);
+    *c = _mm512_add_pd(_mm512_mul_pd(*c, x), _mm512_fmsub_pd(*p, x, q));
+    *p = q;
+}
+
+static inline void avx512_dot_step(__m512d *s, __m512d *c, __m512d x, __m512d y) {
+    __m512d p = _mm512_mul_pd(x, y);
+    __m512d product_error = _mm512_fmsub_pd(x, y, p);
+    __m512d t = _mm512_add_pd(*s, p);
+    __m512d z = _mm512_sub_pd(t, *s);
+    __m512d sum_error = _mm512_add_pd(_mm512_sub_pd(*s, _mm512_sub_pd(t, z)), _mm512_sub_pd(p, z));
+    *c = _mm512_add_pd(*c, _mm512_add_pd(sum_error, product_error));
+    *s = t;
+}
+
+/** Mask of the first count lanes, for a partial last block */
+static inline __mmask8 avx512_tail_mask(size_t count) {
+    return (__mmask8)((1u << count) - 1);
+}
+
+static void kernel_sum_avx512(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    __m512d s = _mm512_loadu_pd(lanes->value);
+    __m512d c = _mm512_loadu_pd(lanes->compensation);
+    size_t i = 0;
+
+    (void)b;
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx512_sum_step(&s, &c, _mm512_loadu_pd(a + i));
+    }
+    if (i < n) {
+        avx512_sum_step(&s, &c, _mm512_maskz_loadu_pd(avx512_tail_mask(n - i), a + i));
+    }
+    _mm512_storeu_pd(lanes->value, s);
+    _mm512_storeu_pd(lanes->compensation, c);
+}
+
+static void kernel_product_avx512(const double *a, const double *b, size_t n,
+                                  calc_reduce_lanes_t *lanes) {
+    __m512d p = _mm512_loadu_pd(lanes->value);
+    __m512d c = _mm512_loadu_pd(lanes->compensation);
+    size_t i = 0;
+
+    (void)b;
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx512_product_step(&p, &c, _mm512_loadu_pd(a + i));
+    }
+    if (i < n) {
+        __m512d x = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), avx512_tail_mask(n - i), a + i);
+        avx512_product_step(&p, &c, x);
+    }
+    _mm512_storeu_pd(lanes->value, p);
+    _mm512_storeu_pd(lanes->compensation, c);
+}
+
+static void kernel_dot_avx512(const double *a, const double *b, size_t n, calc_reduce_lanes_t *lanes) {
+    __m512d s = _mm512_loadu_pd(lanes->value);
+    __m512d c = _mm512_loadu_pd(lanes->compensation);
+    size_t i = 0;
+
+    for (; i + CALC_REDUCE_LANES <= n; i += CALC_REDUCE_LANES) {
+        avx512_dot_step(&s, &c, _mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+    }
+    if (i < n) {
+        __mmask8 mask = avx512_tail_mask(n - i);
+        avx512_dot_step(&s, &c, _mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i));
+    }
+    _mm512_storeu_pd(lanes->value, s);
+    _mm512_storeu_pd(lanes->compensation, c);
+}
+
+const calc_kernel_table_t calc_kernels_avx512 = {
+    kernel_add_avx512, kernel_subtract_avx512, kernel_multiply_avx512, kernel_divide_avx512,
+    kernel_divide_prepared_avx512, kernel_axpy_avx512,
+    kernel_sum_avx512, kernel_product_avx512, kernel_dot_avx512
+};
@@ -0,0 +1,212 @@
+// ==========================================
+// FILE: calculator_reduce.c
+// ==========================================
+/**
+ * @file calculator_reduce.c
+ * @brief Calculator reduction implementation
+ * @details Implements the compensated reductions on top of the reduce
+ *          kernels of the active level. Every chunk starts from fresh lanes
+ *          and is folded to one (value, compensation) partial; partials are
+ *          combined strictly in chunk order, whether one thread computed
+ *          them all or the thread pool computed them in any order.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "calculator_reduce.h"
+#include "calculator_dispatch.h"
+#include "calculator_inline.h"
+#include "pool.h"
+#include <stdlib.h>
+
+// ==========================================
+// MARK: - Reduction Types
+// ==========================================
+
+/** Reduction operations */
+typedef enum {
+    REDUCE_SUM = 0,
+    REDUCE_PRODUCT,
+    REDUCE_DOT
+} reduce_op_t;
+
+/** Compensated value of one chunk or of a combined run of chunks */
+typedef struct {
+    double value;               ///< Plain sum or product
+    double compensation;        ///< Rounding error of value
+} reduce_partial_t;
+
+/** One reduction, shared by the pool threads */
+typedef struct {
+    reduce_op_t op;
+    calc_reduce_fn_t kernel;
+    const double *a;
+    const double *b;
+    size_t n;
+    reduce_partial_t *partials; ///< One entry per chunk of the whole array
+} reduce_job_t;
+
+// ==========================================
+// MARK: - Internal Helpers
+// ==========================================
+
+static reduce_partial_t reduce_identity(reduce_op_t op) {
+    reduce_partial_t identity = { (op == REDUCE_PRODUCT) ? 1.0 : 0.0, 0.0 };
+    return identity;
+}
+
+/** Fold part into total: TwoSum of the values, or a compensated product */
+static void reduce_combine(reduce_op_t op, reduce_partial_t *total, reduce_partial_t part) {
+    if (op == REDUCE_PRODUCT) {
+        double product = total->value * part.value;
+        double error = fma(total->value, part.value, -product);
+        total->compensation = (total->compensation * part.value + total->value * part.compensation) + error;
+        total->value = product;
+        return;
+    }
+
+    double t = total->value + part.value;
+    double z = t - total->value;
+    double error = (total->value - (t - z)) + (part.value - z);
+    total->compensation += error + part.compensation;
+    total->value = t;
+}
+
+/** Reduce chunk k from fresh lanes and fold the lanes in lane order */
+static reduce_partial_t reduce_chunk(const reduce_job_t *job, size_t k) {
+    size_t begin = k * CALC_REDUCE_CHUNK;
+    size_t count = (job->n - begin < CALC_REDUCE_CHUNK) ? job->n - begin : CALC_REDUCE_CHUNK;
+    reduce_partial_t identity = reduce_identity(job->op);
+    calc_reduce_lanes_t lanes;
+
+    for (size_t lane = 0; lane < CALC_REDUCE_LANES; lane++) {
+        lanes.value[lane] = identity.value;
+        lanes.compensation[lane] = 0.0;
+    }
+    job->kernel(job->a + begin, (job->b != NULL) ? job->b + begin : NULL, count, &lanes);
+
+    reduce_partial_t partial = { lanes.value[0], lanes.compensation[0] };
+    for (size_t lane = 1; lane < CALC_REDUCE_LANES; lane++) {
+        reduce_partial_t part = { lanes.value[lane], lanes.compensation[lane] };
+        reduce_combine(job->op, &partial, part);
+    }
+    return partial;
+}
+
+/** Pool body: compute the partials of chunks [first, last) */
+static void reduce_chunks(void *context, size_t first, size_t last) {
+    reduce_job_t *job = context;
+    for (size_t k = first; k < last; k++) {
+        job->partials[k] = reduce_chunk(job, k);
+    }
+}
+
+/** True if any of the n elements is +0 or -0 */
+static bool reduce_has_zero(const double *a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (calculator_inline_is_zero(a[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** True if some a[i] * b[i] of nonzero factors rounds to zero */
+static bool reduce_has_lost_product(const double *a, const double *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (calculator_inline_is_zero(a[i] * b[i]) &&
+            !calculator_inline_is_zero(a[i]) && !calculator_inline_is_zero(b[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** True if any of the n elements is NaN or infinite */
+static bool reduce_has_invalid(const double *a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (!calculator_is_valid_number(a[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static calc_result_t reduce_run(reduce_op_t op, const double *a, const double *b, size_t n,
+                                double *result) {
+    const calc_kernel_table_t *kernels = calculator_dispatch_kernels();
+    reduce_job_t job = { op, kernels->sum, a, b, n, NULL };
+    reduce_partial_t total = reduce_identity(op);
+    size_t chunks = (n + CALC_REDUCE_CHUNK - 1) / CALC_REDUCE_CHUNK;
+
+    if (result == NULL || (n > 0 && (a == NULL || (op == REDUCE_DOT && b == NULL)))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    if (op == REDUCE_PRODUCT) {
+        job.kernel = kernels->product;
+    } else if (op == REDUCE_DOT) {
+        job.kernel = kernels->dot;
+    }
+
+    // The pool picks which thread computes a chunk; a missing partials
+    // array only costs the parallelism, never the result
+    if (chunks >= CALC_REDUCE_PARALLEL_CHUNKS) {
+        job.partials = malloc(chunks * sizeof(*job.partials));
+    }
+    if (job.partials != NULL) {
+        pool_parallel_for(chunks, 1, reduce_chunks, &job);
+        for (size_t k = 0; k < chunks; k++) {
+            reduce_combine(op, &total, job.partials[k]);
+        }
+    } else {
+        for (size_t k = 0; k < chunks; k++) {
+            reduce_combine(op, &total, reduce_chunk(&job, k));
+        }
+    }
+    free(job.partials);
+
+    *result = total.value + total.compensation;
+    if (isfinite(*result)) {
+        // Any reduction can end up subnormal. Sums of doubles are multiples
+        // of the smallest subnormal, so a zero sum is exact; a zero product
+        // is exact when one of the factors is zero, and a zero dot product
+        // when no term vanished to underflow
+        bool zero_is_exact = true;
+        if (calculator_inline_is_zero(*result)) {
+            if (op == REDUCE_PRODUCT) {
+                zero_is_exact = reduce_has_zero(a, n);
+            } else if (op == REDUCE_DOT) {
+                zero_is_exact = !reduce_has_lost_product(a, b, n);
+            }
+        }
+        return calculator_inline_range(*result, zero_is_exact);
+    }
+
+    // Non-finite inputs always poison the lanes, so they are only looked
+    // for once the result is known to be bad
+    if (reduce_has_invalid(a, n) || (op == REDUCE_DOT && reduce_has_invalid(b, n))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    // Opposite overflows meet as NaN; the plain value keeps the direction
+    if (isnan(*result) && !isnan(total.value)) {
+        *result = total.value;
+    }
+    return CALC_ERROR_OVERFLOW;
+}
+
+// ==========================================
+// MARK: - Reduction Operations
+// ==========================================
+
+calc_result_t calculator_sum(const double *a, size_t n, double *result) {
+    return reduce_run(REDUCE_SUM, a, NULL, n, result);
+}
+
+calc_result_t calculator_product(const double *a, size_t n, double *result) {
+    return reduce_run(REDUCE_PRODUCT, a, NULL, n, result);
+}
+
+calc_result_t calculator_dot(const double *a, const double *b, size_t n, double *result) {
+    return reduce_run(REDUCE_DOT, a, b, n, result);
+}
@@ -0,0 +1,379 @@
+// ==========================================
+// FILE: columnar.c
+// ==========================================
+/**
+ * @file columnar.c
+ * @brief Columnar file implementation
+ * @details Implements the columnar reader, writer, converter and in-place
+ *          evaluation. Files are always mapped whole with MAP_SHARED, so
+ *          evaluation writes results straight into the page cache and the
+ *          kernels never see a copy of the operands.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "columnar.h"
+#include "batch_mode.h"
+#include "parser.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ==========================================
+// MARK: - Columnar Types
+// ==========================================
+
+/** Array entry point of one operation */
+typedef calc_result_t (*columnar_batch_fn_t)(const double *a, const double *b, double *out,
+                                             size_t n, calc_batch_errors_t *errors);
+
+/** Rows evaluated one by one, starting at row first */
+typedef struct {
+    columnar_file_t *file;
+    size_t first;
+} columnar_rows_t;
+
+_Static_assert(sizeof(columnar_header_t) == 64, "columnar header must stay 64 bytes");
+
+/** Bytes per row of each column */
+static const size_t columnar_widths[COLUMNAR_COLUMN_COUNT] = {
+    sizeof(double), sizeof(double), sizeof(uint8_t), sizeof(double), sizeof(uint8_t)
+};
+
+// ==========================================
+// MARK: - Layout
+// ==========================================
+
+static bool columnar_host_is_little_endian(void) {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+    const uint16_t probe = 1;
+    return *(const uint8_t *)&probe == 1;
+#endif
+}
+
+static size_t columnar_align(size_t offset) {
+    return (offset + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT;
+}
+
+/**
+ * Place the columns of a file with rows rows
+ * @return false if the file would not fit in size_t
+ */
+static bool columnar_layout(size_t rows, uint64_t offsets[COLUMNAR_COLUMN_COUNT], size_t *size) {
+    size_t offset = columnar_align(sizeof(columnar_header_t));
+
+    // Five columns of at most 8 bytes per row, each padded by less than one alignment
+    if (rows > (SIZE_MAX - offset) / 64 - COLUMNAR_ALIGNMENT) {
+        return false;
+    }
+    for (int column = 0; column < COLUMNAR_COLUMN_COUNT; column++) {
+        offsets[column] = offset;
+        offset = columnar_align(offset + rows * columnar_widths[column]);
+    }
+    *size = offset;
+    return true;
+}
+
+/** Point the column pointers of file into its mapping */
+static void columnar_bind(columnar_file_t *file, const columnar_header_t *header) {
+    char *base = file->base;
+    file->rows = (size_t)header->rows;
+    file->a = (double *)(base + header->offsets[COLUMNAR_COLUMN_A]);
+    file->b = (double *)(base + header->offsets[COLUMNAR_COLUMN_B]);
+    file->op = (uint8_t *)(base + header->offsets[COLUMNAR_COLUMN_OP]);
+    file->result = (double *)(base + header->offsets[COLUMNAR_COLUMN_RESULT]);
+    file->error = (uint8_t *)(base + header->offsets[COLUMNAR_COLUMN_ERROR]);
+}
+
+/** Check a header against the size of its file */
+static bool columnar_header_is_valid(const columnar_header_t *header, size_t size) {
+    if (memcmp(header->magic, COLUMNAR_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != COLUMNAR_VERSION || header->header_size != sizeof(columnar_header_t) ||
+        header->rows > size) {
+        return false;
+    }
+    for (int column = 0; column < COLUMNAR_COLUMN_COUNT; column++) {
+        uint64_t offset = header->offsets[column];
+        if (offset % COLUMNAR_ALIGNMENT != 0 || offset < sizeof(columnar_header_t) || offset > size ||
+            header->rows > (size - offset) / columnar_widths[column]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==========================================
+// MARK: - Reader and Writer
+// ==========================================
+
+columnar_result_t columnar_create(const char *path, size_t rows, columnar_file_t *file) {
+    columnar_header_t header;
+    size_t size;
+
+    if (path == NULL || file == NULL) {
+        return COLUMNAR_ERROR_INVALID_INPUT;
+    }
+    memset(file, 0, sizeof(*file));
+    if (!columnar_host_is_little_endian()) {
+        return COLUMNAR_ERROR_FORMAT;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+    header.version = COLUMNAR_VERSION;
+    header.header_size = sizeof(columnar_header_t);
+    header.rows = rows;
+    if (!columnar_layout(rows, header.offsets, &size) || (uintmax_t)size > (uintmax_t)INT64_MAX) {
+        return COLUMNAR_ERROR_INVALID_INPUT;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return COLUMNAR_ERROR_IO;
+    }
+    // A sparse file: every column starts out as zeros
+    void *base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) {
+        return COLUMNAR_ERROR_IO;
+    }
+
+    memcpy(base, &header, sizeof(header));
+    file->base = base;
+    file->size = size;
+    file->writable = true;
+    columnar_bind(file, &header);
+    return COLUMNAR_SUCCESS;
+}
+
+columnar_result_t columnar_open(const char *path, bool writable, columnar_file_t *file) {
+    struct stat info;
+
+    if (path == NULL || file == NULL) {
+        return COLUMNAR_ERROR_INVALID_INPUT;
+    }
+    memset(file, 0, sizeof(*file));
+    if (!columnar_host_is_little_endian()) {
+        return COLUMNAR_ERROR_FORMAT;
+    }
+
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        return COLUMNAR_ERROR_IO;
+    }
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || (uintmax_t)info.st_size > SIZE_MAX) {
+        close(fd);
+        return COLUMNAR_ERROR_IO;
+    }
+    if ((size_t)info.st_size < sizeof(columnar_header_t)) {
+        close(fd);
+        return COLUMNAR_ERROR_FORMAT;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *base = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return COLUMNAR_ERROR_IO;
+    }
+    if (!columnar_header_is_valid(base, size)) {
+        munmap(base, size);
+        return COLUMNAR_ERROR_FORMAT;
+    }
+    // Columns are streamed front to back, one after the other
+    madvise(base, size, MADV_SEQUENTIAL);
+
+    file->base = base;
+    file->size = size;
+    file->writable = writable;
+    columnar_bind(file, base);
+    return COLUMNAR_SUCCESS;
+}
+
+void columnar_close(columnar_file_t *file) {
+    if (file == NULL) {
+        return;
+    }
+    if (file->base != NULL) {
+        munmap(file->base, file->size);
+    }
+    memset(file, 0, sizeof(*file));
+}
+
+// ==========================================
+// MARK: - Evaluation
+// ==========================================
+
+/** Array entry point for op, or NULL if op is evaluated row by row */
+static columnar_batch_fn_t columnar_batch_fn(uint8_t op) {
+    switch (op) {
+        case BATCH_OP_ADD:      return calculator_add_batch;
+        case BATCH_OP_SUBTRACT: return calculator_subtract_batch;
+        case BATCH_OP_MULTIPLY: return calculator_multiply_batch;
+        case BATCH_OP_DIVIDE:   return calculator_divide_batch;
+        case BATCH_OP_POWER:    return calculator_power_batch;
+        default:                return NULL;
+    }
+}
+
+/** One past the last row of the run of equal op codes starting at start */
+static size_t columnar_run_end(const columnar_file_t *file, size_t start) {
+    size_t end = start + 1;
+    while (end < file->rows && file->op[end] == file->op[start]) {
+        end++;
+    }
+    return end;
+}
+
+/** True if the run [start, end) goes to an array entry point */
+static bool columnar_run_is_batched(const columnar_file_t *file, size_t start, size_t end) {
+    return end - start >= COLUMNAR_MIN_RUN && columnar_batch_fn(file->op[start]) != NULL;
+}
+
+/** Batch body: rows [first + begin, first + end) through batch_mode_evaluate() */
+static calc_result_t columnar_evaluate_rows(void *context, size_t begin, size_t end,
+                                            calc_batch_errors_t *errors) {
+    const columnar_rows_t *rows = context;
+    columnar_file_t *file = rows->file;
+    calc_result_t first_error = CALC_SUCCESS;
+
+    for (size_t i = begin; i < end; i++) {
+        size_t row = rows->first + i;
+        calc_result_t status = batch_mode_evaluate((batch_op_t)file->op[row], file->a[row], file->b[row],
+                                                   &file->result[row]);
+        if (status != CALC_SUCCESS) {
+            status = calculator_batch_errors_record(errors, i, status);
+            if (first_error == CALC_SUCCESS) {
+                first_error = status;
+            }
+        }
+    }
+    return first_error;
+}
+
+columnar_result_t columnar_evaluate(columnar_file_t *file, calc_batch_summary_t *summary) {
+    calc_batch_summary_t total;
+
+    if (file == NULL || !file->writable) {
+        return COLUMNAR_ERROR_INVALID_INPUT;
+    }
+    memset(&total, 0, sizeof(total));
+
+    for (size_t start = 0; start < file->rows; ) {
+        size_t end = columnar_run_end(file, start);
+        calc_batch_errors_t errors = { file->error + start, NULL, { 0, { 0 }, 0 } };
+
+        if (columnar_run_is_batched(file, start, end)) {
+            columnar_batch_fn(file->op[start])(file->a + start, file->b + start, file->result + start,
+                                               end - start, &errors);
+        } else {
+            // Take every following run that is not batched either, so a file
+            // of mixed ops becomes one row-by-row pass
+            while (end < file->rows) {
+                size_t next = columnar_run_end(file, end);
+                if (columnar_run_is_batched(file, end, next)) {
+                    break;
+                }
+                end = next;
+            }
+            columnar_rows_t rows = { file, start };
+            calculator_batch_parallel(end - start, columnar_evaluate_rows, &rows, &errors);
+        }
+
+        total.failed += errors.summary.failed;
+        for (size_t code = 0; code < CALC_RESULT_COUNT; code++) {
+            total.counts[code] += errors.summary.counts[code];
+        }
+        total.flushed += errors.summary.flushed;
+        start = end;
+    }
+
+    if (summary != NULL) {
+        *summary = total;
+    }
+    return COLUMNAR_SUCCESS;
+}
+
+// ==========================================
+// MARK: - Text Conversion
+// ==========================================
+
+/** True for the lines batch mode skips without output */
+static bool columnar_line_is_skipped(const char *line, size_t length) {
+    const char *cursor = parser_skip_blanks(line, line + length);
+    return cursor == line + length || *cursor == '#';
+}
+
+columnar_result_t columnar_convert_text(const char *text_path, const char *columnar_path,
+                                        size_t *rows) {
+    columnar_result_t result = COLUMNAR_SUCCESS;
+    columnar_file_t file;
+    parser_map_t map;
+    parser_span_t span;
+    parser_result_t read_result;
+    const char *line;
+    size_t length;
+    size_t count = 0;
+
+    if (text_path == NULL || columnar_path == NULL) {
+        return COLUMNAR_ERROR_INVALID_INPUT;
+    }
+
+    int fd = open(text_path, O_RDONLY);
+    if (fd < 0) {
+        return COLUMNAR_ERROR_IO;
+    }
+    parser_result_t map_result = parser_map_open(&map, fd);
+    close(fd);
+    if (map_result != PARSER_SUCCESS) {
+        return COLUMNAR_ERROR_IO;
+    }
+
+    // First pass sizes the columns, second pass fills them
+    parser_span_init(&span, map.data, map.data + map.size, BATCH_IO_BUFFER_SIZE);
+    while ((read_result = parser_span_next_line(&span, &line, &length)) != PARSER_ERROR_EOF) {
+        if (read_result != PARSER_SUCCESS || !columnar_line_is_skipped(line, length)) {
+            count++;
+        }
+    }
+
+    result = columnar_create(columnar_path, count, &file);
+    if (result == COLUMNAR_SUCCESS) {
+        size_t row = 0;
+        parser_span_init(&span, map.data, map.data + map.size, BATCH_IO_BUFFER_SIZE);
+        while ((read_result = parser_span_next_line(&span, &line, &length)) != PARSER_ERROR_EOF) {
+            batch_operation_t operation;
+            batch_line_t kind = BATCH_LINE_INVALID;
+
+            if (read_result == PARSER_SUCCESS) {
+                kind = batch_mode_parse_line(line, length, &operation);
+            }
+            if (kind == BATCH_LINE_SKIP) {
+                continue;
+            }
+            if (kind == BATCH_LINE_OPERATION) {
+                file.a[row] = operation.a;
+                file.b[row] = operation.b;
+                file.op[row] = (uint8_t)operation.op;
+            } else {
+                file.op[row] = (uint8_t)BATCH_OP_INVALID;
+            }
+            row++;
+        }
+        columnar_close(&file);
+    }
+    parser_map_close(&map);
+
+    if (rows != NULL) {
+        *rows = (result == COLUMNAR_SUCCESS) ? count : 0;
+    }
+    return result;
+}
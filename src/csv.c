@@ -0,0 +1,490 @@
+// ==========================================
+// FILE: csv.c
+// ==========================================
+/**
+ * @file csv.c
+ * @brief CSV subsystem implementation
+ * @details Implements the three-stage CSV pipeline. The reader classifies
+ *          64 bytes at a time: SIMD compares turn delimiters, newlines and
+ *          quotes into 64-bit masks, a prefix XOR over the quote mask marks
+ *          the bytes inside quotes, and the remaining delimiter and newline
+ *          bits are walked with count-trailing-zeros, as in simdjson and
+ *          simdcsv. Only the fields the program reads are parsed, straight
+ *          into the block's input columns.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "csv.h"
+#include "output.h"
+#include "parser.h"
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/** Output buffer of the writer stage */
+#define CSV_OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+// ==========================================
+// MARK: - CSV Types
+// ==========================================
+
+/** Pipeline stage that owns a block */
+typedef enum {
+    CSV_STAGE_FREE = 0,         ///< Waiting for the reader
+    CSV_STAGE_READ,             ///< Rows cut and parsed, waiting for compute
+    CSV_STAGE_COMPUTED          ///< Results ready, waiting for the writer
+} csv_stage_t;
+
+/** One block of rows */
+typedef struct {
+    char *data;                 ///< CSV_BLOCK_SIZE bytes of input
+    uint32_t *row_begin;        ///< Offset of each row in data
+    uint32_t *row_end;          ///< Offset one past each row's text (line ending excluded)
+    size_t rows;                ///< Rows in the block
+    double **columns;           ///< Input columns, NULL where the program reads none
+    double *result;             ///< Result of each row
+    uint8_t *codes;             ///< calc_result_t of each row
+    bool header;                ///< Row 0 is the header row
+    bool last;                  ///< No block follows this one
+    csv_stage_t stage;
+} csv_block_t;
+
+/** State shared by the three stages */
+typedef struct {
+    const vm_program_t *program;
+    size_t column_count;        ///< Entries in every block's columns array
+    int input_fd;
+    int output_fd;
+    bool header;
+    csv_block_t blocks[CSV_PIPELINE_DEPTH];
+    pthread_mutex_t lock;       ///< Guards every stage field and result
+    pthread_cond_t changed;     ///< Signalled whenever a block changes stage
+    csv_result_t result;        ///< First failure of any stage
+    csv_stats_t stats;          ///< Counted by the writer
+} csv_pipeline_t;
+
+/** Row cutter state carried across 64-byte windows */
+typedef struct {
+    size_t row_start;           ///< Offset of the row being cut
+    size_t field_start;         ///< Offset of the field being cut
+    size_t field;               ///< Index of the field being cut
+    uint64_t inside;            ///< All ones while the previous window ended inside quotes
+} csv_cursor_t;
+
+// ==========================================
+// MARK: - Delimiter Scanning
+// ==========================================
+
+/** Bit i set where window[i] == c, for a 64-byte window */
+static inline uint64_t csv_match(const char *window, char c) {
+#ifdef __SSE2__
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(const void *)(window + 16 * i));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle)) << (16 * i);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i++) {
+        mask |= (uint64_t)(window[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+/** Bit i set where an odd number of quote bits are at or below i */
+static inline uint64_t csv_prefix_xor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// ==========================================
+// MARK: - Reader Stage
+// ==========================================
+
+/** Parse one field into its column, or NaN if it is not a number */
+static void csv_store_field(csv_block_t *block, const csv_pipeline_t *pipeline, size_t field,
+                            const char *begin, const char *end) {
+    if (field >= pipeline->column_count || block->columns[field] == NULL) {
+        return;
+    }
+
+    double value = NAN;
+    begin = parser_skip_blanks(begin, end);
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        end--;
+    }
+    if (end - begin >= 2 && *begin == CSV_QUOTE && end[-1] == CSV_QUOTE) {
+        begin = parser_skip_blanks(begin + 1, end - 1);
+        end--;
+    }
+    const char *parsed = parser_parse_double(begin, end, &value);
+    block->columns[field][block->rows] = (parsed == end) ? value : NAN;
+}
+
+/** Close the current row at offset end (its newline, or the end of input) */
+static void csv_end_row(csv_block_t *block, csv_cursor_t *cursor, size_t end) {
+    size_t text_end = end;
+    if (text_end > cursor->row_start && block->data[text_end - 1] == '\r') {
+        text_end--;
+    }
+    block->row_begin[block->rows] = (uint32_t)cursor->row_start;
+    block->row_end[block->rows] = (uint32_t)text_end;
+    block->rows++;
+    cursor->row_start = end + 1;
+    cursor->field_start = end + 1;
+    cursor->field = 0;
+}
+
+/** Set every input column of the next row to NaN, for rows with missing fields */
+static void csv_begin_row(csv_block_t *block, const csv_pipeline_t *pipeline) {
+    const vm_program_t *program = pipeline->program;
+    for (int i = 0; i < program->input_count; i++) {
+        block->columns[program->inputs[i]][block->rows] = NAN;
+    }
+}
+
+/**
+ * Cut the first filled bytes of a block into rows and parse their fields
+ * @return Bytes consumed: everything up to the end of the last whole row
+ */
+static size_t csv_cut_rows(csv_pipeline_t *pipeline, csv_block_t *block, size_t filled, bool eof) {
+    csv_cursor_t cursor = { 0, 0, 0, 0 };
+    char padded[64];
+
+    block->rows = 0;
+    csv_begin_row(block, pipeline);
+    for (size_t base = 0; base < filled; base += 64) {
+        const char *window = block->data + base;
+        size_t count = filled - base;
+        if (count < 64) {
+            // Zero bytes match nothing the scanner looks for
+            memset(padded, 0, sizeof(padded));
+            memcpy(padded, window, count);
+            window = padded;
+        }
+
+        uint64_t quotes = csv_match(window, CSV_QUOTE);
+        uint64_t inside = csv_prefix_xor(quotes) ^ cursor.inside;
+        cursor.inside = (uint64_t)0 - (inside >> 63);
+        uint64_t newlines = csv_match(window, '\n') & ~inside;
+        uint64_t structural = (csv_match(window, CSV_DELIMITER) & ~inside) | newlines;
+
+        while (structural != 0) {
+            size_t offset = base + (size_t)__builtin_ctzll(structural);
+            uint64_t bit = structural & (0 - structural);
+            structural ^= bit;
+
+            csv_store_field(block, pipeline, cursor.field, block->data + cursor.field_start,
+                            block->data + offset);
+            if ((newlines & bit) == 0) {
+                cursor.field++;
+                cursor.field_start = offset + 1;
+                continue;
+            }
+            csv_end_row(block, &cursor, offset);
+            if (block->rows == CSV_BLOCK_ROWS) {
+                return cursor.row_start;
+            }
+            csv_begin_row(block, pipeline);
+        }
+    }
+
+    // The last row of the input may lack its newline
+    if (eof && cursor.row_start < filled) {
+        csv_store_field(block, pipeline, cursor.field, block->data + cursor.field_start,
+                        block->data + filled);
+        csv_end_row(block, &cursor, filled);
+        return filled;
+    }
+    return cursor.row_start;
+}
+
+/** Wait until a block reaches a stage */
+static void csv_wait(csv_pipeline_t *pipeline, csv_block_t *block, csv_stage_t stage) {
+    pthread_mutex_lock(&pipeline->lock);
+    while (block->stage != stage) {
+        pthread_cond_wait(&pipeline->changed, &pipeline->lock);
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+/** Hand a block to the next stage */
+static void csv_publish(csv_pipeline_t *pipeline, csv_block_t *block, csv_stage_t stage) {
+    pthread_mutex_lock(&pipeline->lock);
+    block->stage = stage;
+    pthread_cond_broadcast(&pipeline->changed);
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+/** Record the first failure of any stage */
+static void csv_fail(csv_pipeline_t *pipeline, csv_result_t result) {
+    pthread_mutex_lock(&pipeline->lock);
+    if (pipeline->result == CSV_SUCCESS) {
+        pipeline->result = result;
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+static void *csv_reader_main(void *arg) {
+    csv_pipeline_t *pipeline = arg;
+    const char *carry = NULL;   ///< Partial row left in the previous block
+    size_t carry_length = 0;
+    bool eof = false;
+    bool header = pipeline->header;
+
+    for (size_t sequence = 0; ; sequence++) {
+        csv_block_t *block = &pipeline->blocks[sequence % CSV_PIPELINE_DEPTH];
+        csv_wait(pipeline, block, CSV_STAGE_FREE);
+
+        // Another stage failed: end the stream with an empty block
+        pthread_mutex_lock(&pipeline->lock);
+        bool stopped = pipeline->result != CSV_SUCCESS;
+        pthread_mutex_unlock(&pipeline->lock);
+        if (stopped) {
+            block->rows = 0;
+            block->header = false;
+            block->last = true;
+            csv_publish(pipeline, block, CSV_STAGE_READ);
+            return NULL;
+        }
+
+        // The previous block is not reused before this one is taken, so
+        // its partial row is still intact
+        memmove(block->data, carry, carry_length);
+        size_t filled = carry_length;
+        csv_result_t result = CSV_SUCCESS;
+        while (!eof && filled < CSV_BLOCK_SIZE) {
+            ssize_t received = read(pipeline->input_fd, block->data + filled, CSV_BLOCK_SIZE - filled);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received < 0) {
+                result = CSV_ERROR_IO;
+                break;
+            }
+            if (received == 0) {
+                eof = true;
+            }
+            filled += (size_t)received;
+        }
+
+        size_t consumed = 0;
+        if (result == CSV_SUCCESS) {
+            consumed = csv_cut_rows(pipeline, block, filled, eof);
+            if (block->rows == 0 && filled == CSV_BLOCK_SIZE) {
+                result = CSV_ERROR_OVERLONG;
+            }
+        }
+        if (result != CSV_SUCCESS) {
+            csv_fail(pipeline, result);
+            block->rows = 0;
+        }
+
+        block->header = header && block->rows > 0;
+        header = header && block->rows == 0;
+        block->last = result != CSV_SUCCESS || (eof && consumed == filled);
+        carry = block->data + consumed;
+        carry_length = filled - consumed;
+        csv_publish(pipeline, block, CSV_STAGE_READ);
+        if (block->last) {
+            return NULL;
+        }
+    }
+}
+
+// ==========================================
+// MARK: - Writer Stage
+// ==========================================
+
+static void *csv_writer_main(void *arg) {
+    csv_pipeline_t *pipeline = arg;
+    output_writer_t writer;
+    bool failed = false;
+
+    char *buffer = malloc(CSV_OUTPUT_BUFFER_SIZE);
+    if (buffer == NULL) {
+        csv_fail(pipeline, CSV_ERROR_MEMORY);
+        failed = true;
+    } else {
+        output_init(&writer, pipeline->output_fd, buffer, CSV_OUTPUT_BUFFER_SIZE);
+    }
+
+    for (size_t sequence = 0; ; sequence++) {
+        csv_block_t *block = &pipeline->blocks[sequence % CSV_PIPELINE_DEPTH];
+        csv_wait(pipeline, block, CSV_STAGE_COMPUTED);
+
+        // After a failure blocks are only drained, so the reader never stalls
+        for (size_t row = 0; row < block->rows && !failed; row++) {
+            output_write(&writer, block->data + block->row_begin[row],
+                         block->row_end[row] - block->row_begin[row]);
+            if (row == 0 && block->header) {
+                output_puts(&writer, CSV_HEADER_SUFFIX "\n");
+                continue;
+            }
+
+            pipeline->stats.rows++;
+            if (block->codes[row] == CALC_SUCCESS) {
+                output_write(&writer, ",", 1);
+                output_double(&writer, block->result[row]);
+                output_write(&writer, ",\n", 2);
+            } else {
+                pipeline->stats.failed++;
+                output_write(&writer, ",,", 2);
+                output_puts(&writer, calculator_result_name((calc_result_t)block->codes[row]));
+                output_write(&writer, "\n", 1);
+            }
+            if (writer.failed) {
+                csv_fail(pipeline, CSV_ERROR_IO);
+                failed = true;
+            }
+        }
+
+        bool last = block->last;
+        csv_publish(pipeline, block, CSV_STAGE_FREE);
+        if (last) {
+            break;
+        }
+    }
+
+    if (!failed && output_flush(&writer) != OUTPUT_SUCCESS) {
+        csv_fail(pipeline, CSV_ERROR_IO);
+    }
+    free(buffer);
+    return NULL;
+}
+
+// ==========================================
+// MARK: - Pipeline
+// ==========================================
+
+static void csv_free_blocks(csv_pipeline_t *pipeline) {
+    for (size_t k = 0; k < CSV_PIPELINE_DEPTH; k++) {
+        csv_block_t *block = &pipeline->blocks[k];
+        if (block->columns != NULL) {
+            for (size_t column = 0; column < pipeline->column_count; column++) {
+                free(block->columns[column]);
+            }
+        }
+        free(block->columns);
+        free(block->data);
+        free(block->row_begin);
+        free(block->row_end);
+        free(block->result);
+        free(block->codes);
+    }
+}
+
+static bool csv_allocate_blocks(csv_pipeline_t *pipeline) {
+    const vm_program_t *program = pipeline->program;
+
+    for (size_t k = 0; k < CSV_PIPELINE_DEPTH; k++) {
+        csv_block_t *block = &pipeline->blocks[k];
+        block->data = malloc(CSV_BLOCK_SIZE);
+        block->row_begin = malloc(CSV_BLOCK_ROWS * sizeof(uint32_t));
+        block->row_end = malloc(CSV_BLOCK_ROWS * sizeof(uint32_t));
+        block->result = malloc(CSV_BLOCK_ROWS * sizeof(double));
+        block->codes = malloc(CSV_BLOCK_ROWS);
+        block->columns = calloc(pipeline->column_count, sizeof(double *));
+        if (block->data == NULL || block->row_begin == NULL || block->row_end == NULL ||
+            block->result == NULL || block->codes == NULL || block->columns == NULL) {
+            return false;
+        }
+        // Only the columns the program reads get storage
+        for (int i = 0; i < program->input_count; i++) {
+            size_t column = program->inputs[i];
+            block->columns[column] = malloc(CSV_BLOCK_ROWS * sizeof(double));
+            if (block->columns[column] == NULL) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+csv_result_t csv_evaluate(int input_fd, int output_fd, const vm_program_t *program, bool header,
+                          csv_stats_t *stats) {
+    csv_pipeline_t pipeline;
+    pthread_t reader;
+    pthread_t writer;
+
+    if (input_fd < 0 || output_fd < 0 || program == NULL) {
+        return CSV_ERROR_INVALID_INPUT;
+    }
+
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.program = program;
+    pipeline.column_count = (program->input_limit > 0) ? program->input_limit : 1;
+    pipeline.input_fd = input_fd;
+    pipeline.output_fd = output_fd;
+    pipeline.header = header;
+    if (!csv_allocate_blocks(&pipeline)) {
+        csv_free_blocks(&pipeline);
+        return CSV_ERROR_MEMORY;
+    }
+    pthread_mutex_init(&pipeline.lock, NULL);
+    pthread_cond_init(&pipeline.changed, NULL);
+
+    if (pthread_create(&writer, NULL, csv_writer_main, &pipeline) != 0) {
+        pipeline.result = CSV_ERROR_THREAD;
+    } else if (pthread_create(&reader, NULL, csv_reader_main, &pipeline) != 0) {
+        // Stop the writer with an empty last block
+        pipeline.result = CSV_ERROR_THREAD;
+        pipeline.blocks[0].rows = 0;
+        pipeline.blocks[0].last = true;
+        csv_publish(&pipeline, &pipeline.blocks[0], CSV_STAGE_COMPUTED);
+        pthread_join(writer, NULL);
+    } else {
+        // Compute stage: the VM runs each block's columns on the thread pool
+        for (size_t sequence = 0; ; sequence++) {
+            csv_block_t *block = &pipeline.blocks[sequence % CSV_PIPELINE_DEPTH];
+            csv_wait(&pipeline, block, CSV_STAGE_READ);
+            calc_batch_errors_t errors = { block->codes, NULL, { 0, { 0 }, 0 } };
+            vm_execute_columns(program, (const double *const *)block->columns, pipeline.column_count,
+                               block->result, block->rows, &errors);
+            bool last = block->last;
+            csv_publish(&pipeline, block, CSV_STAGE_COMPUTED);
+            if (last) {
+                break;
+            }
+        }
+        pthread_join(reader, NULL);
+        pthread_join(writer, NULL);
+    }
+
+    pthread_cond_destroy(&pipeline.changed);
+    pthread_mutex_destroy(&pipeline.lock);
+    csv_free_blocks(&pipeline);
+    if (stats != NULL) {
+        *stats = pipeline.stats;
+    }
+    return pipeline.result;
+}
+
+const char *csv_result_name(csv_result_t result) {
+    switch (result) {
+        case CSV_SUCCESS:               return "success";
+        case CSV_ERROR_INVALID_INPUT:   return "invalid_input";
+        case CSV_ERROR_IO:              return "io";
+        case CSV_ERROR_MEMORY:          return "memory";
+        case CSV_ERROR_OVERLONG:        return "overlong";
+        case CSV_ERROR_THREAD:          return "thread";
+        default:                        return "unknown";
+    }
+}
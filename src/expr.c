@@ -0,0 +1,310 @@
+// ==========================================
+// FILE: expr.c
+// ==========================================
+/**
+ * @file expr.c
+ * @brief Expression subsystem implementation
+ * @details Implements the tokenizer, the Pratt parser and the postfix
+ *          evaluator. Each operator carries a left and a right binding
+ *          power; the parser loops while the next operator binds tighter
+ *          than the caller allows and recurses only for operands, counting
+ *          every recursion against EXPR_MAX_DEPTH.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "expr.h"
+#include "parser.h"
+#include "calculator_inline.h"
+#include <stdbool.h>
+#include <string.h>
+
+// ==========================================
+// MARK: - Parser State
+// ==========================================
+
+/** Binding power of unary minus: below ^, above * / % */
+#define EXPR_PREFIX_POWER 30
+
+/** Parser over one expression text */
+typedef struct {
+    const char *text;           ///< Start of the text, for error offsets
+    const char *cursor;         ///< Next unread character
+    const char *end;            ///< End of the text
+    expr_t *expr;               ///< Destination expression
+    int depth;                  ///< Current nesting depth
+    expr_result_t error;        ///< First error, or EXPR_SUCCESS
+} expr_parser_t;
+
+/** Left and right binding powers of a binary operator; 0 if c is not one */
+typedef struct {
+    uint8_t left;
+    uint8_t right;
+    uint8_t kind;
+} expr_binding_t;
+
+static expr_binding_t expr_binary_binding(char c) {
+    switch (c) {
+        case '+': return (expr_binding_t){ 10, 11, EXPR_NODE_ADD };
+        case '-': return (expr_binding_t){ 10, 11, EXPR_NODE_SUBTRACT };
+        case '*': return (expr_binding_t){ 20, 21, EXPR_NODE_MULTIPLY };
+        case '/': return (expr_binding_t){ 20, 21, EXPR_NODE_DIVIDE };
+        case '%': return (expr_binding_t){ 20, 21, EXPR_NODE_MODULUS };
+        case '^': return (expr_binding_t){ 41, 40, EXPR_NODE_POWER };    // Right-associative
+        default:  return (expr_binding_t){ 0, 0, 0 };
+    }
+}
+
+// ==========================================
+// MARK: - Tokenizer and Node Helpers
+// ==========================================
+
+/** Skip blanks and return the next character without consuming it, or 0 at end */
+static char expr_peek(expr_parser_t *parser) {
+    parser->cursor = parser_skip_blanks(parser->cursor, parser->end);
+    return (parser->cursor < parser->end) ? *parser->cursor : '\0';
+}
+
+static uint32_t expr_fail(expr_parser_t *parser, expr_result_t error) {
+    if (parser->error == EXPR_SUCCESS) {
+        parser->error = error;
+        parser->expr->error_offset = (size_t)(parser->cursor - parser->text);
+    }
+    return 0;
+}
+
+static uint32_t expr_add_node(expr_parser_t *parser, expr_node_t node) {
+    expr_t *expr = parser->expr;
+    if (expr->count >= expr->capacity) {
+        return expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+    }
+    expr->nodes[expr->count] = node;
+    return expr->count++;
+}
+
+// ==========================================
+// MARK: - Pratt Parser
+// ==========================================
+
+static uint32_t expr_parse_binding(expr_parser_t *parser, int min_power);
+
+/** Parse an input reference colN, N in [1, EXPR_MAX_INPUTS] */
+static uint32_t expr_parse_input(expr_parser_t *parser) {
+    size_t prefix_length = sizeof(EXPR_INPUT_PREFIX) - 1;
+    const char *digits = parser->cursor + prefix_length;
+    int number;
+
+    if ((size_t)(parser->end - parser->cursor) <= prefix_length ||
+        memcmp(parser->cursor, EXPR_INPUT_PREFIX, prefix_length) != 0 ||
+        *digits < '0' || *digits > '9') {
+        return expr_fail(parser, EXPR_ERROR_SYNTAX);
+    }
+    const char *next = parser_parse_int(digits, parser->end, &number);
+    if (next == NULL || number < 1 || number > EXPR_MAX_INPUTS) {
+        return expr_fail(parser, EXPR_ERROR_SYNTAX);
+    }
+    parser->cursor = next;
+
+    expr_node_t node;
+    node.kind = EXPR_NODE_INPUT;
+    node.as.input = (uint32_t)number - 1;
+    if (node.as.input >= parser->expr->input_count) {
+        parser->expr->input_count = node.as.input + 1;
+    }
+    return expr_add_node(parser, node);
+}
+
+/** Parse a number, a parenthesized expression or a prefix operator */
+static uint32_t expr_parse_operand(expr_parser_t *parser) {
+    char c = expr_peek(parser);
+    expr_node_t node;
+
+    if ((c >= '0' && c <= '9') || c == '.') {
+        const char *next = parser_parse_double(parser->cursor, parser->end, &node.as.value);
+        if (next == NULL) {
+            return expr_fail(parser, EXPR_ERROR_SYNTAX);
+        }
+        parser->cursor = next;
+        node.kind = EXPR_NODE_NUMBER;
+        return expr_add_node(parser, node);
+    }
+
+    if (c == EXPR_INPUT_PREFIX[0]) {
+        return expr_parse_input(parser);
+    }
+
+    if (c != '(' && c != '-' && c != '+') {
+        return expr_fail(parser, EXPR_ERROR_SYNTAX);
+    }
+    if (++parser->depth > EXPR_MAX_DEPTH) {
+        return expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+    }
+    parser->cursor++;
+
+    uint32_t operand;
+    if (c == '(') {
+        operand = expr_parse_binding(parser, 0);
+        if (parser->error != EXPR_SUCCESS) {
+            return 0;
+        }
+        if (expr_peek(parser) != ')') {
+            return expr_fail(parser, EXPR_ERROR_SYNTAX);
+        }
+        parser->cursor++;
+    } else {
+        operand = expr_parse_binding(parser, EXPR_PREFIX_POWER);
+        if (c == '-' && parser->error == EXPR_SUCCESS) {
+            node.kind = EXPR_NODE_NEGATE;
+            node.as.children.left = operand;
+            node.as.children.right = operand;
+            operand = expr_add_node(parser, node);
+        }
+    }
+    parser->depth--;
+    return operand;
+}
+
+/** Parse operators that bind at least as tightly as min_power */
+static uint32_t expr_parse_binding(expr_parser_t *parser, int min_power) {
+    uint32_t left = expr_parse_operand(parser);
+
+    while (parser->error == EXPR_SUCCESS) {
+        expr_binding_t binding = expr_binary_binding(expr_peek(parser));
+        if (binding.left == 0 || binding.left < min_power) {
+            break;
+        }
+        parser->cursor++;
+
+        // A right operand nests like a parenthesis: 1 ^ 1 ^ ... recurses
+        // once per operator
+        if (++parser->depth > EXPR_MAX_DEPTH) {
+            return expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+        }
+        uint32_t right = expr_parse_binding(parser, binding.right);
+        parser->depth--;
+        expr_node_t node;
+        node.kind = binding.kind;
+        node.as.children.left = left;
+        node.as.children.right = right;
+        left = expr_add_node(parser, node);
+    }
+    return left;
+}
+
+expr_result_t expr_parse(const char *text, size_t length, arena_t *arena, expr_t *expr) {
+    if (text == NULL || arena == NULL || expr == NULL) {
+        return EXPR_ERROR_INVALID_INPUT;
+    }
+
+    expr_parser_t parser = { text, text, text + length, expr, 0, EXPR_SUCCESS };
+    expr->count = 0;
+    expr->root = 0;
+    expr->input_count = 0;
+    expr->error_offset = 0;
+
+    // Nodes and scratch values in one allocation
+    expr->capacity = (length == 0) ? 1 : (length < EXPR_MAX_NODES) ? (uint32_t)length : EXPR_MAX_NODES;
+    expr->nodes = arena_alloc(arena, expr->capacity * (sizeof(expr_node_t) + sizeof(double)));
+    if (expr->nodes == NULL) {
+        expr->capacity = 0;
+        return EXPR_ERROR_MEMORY;
+    }
+    expr->values = (double *)(expr->nodes + expr->capacity);
+
+    expr->root = expr_parse_binding(&parser, 0);
+    if (parser.error == EXPR_SUCCESS && expr_peek(&parser) != '\0') {
+        expr_fail(&parser, EXPR_ERROR_SYNTAX);
+    }
+    return parser.error;
+}
+
+// ==========================================
+// MARK: - Evaluation
+// ==========================================
+
+/** True if no literal or input in nodes [first, count) is invalid */
+static bool expr_check_operands(const expr_t *expr, uint32_t first,
+                                const double *inputs, size_t input_count) {
+    for (uint32_t i = first; i < expr->count; i++) {
+        const expr_node_t *node = &expr->nodes[i];
+        if ((node->kind == EXPR_NODE_NUMBER && !calculator_inline_is_valid_number(node->as.value)) ||
+            (node->kind == EXPR_NODE_INPUT && (node->as.input >= input_count ||
+                                               !calculator_inline_is_valid_number(inputs[node->as.input])))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+calc_result_t expr_evaluate(expr_t *expr, double *result) {
+    if (expr == NULL) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    return expr_evaluate_inputs(expr, NULL, 0, expr->values, result);
+}
+
+calc_result_t expr_evaluate_inputs(const expr_t *expr, const double *inputs,
+                                   size_t input_count, double *scratch, double *result) {
+    if (expr == NULL || scratch == NULL || result == NULL || expr->count == 0 ||
+        (inputs == NULL && input_count > 0)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    // Postfix order: every operand's value is ready before its parent runs
+    double *values = scratch;
+    for (uint32_t i = 0; i < expr->count; i++) {
+        const expr_node_t *node = &expr->nodes[i];
+        if (node->kind == EXPR_NODE_NUMBER) {
+            values[i] = node->as.value;
+            if (!calculator_inline_is_valid_number(values[i])) {
+                return CALC_ERROR_INVALID_INPUT;
+            }
+            continue;
+        }
+        if (node->kind == EXPR_NODE_INPUT) {
+            if (node->as.input >= input_count || !calculator_inline_is_valid_number(inputs[node->as.input])) {
+                return CALC_ERROR_INVALID_INPUT;
+            }
+            values[i] = inputs[node->as.input];
+            continue;
+        }
+
+        double a = values[node->as.children.left];
+        double b = values[node->as.children.right];
+        calc_result_t status = CALC_SUCCESS;
+
+        switch ((expr_node_kind_t)node->kind) {
+            case EXPR_NODE_NEGATE:   values[i] = -a; break;
+            case EXPR_NODE_ADD:      status = calculator_inline_add(a, b, &values[i]); break;
+            case EXPR_NODE_SUBTRACT: status = calculator_inline_subtract(a, b, &values[i]); break;
+            case EXPR_NODE_MULTIPLY: status = calculator_inline_multiply(a, b, &values[i]); break;
+            case EXPR_NODE_DIVIDE:   status = calculator_inline_divide(a, b, &values[i]); break;
+            case EXPR_NODE_MODULUS:  status = calculator_inline_modulus_truncated(a, b, &values[i]); break;
+            case EXPR_NODE_POWER:    status = calculator_inline_power(a, b, &values[i]); break;
+            default:                 status = CALC_ERROR_INVALID_INPUT; break;
+        }
+        if (status != CALC_SUCCESS) {
+            return expr_check_operands(expr, i + 1, inputs, input_count) ? status
+                                                                          : CALC_ERROR_INVALID_INPUT;
+        }
+    }
+
+    *result = values[expr->root];
+    return CALC_SUCCESS;
+}
+
+// ==========================================
+// MARK: - Utility Functions
+// ==========================================
+
+const char *expr_result_name(expr_result_t result) {
+    switch (result) {
+        case EXPR_SUCCESS:             return "success";
+        case EXPR_ERROR_INVALID_INPUT: return "invalid_input";
+        case EXPR_ERROR_SYNTAX:        return "syntax";
+        case EXPR_ERROR_TOO_COMPLEX:   return "too_complex";
+        case EXPR_ERROR_MEMORY:        return "memory";
+        default:                       return "unknown";
+    }
+}
@@ -0,0 +1,521 @@
+// ==========================================
+// FILE: format.c
+// ==========================================
+/**
+ * @file format.c
+ * @brief Format subsystem implementation
+ * @details Implements double to text conversion without printf, locales or
+ *          heap allocation. Shortest digits come from Giulietti's Schubfach
+ *          algorithm ("The Schubfach way to render doubles", 2020), which
+ *          needs one 126-bit power of ten per decimal exponent. The general
+ *          mode rounds those digits to the requested precision and settles
+ *          the only ambiguous case, an exact "5" tail, with a small exact
+ *          big-integer comparison against the binary value.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "format.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/** Smallest and largest decimal exponents produced by Schubfach for doubles */
+#define FORMAT_K_MIN (-324)
+#define FORMAT_K_MAX 292
+
+/** floor(10^-k * 2^(125 - flog2pow10(-k))) + 1 as 63-bit halves (format_pow10.c) */
+extern const uint64_t format_pow10_table[2 * (FORMAT_K_MAX - FORMAT_K_MIN + 1)];
+
+/** Binary layout of a double */
+#define FORMAT_SIGNIFICAND_BITS 52
+#define FORMAT_EXPONENT_MASK 0x7FF
+#define FORMAT_Q_MIN (-1074)
+#define FORMAT_C_MIN ((uint64_t)1 << FORMAT_SIGNIFICAND_BITS)
+#define FORMAT_C_TINY 3
+#define FORMAT_MASK_63 0x7FFFFFFFFFFFFFFFULL
+
+/** 32-bit words in a big integer; enough for 2^53 * 10^343 */
+#define FORMAT_BIGNUM_WORDS 40
+
+/** Decimal digits as produced by the shortest conversion */
+typedef struct {
+    uint64_t digits;    ///< Significand without trailing zeros
+    int count;          ///< Number of decimal digits in digits
+    int exponent;       ///< Value is digits * 10^exponent
+} format_decimal_t;
+
+/** Fixed-size unsigned big integer, least significant word first */
+typedef struct {
+    uint32_t words[FORMAT_BIGNUM_WORDS];
+    int size;
+} format_bignum_t;
+
+/** "00" .. "99" for two-digits-at-a-time conversion */
+static const char format_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// ==========================================
+// MARK: - Schubfach Helpers
+// ==========================================
+
+static uint64_t format_multiply_high(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    return (uint64_t)(product >> 64);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t cross = ((a_lo * b_lo) >> 32) + (uint32_t)hi_lo + a_lo * b_hi;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/** floor(q * log10(2)) */
+static int format_flog10_pow2(int q) {
+    return (int)(((int64_t)q * 661971961083LL) >> 41);
+}
+
+/** floor(q * log10(2) + log10(3/4)) */
+static int format_flog10_three_quarters_pow2(int q) {
+    return (int)(((int64_t)q * 661971961083LL - 274743187321LL) >> 41);
+}
+
+/** floor(e * log2(10)) */
+static int format_flog2_pow10(int e) {
+    return (int)(((int64_t)e * 913124641741LL) >> 38);
+}
+
+/** Round to odd of g * cp / 2^127, with g split as g1 * 2^63 + g0 */
+static uint64_t format_round_to_odd(uint64_t g1, uint64_t g0, uint64_t cp) {
+    uint64_t x1 = format_multiply_high(g0, cp);
+    uint64_t y0 = g1 * cp;
+    uint64_t y1 = format_multiply_high(g1, cp);
+    uint64_t z = (y0 >> 1) + x1;
+    uint64_t vbp = y1 + (z >> 63);
+    return vbp | (((z & FORMAT_MASK_63) + FORMAT_MASK_63) >> 63);
+}
+
+/**
+ * @brief Shortest decimal in the rounding interval of c * 2^q
+ * @details Among the shortest candidates the one closest to the value is
+ *          chosen, ties to an even digit.
+ */
+static void format_schubfach(int q, uint64_t c, int dk, format_decimal_t *decimal) {
+    uint64_t out = c & 1;
+    uint64_t cb = c << 2;
+    uint64_t cbr = cb + 2;
+    uint64_t cbl;
+    int k;
+
+    // The interval is asymmetric at powers of two
+    if (c != FORMAT_C_MIN || q == FORMAT_Q_MIN) {
+        cbl = cb - 2;
+        k = format_flog10_pow2(q);
+    } else {
+        cbl = cb - 1;
+        k = format_flog10_three_quarters_pow2(q);
+    }
+
+    int h = q + format_flog2_pow10(-k) + 2;
+    uint64_t g1 = format_pow10_table[2 * (k - FORMAT_K_MIN)];
+    uint64_t g0 = format_pow10_table[2 * (k - FORMAT_K_MIN) + 1];
+    uint64_t vb = format_round_to_odd(g1, g0, cb << h);
+    uint64_t vbl = format_round_to_odd(g1, g0, cbl << h);
+    uint64_t vbr = format_round_to_odd(g1, g0, cbr << h);
+    uint64_t s = vb >> 2;
+
+    // One digit shorter, if a multiple of ten lies in the interval
+    if (s >= 100) {
+        uint64_t sp10 = 10 * (s / 10);
+        uint64_t tp10 = sp10 + 10;
+        bool upin = vbl + out <= sp10 << 2;
+        bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) {
+            decimal->digits = upin ? sp10 : tp10;
+            decimal->exponent = k + dk;
+            return;
+        }
+    }
+
+    uint64_t t = s + 1;
+    bool uin = vbl + out <= s << 2;
+    bool win = (t << 2) + out <= vbr;
+    if (uin != win) {
+        decimal->digits = uin ? s : t;
+        decimal->exponent = k + dk;
+        return;
+    }
+
+    int64_t cmp = (int64_t)(vb - ((s + t) << 1));
+    decimal->digits = (cmp < 0 || (cmp == 0 && (s & 1) == 0)) ? s : t;
+    decimal->exponent = k + dk;
+}
+
+/**
+ * @brief Split a finite, non-zero magnitude into its binary parts and
+ *        convert it to shortest decimal digits
+ */
+static void format_to_decimal(uint64_t bits, uint64_t *significand, int *binary_exponent,
+                              format_decimal_t *decimal) {
+    uint64_t t = bits & (FORMAT_C_MIN - 1);
+    int bq = (int)(bits >> FORMAT_SIGNIFICAND_BITS) & FORMAT_EXPONENT_MASK;
+
+    if (bq != 0) {
+        *significand = FORMAT_C_MIN | t;
+        *binary_exponent = bq - 1075;
+        format_schubfach(*binary_exponent, *significand, 0, decimal);
+    } else {
+        *significand = t;
+        *binary_exponent = FORMAT_Q_MIN;
+        // The two smallest subnormals need one extra digit of headroom
+        if (t < FORMAT_C_TINY) {
+            format_schubfach(FORMAT_Q_MIN, 10 * t, -1, decimal);
+        } else {
+            format_schubfach(FORMAT_Q_MIN, t, 0, decimal);
+        }
+    }
+
+    while (decimal->digits % 10 == 0) {
+        decimal->digits /= 10;
+        decimal->exponent++;
+    }
+
+    decimal->count = 1;
+    for (uint64_t rest = decimal->digits / 10; rest != 0; rest /= 10) {
+        decimal->count++;
+    }
+}
+
+// ==========================================
+// MARK: - Exact Comparison
+// ==========================================
+
+static void format_bignum_set(format_bignum_t *number, uint64_t value) {
+    number->words[0] = (uint32_t)value;
+    number->words[1] = (uint32_t)(value >> 32);
+    number->size = (number->words[1] != 0) ? 2 : 1;
+}
+
+static void format_bignum_multiply(format_bignum_t *number, uint32_t factor) {
+    uint64_t carry = 0;
+
+    for (int i = 0; i < number->size; i++) {
+        uint64_t product = (uint64_t)number->words[i] * factor + carry;
+        number->words[i] = (uint32_t)product;
+        carry = product >> 32;
+    }
+    if (carry != 0 && number->size < FORMAT_BIGNUM_WORDS) {
+        number->words[number->size++] = (uint32_t)carry;
+    }
+}
+
+static void format_bignum_multiply_pow2(format_bignum_t *number, int power) {
+    for (; power >= 31; power -= 31) {
+        format_bignum_multiply(number, (uint32_t)1 << 31);
+    }
+    format_bignum_multiply(number, (uint32_t)1 << power);
+}
+
+static void format_bignum_multiply_pow10(format_bignum_t *number, int power) {
+    for (; power >= 9; power -= 9) {
+        format_bignum_multiply(number, 1000000000u);
+    }
+    for (; power > 0; power--) {
+        format_bignum_multiply(number, 10);
+    }
+}
+
+static int format_bignum_compare(const format_bignum_t *a, const format_bignum_t *b) {
+    if (a->size != b->size) {
+        return (a->size < b->size) ? -1 : 1;
+    }
+    for (int i = a->size - 1; i >= 0; i--) {
+        if (a->words[i] != b->words[i]) {
+            return (a->words[i] < b->words[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/** Bit number bit of the big integer */
+static unsigned format_bignum_bit(const format_bignum_t *number, int bit) {
+    int word = bit / 32;
+    return (word < number->size) ? (number->words[word] >> (bit % 32)) & 1u : 0u;
+}
+
+/** Whether any bit below bit is set */
+static bool format_bignum_any_below(const format_bignum_t *number, int bit) {
+    int word = bit / 32;
+    for (int i = 0; i < word && i < number->size; i++) {
+        if (number->words[i] != 0) {
+            return true;
+        }
+    }
+    return word < number->size && (number->words[word] & (((uint32_t)1 << (bit % 32)) - 1)) != 0;
+}
+
+/**
+ * @brief Round a subnormal c * 2^-1074 to precision significant digits
+ * @details Subnormals carry fewer than 15 significant digits, so their
+ *          shortest form says nothing about the exact digits printf rounds.
+ *          Computes round-half-even(c * 10^s / 2^1074) with s chosen so the
+ *          result has precision digits, correcting point if it was one high.
+ */
+static uint64_t format_round_subnormal(uint64_t c, int precision, int *point,
+                                       const uint64_t *powers_of_ten) {
+    for (;;) {
+        format_bignum_t scaled;
+        uint64_t rounded = 0;
+
+        format_bignum_set(&scaled, c);
+        format_bignum_multiply_pow10(&scaled, precision - 1 - *point);
+
+        for (int bit = 63; bit >= 0; bit--) {
+            rounded = (rounded << 1) | format_bignum_bit(&scaled, -FORMAT_Q_MIN + bit);
+        }
+        if (format_bignum_bit(&scaled, -FORMAT_Q_MIN - 1) &&
+            (format_bignum_any_below(&scaled, -FORMAT_Q_MIN - 1) || (rounded & 1) != 0)) {
+            rounded++;
+        }
+
+        if (rounded < powers_of_ten[precision - 1]) {
+            (*point)--;
+            continue;
+        }
+        if (rounded == powers_of_ten[precision]) {
+            rounded = powers_of_ten[precision - 1];
+            (*point)++;
+        }
+        return rounded;
+    }
+}
+
+/**
+ * @brief Compare c * 2^q with d * 10^k exactly
+ * @return Negative, zero or positive as the binary value is below, equal
+ *         to or above the decimal one
+ */
+static int format_compare_exact(uint64_t c, int q, uint64_t d, int k) {
+    format_bignum_t binary, decimal;
+
+    format_bignum_set(&binary, c);
+    format_bignum_set(&decimal, d);
+
+    // Scale both sides so that every exponent is non-negative
+    if (q >= 0) {
+        format_bignum_multiply_pow2(&binary, q);
+    } else {
+        format_bignum_multiply_pow2(&decimal, -q);
+    }
+    if (k >= 0) {
+        format_bignum_multiply_pow10(&decimal, k);
+    } else {
+        format_bignum_multiply_pow10(&binary, -k);
+    }
+
+    return format_bignum_compare(&binary, &decimal);
+}
+
+// ==========================================
+// MARK: - Text Layout
+// ==========================================
+
+/** Write the count digits of value; returns count */
+static int format_write_digits(uint64_t value, int count, char *out) {
+    int position = count;
+
+    while (position >= 2) {
+        unsigned pair = (unsigned)(value % 100);
+        value /= 100;
+        position -= 2;
+        out[position] = format_digit_pairs[2 * pair];
+        out[position + 1] = format_digit_pairs[2 * pair + 1];
+    }
+    if (position == 1) {
+        out[0] = (char)('0' + value);
+    }
+    return count;
+}
+
+/**
+ * @brief Lay out digits the way "%.Pg" does
+ * @details The digits carry no trailing zeros, which is exactly what %g
+ *          prints after removing them; point is the decimal exponent of
+ *          the first digit.
+ */
+static size_t format_layout(bool negative, const char *digits, int count, int point,
+                            int precision, char *buffer) {
+    char *out = buffer;
+
+    if (negative) {
+        *out++ = '-';
+    }
+
+    if (point >= -4 && point < precision) {
+        if (point >= 0) {
+            // Integer part, padded with zeros past the last digit
+            int integer_digits = point + 1;
+            for (int i = 0; i < integer_digits; i++) {
+                *out++ = (i < count) ? digits[i] : '0';
+            }
+            if (count > integer_digits) {
+                *out++ = '.';
+                memcpy(out, digits + integer_digits, (size_t)(count - integer_digits));
+                out += count - integer_digits;
+            }
+        } else {
+            *out++ = '0';
+            *out++ = '.';
+            for (int i = 0; i < -point - 1; i++) {
+                *out++ = '0';
+            }
+            memcpy(out, digits, (size_t)count);
+            out += count;
+        }
+    } else {
+        unsigned magnitude = (unsigned)((point < 0) ? -point : point);
+
+        *out++ = digits[0];
+        if (count > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, (size_t)(count - 1));
+            out += count - 1;
+        }
+        *out++ = 'e';
+        *out++ = (point < 0) ? '-' : '+';
+        if (magnitude >= 100) {
+            *out++ = (char)('0' + magnitude / 100);
+            magnitude %= 100;
+        }
+        *out++ = format_digit_pairs[2 * magnitude];
+        *out++ = format_digit_pairs[2 * magnitude + 1];
+    }
+
+    *out = '\0';
+    return (size_t)(out - buffer);
+}
+
+/** Handle zero, infinities and NaNs; returns 0 for other values */
+static size_t format_special(uint64_t bits, char *buffer) {
+    bool negative = (bits >> 63) != 0;
+    uint64_t magnitude = bits & FORMAT_MASK_63;
+    const char *text;
+
+    if (magnitude == 0) {
+        text = negative ? "-0" : "0";
+    } else if ((magnitude >> FORMAT_SIGNIFICAND_BITS) == FORMAT_EXPONENT_MASK) {
+        if ((magnitude & (FORMAT_C_MIN - 1)) == 0) {
+            text = negative ? "-inf" : "inf";
+        } else {
+            text = negative ? "-nan" : "nan";
+        }
+    } else {
+        return 0;
+    }
+
+    size_t length = strlen(text);
+    memcpy(buffer, text, length + 1);
+    return length;
+}
+
+// ==========================================
+// MARK: - Public Formatting
+// ==========================================
+
+size_t format_double_shortest(double value, char *buffer) {
+    uint64_t bits, significand;
+    int binary_exponent;
+    format_decimal_t decimal;
+    char digits[20];
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    size_t special = format_special(bits, buffer);
+    if (special != 0) {
+        return special;
+    }
+
+    format_to_decimal(bits & FORMAT_MASK_63, &significand, &binary_exponent, &decimal);
+    format_write_digits(decimal.digits, decimal.count, digits);
+
+    return format_layout((bits >> 63) != 0, digits, decimal.count,
+                         decimal.exponent + decimal.count - 1,
+                         FORMAT_SHORTEST_SCIENTIFIC_EXPONENT, buffer);
+}
+
+size_t format_double_general(double value, int precision, char *buffer) {
+    static const uint64_t powers_of_ten[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL
+    };
+    uint64_t bits, significand;
+    int binary_exponent;
+    format_decimal_t decimal;
+    char digits[20];
+
+    if (precision < 1) {
+        precision = 1;
+    } else if (precision > FORMAT_MAX_GENERAL_PRECISION) {
+        precision = FORMAT_MAX_GENERAL_PRECISION;
+    }
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    size_t special = format_special(bits, buffer);
+    if (special != 0) {
+        return special;
+    }
+
+    format_to_decimal(bits & FORMAT_MASK_63, &significand, &binary_exponent, &decimal);
+    int point = decimal.exponent + decimal.count - 1;
+
+    if (binary_exponent == FORMAT_Q_MIN && significand < FORMAT_C_MIN) {
+        decimal.digits = format_round_subnormal(significand, precision, &point, powers_of_ten);
+        decimal.count = precision;
+        while (decimal.digits % 10 == 0) {
+            decimal.digits /= 10;
+            decimal.count--;
+        }
+    } else if (decimal.count > precision) {
+        // Shortest digits are unique in the rounding interval, so the dropped
+        // tail decides the direction unless it is exactly "5"
+        int dropped = decimal.count - precision;
+        uint64_t kept = decimal.digits / powers_of_ten[dropped];
+        uint64_t tail = decimal.digits % powers_of_ten[dropped];
+        uint64_t half = 5 * powers_of_ten[dropped - 1];
+        bool round_up;
+
+        if (tail != half) {
+            round_up = tail > half;
+        } else {
+            int cmp = format_compare_exact(significand, binary_exponent,
+                                           decimal.digits, decimal.exponent);
+            round_up = (cmp > 0) || (cmp == 0 && (kept & 1) != 0);
+        }
+
+        if (round_up) {
+            kept++;
+            if (kept == powers_of_ten[precision]) {
+                kept = powers_of_ten[precision - 1];
+                point++;
+            }
+        }
+
+        decimal.digits = kept;
+        decimal.count = precision;
+        while (decimal.digits % 10 == 0) {
+            decimal.digits /= 10;
+            decimal.count--;
+        }
+    }
+
+    format_write_digits(decimal.digits, decimal.count, digits);
+    return format_layout((bits >> 63) != 0, digits, decimal.count, point, precision, buffer);
+}
@@ -15,6 +15,15 @@
 #include "main.h"
 #include "menu.h"
 #include "calculator.h"
+#include "batch_mode.h"
+#include "expr.h"
+#include "columnar.h"
+#include "csv.h"
+#include "vm.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
 
 // ==========================================
 // MARK: - Main Entry Point
@@ -23,28 +32,70 @@
 /**
  * @brief Application entry point
  * @details Standard C main function that orchestrates application lifecycle:
- *          initialization, main loop execution, and cleanup.
- * @param argc Argument count (unused)
- * @param argv Argument vector (unused)
+ *          initialization, main loop execution, and cleanup. With
+ *          `--batch <file>` it runs headless instead.
+ * @param argc Argument count
+ * @param argv Argument vector
  * @return EXIT_SUCCESS on success, EXIT_FAILURE on error
  */
 int main(int argc, char *argv[]) {
-    // Suppress unused parameter warnings
-    (void)argc;
-    (void)argv;
-    
+    app_options_t options;
     app_result_t result;
     
+    // Phase 0: Select run mode
+    result = app_parse_arguments(argc, argv, &options);
+    if (result != APP_SUCCESS) {
+        app_display_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    if (options.mode == APP_MODE_HELP) {
+        app_display_usage(argv[0]);
+        return EXIT_SUCCESS;
+    }
+    
+    pool_result_t pool_result = pool_initialize(&options.pool);
+    if (pool_result != POOL_SUCCESS) {
+        fprintf(stderr, "❌ Error: Thread pool initialization failed (Code: %d)\n", pool_result);
+        return EXIT_FAILURE;
+    }
+    
+    if (options.mode == APP_MODE_BATCH) {
+        result = app_run_batch(&options);
+        pool_shutdown();
+        return (result == APP_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    if (options.mode == APP_MODE_EXPRESSION) {
+        result = app_run_expression(&options);
+        pool_shutdown();
+        return (result == APP_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    if (options.mode == APP_MODE_CSV) {
+        result = app_run_csv(&options);
+        pool_shutdown();
+        return (result == APP_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    if (options.mode == APP_MODE_COLUMNAR || options.mode == APP_MODE_CONVERT) {
+        result = app_run_columnar(&options);
+        pool_shutdown();
+        return (result == APP_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
     // Phase 1: Initialize application
     result = app_initialize();
     if (result != APP_SUCCESS) {
         fprintf(stderr, "❌ Fatal Error: Application initialization failed (Code: %d)\n", result);
+        pool_shutdown();
         return EXIT_FAILURE;
     }
     
     // Phase 2: Run main application loop
     result = app_run_main_loop();
     if (result != APP_SUCCESS) {
+        output_flush(output_stdout());
         fprintf(stderr, "❌ Warning: Application terminated with error (Code: %d)\n", result);
     }
     
@@ -57,6 +108,278 @@ int main(int argc, char *argv[]) {
     return (result == APP_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+// ==========================================
+// MARK: - Command Line
+// ==========================================
+
+/** Parse a non-negative decimal count such as a flush interval */
+static bool app_parse_count(const char *text, unsigned long long *count) {
+    char *end;
+    if (text[0] < '0' || text[0] > '9') {
+        return false;
+    }
+    errno = 0;
+    *count = strtoull(text, &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+app_result_t app_parse_arguments(int argc, char *argv[], app_options_t *options) {
+    if (options == NULL) {
+        return APP_ERROR_INIT;
+    }
+    
+    options->mode = APP_MODE_INTERACTIVE;
+    options->batch_path = NULL;
+    options->expression = NULL;
+    options->columnar_path = NULL;
+    options->csv_path = NULL;
+    options->out_path = NULL;
+    options->csv_header = false;
+    options->flush_policy.max_records = 0;
+    options->flush_policy.max_delay_us = 0;
+    options->pool.threads = 0;
+    options->pool.pin = false;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], APP_FLAG_BATCH) == 0) {
+            if (i + 1 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->mode = APP_MODE_BATCH;
+            options->batch_path = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_EXPR) == 0) {
+            if (i + 1 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->mode = APP_MODE_EXPRESSION;
+            options->expression = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_CSV) == 0) {
+            if (i + 1 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->csv_path = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_OUT) == 0) {
+            if (i + 1 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->out_path = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_CSV_HEADER) == 0) {
+            options->csv_header = true;
+        } else if (strcmp(argv[i], APP_FLAG_COLUMNAR) == 0) {
+            if (i + 1 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->mode = APP_MODE_COLUMNAR;
+            options->columnar_path = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_TO_COLUMNAR) == 0) {
+            if (i + 2 >= argc) {
+                return APP_ERROR_INIT;
+            }
+            options->mode = APP_MODE_CONVERT;
+            options->batch_path = argv[++i];
+            options->columnar_path = argv[++i];
+        } else if (strcmp(argv[i], APP_FLAG_FLUSH_RECORDS) == 0) {
+            unsigned long long count;
+            if (i + 1 >= argc || !app_parse_count(argv[++i], &count)) {
+                return APP_ERROR_INIT;
+            }
+            options->flush_policy.max_records = (size_t)count;
+        } else if (strcmp(argv[i], APP_FLAG_FLUSH_US) == 0) {
+            unsigned long long count;
+            if (i + 1 >= argc || !app_parse_count(argv[++i], &count)) {
+                return APP_ERROR_INIT;
+            }
+            options->flush_policy.max_delay_us = (uint64_t)count;
+        } else if (strcmp(argv[i], APP_FLAG_THREADS) == 0) {
+            unsigned long long count;
+            if (i + 1 >= argc || !app_parse_count(argv[++i], &count) ||
+                count == 0 || count > POOL_MAX_THREADS) {
+                return APP_ERROR_INIT;
+            }
+            options->pool.threads = (size_t)count;
+        } else if (strcmp(argv[i], APP_FLAG_PIN_THREADS) == 0) {
+            options->pool.pin = true;
+        } else if (strcmp(argv[i], APP_FLAG_HELP) == 0) {
+            options->mode = APP_MODE_HELP;
+        } else {
+            return APP_ERROR_INIT;
+        }
+    }
+    
+    // --csv takes its expression from --expr, in either order
+    if (options->csv_path != NULL && options->mode != APP_MODE_HELP) {
+        if (options->expression == NULL) {
+            return APP_ERROR_INIT;
+        }
+        options->mode = APP_MODE_CSV;
+    }
+    
+    return APP_SUCCESS;
+}
+
+app_result_t app_run_batch(const app_options_t *options) {
+    if (options == NULL || options->batch_path == NULL) {
+        return APP_ERROR_INIT;
+    }
+    
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "❌ Error: Calculator initialization failed\n");
+        return APP_ERROR_INIT;
+    }
+    
+    batch_result_t batch_result = batch_mode_run_file(options->batch_path, STDOUT_FILENO,
+                                                     &options->flush_policy, NULL);
+    calculator_cleanup();
+    
+    if (batch_result != BATCH_SUCCESS) {
+        fprintf(stderr, "❌ Error: Batch run failed on '%s' (Code: %d)\n",
+                options->batch_path, batch_result);
+        return (batch_result == BATCH_ERROR_MEMORY) ? APP_ERROR_MEMORY : APP_ERROR_RUNTIME;
+    }
+    
+    return APP_SUCCESS;
+}
+
+app_result_t app_run_expression(const app_options_t *options) {
+    if (options == NULL || options->expression == NULL) {
+        return APP_ERROR_INIT;
+    }
+    
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "❌ Error: Calculator initialization failed\n");
+        return APP_ERROR_INIT;
+    }
+    
+    arena_t arena;
+    expr_t expr;
+    double value;
+    arena_init(&arena, 0, 0);
+    expr_result_t parse_result = expr_parse(options->expression, strlen(options->expression), &arena, &expr);
+    if (parse_result != EXPR_SUCCESS) {
+        fprintf(stderr, "❌ Error: Expression %s error at column %zu\n",
+                expr_result_name(parse_result), expr.error_offset + 1);
+        arena_destroy(&arena);
+        calculator_cleanup();
+        return (parse_result == EXPR_ERROR_MEMORY) ? APP_ERROR_MEMORY : APP_ERROR_RUNTIME;
+    }
+    
+    calc_result_t calc_result = expr_evaluate(&expr, &value);
+    arena_destroy(&arena);
+    calculator_cleanup();
+    if (calc_result != CALC_SUCCESS) {
+        fprintf(stderr, "❌ Error: Evaluation failed (%s)\n", calculator_result_name(calc_result));
+        return APP_ERROR_RUNTIME;
+    }
+    
+    output_writer_t *screen = output_stdout();
+    output_double(screen, value);
+    output_write(screen, "\n", 1);
+    return (output_flush(screen) == OUTPUT_SUCCESS) ? APP_SUCCESS : APP_ERROR_RUNTIME;
+}
+
+app_result_t app_run_csv(const app_options_t *options) {
+    if (options == NULL || options->csv_path == NULL || options->expression == NULL) {
+        return APP_ERROR_INIT;
+    }
+    
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "❌ Error: Calculator initialization failed\n");
+        return APP_ERROR_INIT;
+    }
+    
+    arena_t arena;
+    expr_t expr;
+    vm_program_t program;
+    arena_init(&arena, 0, 0);
+    expr_result_t parse_result = expr_parse(options->expression, strlen(options->expression), &arena, &expr);
+    if (parse_result != EXPR_SUCCESS) {
+        fprintf(stderr, "❌ Error: Expression %s error at column %zu\n",
+                expr_result_name(parse_result), expr.error_offset + 1);
+        arena_destroy(&arena);
+        calculator_cleanup();
+        return (parse_result == EXPR_ERROR_MEMORY) ? APP_ERROR_MEMORY : APP_ERROR_RUNTIME;
+    }
+    vm_result_t compile_result = vm_compile(&expr, &arena, &program);
+    if (compile_result != VM_SUCCESS) {
+        fprintf(stderr, "❌ Error: Expression could not be compiled (Code: %d)\n", compile_result);
+        arena_destroy(&arena);
+        calculator_cleanup();
+        return (compile_result == VM_ERROR_MEMORY) ? APP_ERROR_MEMORY : APP_ERROR_RUNTIME;
+    }
+    
+    int input_fd = STDIN_FILENO;
+    int output_fd = STDOUT_FILENO;
+    if (strcmp(options->csv_path, BATCH_STDIN_PATH) != 0) {
+        input_fd = open(options->csv_path, O_RDONLY);
+    }
+    if (input_fd >= 0 && options->out_path != NULL) {
+        output_fd = open(options->out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    
+    csv_result_t csv_result = CSV_ERROR_IO;
+    if (input_fd >= 0 && output_fd >= 0) {
+        // Our own stdout writer may hold text that belongs before the rows
+        output_flush(output_stdout());
+        csv_result = csv_evaluate(input_fd, output_fd, &program, options->csv_header, NULL);
+    }
+    if (input_fd > STDIN_FILENO) {
+        close(input_fd);
+    }
+    if (output_fd > STDERR_FILENO) {
+        close(output_fd);
+    }
+    arena_destroy(&arena);
+    calculator_cleanup();
+    
+    if (csv_result != CSV_SUCCESS) {
+        fprintf(stderr, "❌ Error: CSV run failed on '%s' (%s)\n", options->csv_path, csv_result_name(csv_result));
+        return (csv_result == CSV_ERROR_MEMORY) ? APP_ERROR_MEMORY : APP_ERROR_RUNTIME;
+    }
+    return APP_SUCCESS;
+}
+
+app_result_t app_run_columnar(const app_options_t *options) {
+    if (options == NULL || options->columnar_path == NULL ||
+        (options->mode == APP_MODE_CONVERT && options->batch_path == NULL)) {
+        return APP_ERROR_INIT;
+    }
+    
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "❌ Error: Calculator initialization failed\n");
+        return APP_ERROR_INIT;
+    }
+    
+    output_writer_t *screen = output_stdout();
+    columnar_result_t columnar_result;
+    if (options->mode == APP_MODE_CONVERT) {
+        size_t rows;
+        columnar_result = columnar_convert_text(options->batch_path, options->columnar_path, &rows);
+        if (columnar_result == COLUMNAR_SUCCESS) {
+            output_printf(screen, "rows: %zu\n", rows);
+        }
+    } else {
+        columnar_file_t file;
+        calc_batch_summary_t summary;
+        columnar_result = columnar_open(options->columnar_path, true, &file);
+        if (columnar_result == COLUMNAR_SUCCESS) {
+            columnar_result = columnar_evaluate(&file, &summary);
+            output_printf(screen, "rows: %zu\nfailed: %zu\n", file.rows, summary.failed);
+            if (calculator_get_denormal_mode() == CALC_DENORMAL_MODE_FLUSH) {
+                output_printf(screen, "flushed: %zu\n", summary.flushed);
+            }
+            columnar_close(&file);
+        }
+    }
+    calculator_cleanup();
+    
+    if (columnar_result != COLUMNAR_SUCCESS) {
+        fprintf(stderr, "❌ Error: Columnar run failed on '%s' (Code: %d)\n",
+                options->columnar_path, columnar_result);
+        return APP_ERROR_RUNTIME;
+    }
+    return (output_flush(screen) == OUTPUT_SUCCESS) ? APP_SUCCESS : APP_ERROR_RUNTIME;
+}
+
 // ==========================================
 // MARK: - Application Lifecycle
 // ==========================================
@@ -68,6 +391,7 @@ app_result_t app_initialize(void) {
     // Initialize calculator subsystem
     calc_result_t calc_init_result = calculator_initialize();
     if (calc_init_result != CALC_SUCCESS) {
+        output_flush(output_stdout());
         fprintf(stderr, "❌ Error: Calculator initialization failed\n");
         return APP_ERROR_INIT;
     }
@@ -75,15 +399,17 @@ app_result_t app_initialize(void) {
     // Initialize menu subsystem
     menu_result_t menu_init_result = menu_initialize();
     if (menu_init_result != MENU_SUCCESS) {
+        output_flush(output_stdout());
         fprintf(stderr, "❌ Error: Menu initialization failed\n");
         calculator_cleanup();
         return APP_ERROR_INIT;
     }
     
-    printf("✅ All subsystems initialized successfully!\n");
-    printf("Press Enter to continue to main menu...");
-    getchar();
-    printf("\n");
+    output_puts(output_stdout(),
+                "✅ All subsystems initialized successfully!\n"
+                "Press Enter to continue to main menu...");
+    menu_clear_input_buffer();
+    output_puts(output_stdout(), "\n");
     
     return APP_SUCCESS;
 }
@@ -91,13 +417,20 @@ app_result_t app_initialize(void) {
 app_result_t app_run_main_loop(void) {
     bool application_running = true;
     menu_choice_t user_choice;
+    output_writer_t *screen = output_stdout();
     
     while (application_running) {
         // Display menu and get user choice
         menu_result_t menu_result = menu_display_and_get_choice(&user_choice);
         
+        // Input closed (e.g. end of a pipe): leave like the Exit choice
+        if (menu_result == MENU_ERROR_IO) {
+            output_puts(screen, "\n");
+            break;
+        }
+        
         if (menu_result != MENU_SUCCESS) {
-            printf("❌ Menu error occurred. Please try again.\n\n");
+            output_puts(screen, "❌ Menu error occurred. Please try again.\n\n");
             continue;
         }
         
@@ -112,20 +445,26 @@ app_result_t app_run_main_loop(void) {
                 menu_handle_calculation(user_choice);
                 break;
                 
+            case MENU_CHOICE_EXPRESSION:
+                if (menu_handle_expression() == MENU_ERROR_MEMORY) {
+                    return APP_ERROR_MEMORY;
+                }
+                break;
+                
             case MENU_CHOICE_EXIT:
                 application_running = false;
                 break;
                 
             default:
-                printf("❌ Internal Error: Invalid menu choice received\n");
+                output_puts(screen, "❌ Internal Error: Invalid menu choice received\n");
                 break;
         }
         
         // Pause before next iteration (unless exiting)
         if (application_running) {
-            printf("\nPress Enter to continue...");
-            getchar();
-            printf("\n");
+            output_puts(screen, "\nPress Enter to continue...");
+            menu_clear_input_buffer();
+            output_puts(screen, "\n");
         }
     }
     
@@ -135,7 +474,8 @@ app_result_t app_run_main_loop(void) {
 void app_cleanup(void) {
     calculator_cleanup();
     menu_cleanup();
-    printf("🧹 Application cleanup completed.\n");
+    pool_shutdown();
+    output_puts(output_stdout(), "🧹 Application cleanup completed.\n");
 }
 
 // ==========================================
@@ -143,22 +483,58 @@ void app_cleanup(void) {
 // ==========================================
 
 void app_display_welcome(void) {
-    printf("\n");
-    printf("🎉 Welcome to %s v%s! 🎉\n", APP_NAME, APP_VERSION);
-    printf("═════════════════════════════════════════════════════════════════════\n");
-    printf("👨‍💻 Crafted with ❤️  by %s on %s\n", APP_AUTHOR, APP_DATE);
-    printf("🏆 Designed to deliver fast, reliable, and precise calculations\n");
-    printf("🚀 Whether you're a student, engineer, or enthusiast — this is for YOU!\n");
-    printf("📈 Packed with essential operations and clean CLI interface\n");
-    printf("═════════════════════════════════════════════════════════════════════\n");
+    static const char welcome[] =
+        "\n"
+        "🎉 Welcome to " APP_NAME " v" APP_VERSION "! 🎉\n"
+        "═════════════════════════════════════════════════════════════════════\n"
+        "👨‍💻 Crafted with ❤️  by " APP_AUTHOR " on " APP_DATE "\n"
+        "🏆 Designed to deliver fast, reliable, and precise calculations\n"
+        "🚀 Whether you're a student, engineer, or enthusiast — this is for YOU!\n"
+        "📈 Packed with essential operations and clean CLI interface\n"
+        "═════════════════════════════════════════════════════════════════════\n";
+    
+    output_write(output_stdout(), welcome, sizeof(welcome) - 1);
+}
+
+void app_display_usage(const char *program) {
+    output_writer_t *screen = output_stdout();
+    
+    output_printf(screen, "Usage: %s [%s <file> [%s <n>] [%s <n>] | %s <text> | %s <file> | %s <text> <file>]\n"
+                  "       [%s <file> %s <text> [%s <file>] [%s]] [%s <n>] [%s] [%s]\n", program,
+                  APP_FLAG_BATCH, APP_FLAG_FLUSH_RECORDS, APP_FLAG_FLUSH_US, APP_FLAG_EXPR,
+                  APP_FLAG_COLUMNAR, APP_FLAG_TO_COLUMNAR, APP_FLAG_CSV, APP_FLAG_EXPR, APP_FLAG_OUT,
+                  APP_FLAG_CSV_HEADER, APP_FLAG_THREADS, APP_FLAG_PIN_THREADS, APP_FLAG_HELP);
+    output_puts(screen,
+        "  (no arguments)     Start the interactive calculator menu\n"
+        "  " APP_FLAG_BATCH " <file>     Evaluate one operation per line, e.g. \"add 1.5 2\"\n"
+        "                     (use - for stdin); prints one result per line\n"
+        "  " APP_FLAG_EXPR " <text>      Evaluate one expression, e.g. \"(1 + 2) * 3 ^ 2\"\n"
+        "  " APP_FLAG_CSV " <file> " APP_FLAG_EXPR " <text>\n"
+        "                     Evaluate the expression for every CSV row (colN = field N) and\n"
+        "                     append result,error fields; " APP_FLAG_OUT " <file> instead of stdout,\n"
+        "                     " APP_FLAG_CSV_HEADER " when the first row holds column names\n"
+        "  " APP_FLAG_COLUMNAR " <file>  Evaluate a columnar file, writing its result and error columns\n"
+        "  " APP_FLAG_TO_COLUMNAR " <text> <file>\n"
+        "                     Convert an operations file to a columnar file\n"
+        "  " APP_FLAG_FLUSH_RECORDS " <n>  Batch: flush output after every n results\n"
+        "  " APP_FLAG_FLUSH_US " <n>     Batch: flush output once results are n microseconds old\n"
+        "  " APP_FLAG_THREADS " <n>      Run array work on n threads (default: $" POOL_THREADS_ENV " or one per CPU)\n"
+        "  " APP_FLAG_PIN_THREADS "      Pin worker threads to CPUs (also $" POOL_PIN_ENV "=1)\n"
+        "  " APP_FLAG_HELP "             Show this help\n");
+    output_flush(screen);
 }
 
 void app_display_goodbye(void) {
-    printf("\n");
-    printf("════════════════════════════════════════════════════════\n");
-    printf("🙏 Thank you for using %s v%s!\n", APP_NAME, APP_VERSION);
-    printf("💫 Hope it made your calculations easier and more efficient!\n");
-    printf("🚀 Built with precision, designed for excellence.\n");
-    printf("════════════════════════════════════════════════════════\n");
-    printf("👋 Goodbye! Come back anytime for more calculations! 😊\n\n");
+    static const char goodbye[] =
+        "\n"
+        "════════════════════════════════════════════════════════\n"
+        "🙏 Thank you for using " APP_NAME " v" APP_VERSION "!\n"
+        "💫 Hope it made your calculations easier and more efficient!\n"
+        "🚀 Built with precision, designed for excellence.\n"
+        "════════════════════════════════════════════════════════\n"
+        "👋 Goodbye! Come back anytime for more calculations! 😊\n\n";
+    output_writer_t *screen = output_stdout();
+    
+    output_write(screen, goodbye, sizeof(goodbye) - 1);
+    output_flush(screen);
 }
@@ -13,20 +13,60 @@
  */
 
 #include "menu.h"
+#include "arena.h"
 #include "calculator.h"
+#include "calculator_inline.h"
+#include "expr.h"
+#include "format.h"
+#include "output.h"
+#include "parser.h"
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+
+// ==========================================
+// MARK: - Menu State
+// ==========================================
+
+/** Line reader over standard input and its window */
+static parser_reader_t menu_input_reader;
+static char menu_input_buffer[MENU_INPUT_BUFFER_SIZE];
+
+/** Arena for expressions; reset after every expression */
+static arena_t menu_arena;
 
 // ==========================================
 // MARK: - Menu Lifecycle
 // ==========================================
 
 menu_result_t menu_initialize(void) {
-    // Menu subsystem is stateless, no initialization required
+    if (parser_reader_init(&menu_input_reader, STDIN_FILENO,
+                           menu_input_buffer, sizeof(menu_input_buffer)) != PARSER_SUCCESS) {
+        return MENU_ERROR_INIT;
+    }
+    arena_init(&menu_arena, MENU_ARENA_BLOCK_SIZE, 0);
     return MENU_SUCCESS;
 }
 
 void menu_cleanup(void) {
-    // Menu subsystem is stateless, no cleanup required
+    // Input window is static; only the expression arena owns heap blocks
+    arena_destroy(&menu_arena);
+}
+
+/**
+ * @brief Read the next input line
+ * @details Flushes the screen rendered so far first, so each screen leaves
+ *          in a single write() right before the menu waits for input.
+ */
+static menu_result_t menu_read_line(const char **line, size_t *length) {
+    output_flush(output_stdout());
+
+    switch (parser_reader_next_line(&menu_input_reader, line, length)) {
+        case PARSER_SUCCESS:        return MENU_SUCCESS;
+        case PARSER_ERROR_OVERLONG: return MENU_ERROR_INVALID_INPUT;
+        default:                    return MENU_ERROR_IO;
+    }
 }
 
 // ==========================================
@@ -43,21 +83,25 @@ menu_result_t menu_display_and_get_choice(menu_choice_t *choice) {
 }
 
 void menu_display_main_menu(void) {
-    printf("┌─────────────────────────────────────────┐\n");
-    printf("│           🧮 CALCULATOR MENU 🧮         │\n");
-    printf("├─────────────────────────────────────────┤\n");
-    printf("│                                         │\n");
-    printf("│  1. ➕ Addition       (a + b)           │\n");
-    printf("│  2. ➖ Subtraction    (a - b)           │\n");
-    printf("│  3. ✖️  Multiplication (a × b)          │\n");
-    printf("│  4. ➗ Division       (a ÷ b)           │\n");
-    printf("│  5. %% Modulus        (a %% b)          │\n");
-    printf("│  6. ^ Power          (a ^ b)            │\n");
-    printf("│  7. 👋 Exit Application                 │\n");
-    printf("│                                         │\n");
-    printf("└─────────────────────────────────────────┘\n");
-    printf("💡 Tip: Choose 1-6 for calculations, 7 to exit\n");
-    printf("Enter your choice (1-7): ");
+    static const char main_menu[] =
+        "┌─────────────────────────────────────────┐\n"
+        "│           🧮 CALCULATOR MENU 🧮         │\n"
+        "├─────────────────────────────────────────┤\n"
+        "│                                         │\n"
+        "│  1. ➕ Addition       (a + b)           │\n"
+        "│  2. ➖ Subtraction    (a - b)           │\n"
+        "│  3. ✖️  Multiplication (a × b)          │\n"
+        "│  4. ➗ Division       (a ÷ b)           │\n"
+        "│  5. % Modulus        (a % b)          │\n"
+        "│  6. ^ Power          (a ^ b)            │\n"
+        "│  7. 🧾 Expression     ((a + b) * c ^ d) │\n"
+        "│  8. 👋 Exit Application                 │\n"
+        "│                                         │\n"
+        "└─────────────────────────────────────────┘\n"
+        "💡 Tip: Choose 1-7 for calculations, 8 to exit\n"
+        "Enter your choice (1-8): ";
+    
+    output_write(output_stdout(), main_menu, sizeof(main_menu) - 1);
 }
 
 menu_result_t menu_get_user_input(menu_choice_t *choice) {
@@ -65,18 +109,25 @@ menu_result_t menu_get_user_input(menu_choice_t *choice) {
         return MENU_ERROR_INVALID_INPUT;
     }
     
+    const char *line;
+    size_t length;
     int input;
-    if (scanf("%d", &input) != 1) {
-        menu_clear_input_buffer();
-        *choice = MENU_CHOICE_INVALID;
-        return MENU_ERROR_INVALID_INPUT;
+    
+    *choice = MENU_CHOICE_INVALID;
+    
+    menu_result_t read_result = menu_read_line(&line, &length);
+    if (read_result != MENU_SUCCESS) {
+        return read_result;
     }
     
-    menu_clear_input_buffer();
+    const char *end = line + length;
+    const char *cursor = parser_parse_int(parser_skip_blanks(line, end), end, &input);
+    if (cursor == NULL || parser_skip_blanks(cursor, end) != end) {
+        return MENU_ERROR_INVALID_INPUT;
+    }
     
     // Validate input range
     if (input < MENU_MIN_CHOICE || input > MENU_MAX_CHOICE) {
-        *choice = MENU_CHOICE_INVALID;
         return MENU_ERROR_INVALID_INPUT;
     }
     
@@ -90,20 +141,22 @@ menu_result_t menu_get_user_input(menu_choice_t *choice) {
 
 menu_result_t menu_handle_calculation(menu_choice_t operation) {
     double operand1, operand2, result;
+    int64_t remainder = 0;
     calc_result_t calc_result;
+    char text1[FORMAT_BUFFER_SIZE], text2[FORMAT_BUFFER_SIZE], text_result[FORMAT_BUFFER_SIZE];
+    output_writer_t *screen = output_stdout();
     
-    printf("\n");
-    printf("🔢 %s Operation\n", menu_choice_to_string(operation));
-    printf("────────────────────────────────\n");
+    output_printf(screen, "\n🔢 %s Operation\n────────────────────────────────\n",
+                  menu_choice_to_string(operation));
     
     // Get operands from user
     if (menu_get_numeric_input("Enter first number: ", &operand1) != MENU_SUCCESS) {
-        printf("❌ Invalid first number. Operation cancelled.\n");
+        output_puts(screen, "❌ Invalid first number. Operation cancelled.\n");
         return MENU_ERROR_INVALID_INPUT;
     }
     
     if (menu_get_numeric_input("Enter second number: ", &operand2) != MENU_SUCCESS) {
-        printf("❌ Invalid second number. Operation cancelled.\n");
+        output_puts(screen, "❌ Invalid second number. Operation cancelled.\n");
         return MENU_ERROR_INVALID_INPUT;
     }
     
@@ -122,56 +175,56 @@ menu_result_t menu_handle_calculation(menu_choice_t operation) {
             calc_result = calculator_divide(operand1, operand2, &result);
             break;
         case MENU_CHOICE_MODULUS:
-            calc_result = calculator_modulus((int)operand1, (int)operand2, &result);
+            calc_result = calculator_inline_modulus_truncated_i64(operand1, operand2, &remainder);
             break;
         case MENU_CHOICE_POWER:
             calc_result = calculator_power(operand1, operand2, &result);
             break;
         default:
-            printf("❌ Internal Error: Invalid operation\n");
+            output_puts(screen, "❌ Internal Error: Invalid operation\n");
             return MENU_ERROR_INVALID_INPUT;
     }
     
     // Display result
     if (calc_result == CALC_SUCCESS) {
-        printf("\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|");
-        printf("\n| 🎉 Result: ");
         if (operation == MENU_CHOICE_MODULUS) {
-            printf("%.0f %s %.0f = %.0f\n", operand1, 
-                   (operation == MENU_CHOICE_ADD) ? "+" :
-                   (operation == MENU_CHOICE_SUBTRACT) ? "-" :
-                   (operation == MENU_CHOICE_MULTIPLY) ? "×" :
-                   (operation == MENU_CHOICE_DIVIDE) ? "÷" :
-                   (operation == MENU_CHOICE_MODULUS) ? "%" : "^",
-                   operand2, result);
+            // Print the truncated operands exactly; doubles above 2^53 would round
+            snprintf(text1, sizeof(text1), "%" PRId64, (int64_t)operand1);
+            snprintf(text2, sizeof(text2), "%" PRId64, (int64_t)operand2);
+            snprintf(text_result, sizeof(text_result), "%" PRId64, remainder);
         } else {
-            printf("%.6g %s %.6g = %.6g\n", operand1,
-                   (operation == MENU_CHOICE_ADD) ? "+" :
-                   (operation == MENU_CHOICE_SUBTRACT) ? "-" :
-                   (operation == MENU_CHOICE_MULTIPLY) ? "×" :
-                   (operation == MENU_CHOICE_DIVIDE) ? "÷" :
-                   (operation == MENU_CHOICE_POWER) ? "^" : "?",
-                   operand2, result);
+            format_double_general(operand1, FORMAT_DISPLAY_PRECISION, text1);
+            format_double_general(operand2, FORMAT_DISPLAY_PRECISION, text2);
+            format_double_general(result, FORMAT_DISPLAY_PRECISION, text_result);
         }
-        printf("| ✅ Calculation completed successfully!      ");
-        printf("\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|");
+        output_printf(screen,
+                      "\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|"
+                      "\n| 🎉 Result: %s %s %s = %s\n"
+                      "| ✅ Calculation completed successfully!      "
+                      "\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|", text1,
+                      (operation == MENU_CHOICE_ADD) ? "+" :
+                      (operation == MENU_CHOICE_SUBTRACT) ? "-" :
+                      (operation == MENU_CHOICE_MULTIPLY) ? "×" :
+                      (operation == MENU_CHOICE_DIVIDE) ? "÷" :
+                      (operation == MENU_CHOICE_MODULUS) ? "%" : "^",
+                             text2, text_result);
     } else {
         // Handle calculation errors
         switch (calc_result) {
             case CALC_ERROR_DIVISION_BY_ZERO:
-                printf("❌ Error: Division by zero is not allowed!\n");
+                output_puts(screen, "❌ Error: Division by zero is not allowed!\n");
                 break;
             case CALC_ERROR_DOMAIN:
-                printf("❌ Error: Invalid domain for this operation!\n");
+                output_puts(screen, "❌ Error: Invalid domain for this operation!\n");
                 break;
             case CALC_ERROR_OVERFLOW:
-                printf("❌ Error: Result too large to represent!\n");
+                output_puts(screen, "❌ Error: Result too large to represent!\n");
                 break;
             case CALC_ERROR_UNDERFLOW:
-                printf("❌ Error: Result too small to represent!\n");
+                output_puts(screen, "❌ Error: Result too small to represent!\n");
                 break;
             default:
-                printf("❌ Error: Calculation failed with error code %d\n", calc_result);
+                output_printf(screen, "❌ Error: Calculation failed with error code %d\n", calc_result);
                 break;
         }
     }
@@ -179,6 +232,54 @@ menu_result_t menu_handle_calculation(menu_choice_t operation) {
     return MENU_SUCCESS;
 }
 
+menu_result_t menu_handle_expression(void) {
+    output_writer_t *screen = output_stdout();
+    const char *line;
+    size_t length;
+    expr_t expr;
+    double result;
+    char text_result[FORMAT_BUFFER_SIZE];
+    
+    output_puts(screen, "\n🧾 Expression\n────────────────────────────────\n"
+                        "Enter expression: ");
+    menu_result_t read_result = menu_read_line(&line, &length);
+    if (read_result != MENU_SUCCESS) {
+        output_puts(screen, "❌ Invalid expression. Operation cancelled.\n");
+        return read_result;
+    }
+    
+    // Each expression starts from an empty arena
+    arena_reset(&menu_arena);
+    expr_result_t parse_result = expr_parse(line, length, &menu_arena, &expr);
+    if (parse_result == EXPR_ERROR_MEMORY) {
+        output_puts(screen, "❌ Error: Out of memory for expression\n");
+        return MENU_ERROR_MEMORY;
+    }
+    if (parse_result != EXPR_SUCCESS) {
+        output_printf(screen, "❌ Error: %s at column %zu\n",
+                      (parse_result == EXPR_ERROR_TOO_COMPLEX) ? "Expression too complex" : "Syntax error",
+                      expr.error_offset + 1);
+        return MENU_ERROR_INVALID_INPUT;
+    }
+    
+    calc_result_t calc_result = expr_evaluate(&expr, &result);
+    if (calc_result != CALC_SUCCESS) {
+        output_printf(screen, "❌ Error: Evaluation failed (%s)\n", calculator_result_name(calc_result));
+        return MENU_SUCCESS;
+    }
+    
+    // Echo the expression as typed, without leading blanks
+    const char *shown = parser_skip_blanks(line, line + length);
+    format_double_general(result, FORMAT_DISPLAY_PRECISION, text_result);
+    output_printf(screen,
+                  "\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|"
+                  "\n| 🎉 Result: %.*s = %s\n"
+                  "| ✅ Calculation completed successfully!      "
+                  "\n|━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━|",
+                  (int)(line + length - shown), shown, text_result);
+    return MENU_SUCCESS;
+}
+
 // ==========================================
 // MARK: - Utility Functions
 // ==========================================
@@ -188,22 +289,30 @@ menu_result_t menu_get_numeric_input(const char *prompt, double *value) {
         return MENU_ERROR_INVALID_INPUT;
     }
     
-    printf("%s", prompt);
+    output_puts(output_stdout(), prompt);
     
-    if (scanf("%lf", value) != 1) {
-        menu_clear_input_buffer();
+    const char *line;
+    size_t length;
+    menu_result_t read_result = menu_read_line(&line, &length);
+    if (read_result != MENU_SUCCESS) {
+        return read_result;
+    }
+    
+    const char *end = line + length;
+    const char *cursor = parser_parse_double(parser_skip_blanks(line, end), end, value);
+    if (cursor == NULL || parser_skip_blanks(cursor, end) != end) {
         return MENU_ERROR_INVALID_INPUT;
     }
     
-    menu_clear_input_buffer();
     return MENU_SUCCESS;
 }
 
 void menu_clear_input_buffer(void) {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF) {
-        // Clear buffer
-    }
+    const char *line;
+    size_t length;
+    
+    // Whole lines are consumed by the reader, so discarding means skipping one
+    (void)menu_read_line(&line, &length);
 }
 
 const char* menu_choice_to_string(menu_choice_t choice) {
@@ -214,6 +323,7 @@ const char* menu_choice_to_string(menu_choice_t choice) {
         case MENU_CHOICE_DIVIDE:   return "Division";
         case MENU_CHOICE_MODULUS:  return "Modulus";
         case MENU_CHOICE_POWER:    return "Power";
+        case MENU_CHOICE_EXPRESSION: return "Expression";
         case MENU_CHOICE_EXIT:     return "Exit";
         default:                   return "Unknown";
     }
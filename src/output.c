@@ -0,0 +1,264 @@
+// ==========================================
+// FILE: output.c
+// ==========================================
+/**
+ * @file output.c
+ * @brief Output subsystem implementation
+ * @details Implements the buffered writer: appends are plain memcpy or
+ *          in-place formatting, and every flush is a single write() or
+ *          writev() call unless the kernel accepts only part of it.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "output.h"
+#include "format.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+// ==========================================
+// MARK: - Output State
+// ==========================================
+
+/** Shared standard output writer and its buffer */
+static output_writer_t output_stdout_writer;
+static char output_stdout_buffer[OUTPUT_STDOUT_BUFFER_SIZE];
+static bool output_stdout_ready;
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static uint64_t output_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Write a vector of blocks completely
+ * @details Advances through the vector after partial writes; the common
+ *          case is one call.
+ */
+static output_result_t output_writev_all(int fd, struct iovec *parts, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, parts, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return OUTPUT_ERROR_IO;
+        }
+
+        size_t remaining = (size_t)written;
+        while (count > 0 && remaining >= parts->iov_len) {
+            remaining -= parts->iov_len;
+            parts++;
+            count--;
+        }
+        if (count > 0) {
+            parts->iov_base = (char *)parts->iov_base + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+    return OUTPUT_SUCCESS;
+}
+
+/** Write pending bytes followed by an extra block in one system call */
+static output_result_t output_flush_with(output_writer_t *writer, const char *data, size_t length) {
+    if (writer->failed) {
+        return OUTPUT_ERROR_IO;
+    }
+
+    struct iovec parts[2];
+    int count = 0;
+    if (writer->length > 0) {
+        parts[count].iov_base = writer->buffer;
+        parts[count].iov_len = writer->length;
+        count++;
+    }
+    if (length > 0) {
+        parts[count].iov_base = (void *)data;
+        parts[count].iov_len = length;
+        count++;
+    }
+
+    writer->length = 0;
+    writer->pending_records = 0;
+    if (output_writev_all(writer->fd, parts, count) != OUTPUT_SUCCESS) {
+        writer->failed = true;
+        return OUTPUT_ERROR_IO;
+    }
+    return OUTPUT_SUCCESS;
+}
+
+// ==========================================
+// MARK: - Writer Lifecycle
+// ==========================================
+
+output_result_t output_init(output_writer_t *writer, int fd, char *buffer, size_t capacity) {
+    if (writer == NULL || fd < 0 || buffer == NULL || capacity < OUTPUT_MIN_CAPACITY) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+
+    writer->fd = fd;
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+    writer->length = 0;
+    writer->policy.max_records = 0;
+    writer->policy.max_delay_us = 0;
+    writer->pending_records = 0;
+    writer->first_pending_ns = 0;
+    writer->failed = false;
+    return OUTPUT_SUCCESS;
+}
+
+void output_set_policy(output_writer_t *writer, const output_flush_policy_t *policy) {
+    if (writer == NULL) {
+        return;
+    }
+    if (policy == NULL) {
+        writer->policy.max_records = 0;
+        writer->policy.max_delay_us = 0;
+    } else {
+        writer->policy = *policy;
+    }
+}
+
+output_writer_t *output_stdout(void) {
+    if (!output_stdout_ready) {
+        output_init(&output_stdout_writer, STDOUT_FILENO,
+                    output_stdout_buffer, sizeof(output_stdout_buffer));
+        output_stdout_ready = true;
+    }
+    return &output_stdout_writer;
+}
+
+// ==========================================
+// MARK: - Appending
+// ==========================================
+
+output_result_t output_write(output_writer_t *writer, const char *data, size_t length) {
+    if (writer == NULL || (data == NULL && length > 0)) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+
+    if (length <= writer->capacity - writer->length) {
+        memcpy(writer->buffer + writer->length, data, length);
+        writer->length += length;
+        return OUTPUT_SUCCESS;
+    }
+
+    // Small blocks start the next buffer; large ones go out with the pending text
+    if (length < writer->capacity / 2) {
+        if (output_flush_with(writer, NULL, 0) != OUTPUT_SUCCESS) {
+            return OUTPUT_ERROR_IO;
+        }
+        memcpy(writer->buffer, data, length);
+        writer->length = length;
+        return OUTPUT_SUCCESS;
+    }
+    return output_flush_with(writer, data, length);
+}
+
+output_result_t output_puts(output_writer_t *writer, const char *text) {
+    if (text == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+    return output_write(writer, text, strlen(text));
+}
+
+output_result_t output_printf(output_writer_t *writer, const char *format, ...) {
+    if (writer == NULL || format == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+
+    va_list args;
+    size_t available = writer->capacity - writer->length;
+
+    va_start(args, format);
+    int needed = vsnprintf(writer->buffer + writer->length, available, format, args);
+    va_end(args);
+    if (needed < 0) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+    if ((size_t)needed < available) {
+        writer->length += (size_t)needed;
+        return OUTPUT_SUCCESS;
+    }
+
+    // Did not fit: format into a temporary block and append that
+    char *text = malloc((size_t)needed + 1);
+    if (text == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+    va_start(args, format);
+    vsnprintf(text, (size_t)needed + 1, format, args);
+    va_end(args);
+
+    output_result_t result = output_write(writer, text, (size_t)needed);
+    free(text);
+    return result;
+}
+
+output_result_t output_double(output_writer_t *writer, double value) {
+    if (writer == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+    if (writer->capacity - writer->length < FORMAT_BUFFER_SIZE &&
+        output_flush_with(writer, NULL, 0) != OUTPUT_SUCCESS) {
+        return OUTPUT_ERROR_IO;
+    }
+
+    // The formatter NUL-terminates; the terminator is overwritten by the next append
+    writer->length += format_double_shortest(value, writer->buffer + writer->length);
+    return OUTPUT_SUCCESS;
+}
+
+// ==========================================
+// MARK: - Flushing
+// ==========================================
+
+output_result_t output_end_record(output_writer_t *writer) {
+    if (writer == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+
+    const output_flush_policy_t *policy = &writer->policy;
+    if (policy->max_records == 0 && policy->max_delay_us == 0) {
+        return OUTPUT_SUCCESS;
+    }
+
+    writer->pending_records++;
+    if (policy->max_records != 0 && writer->pending_records >= policy->max_records) {
+        return output_flush_with(writer, NULL, 0);
+    }
+    if (policy->max_delay_us != 0) {
+        uint64_t now = output_now_ns();
+        if (writer->pending_records == 1) {
+            writer->first_pending_ns = now;
+        }
+        if (now - writer->first_pending_ns >= policy->max_delay_us * 1000u) {
+            return output_flush_with(writer, NULL, 0);
+        }
+    }
+    return OUTPUT_SUCCESS;
+}
+
+output_result_t output_flush(output_writer_t *writer) {
+    if (writer == NULL) {
+        return OUTPUT_ERROR_INVALID_INPUT;
+    }
+    if (writer->length == 0) {
+        writer->pending_records = 0;
+        return writer->failed ? OUTPUT_ERROR_IO : OUTPUT_SUCCESS;
+    }
+    return output_flush_with(writer, NULL, 0);
+}
@@ -0,0 +1,587 @@
+// ==========================================
+// FILE: parser.c
+// ==========================================
+/**
+ * @file parser.c
+ * @brief Parser subsystem implementation
+ * @details Implements the buffered line reader and the number parsers. The
+ *          double parser follows Lemire, "Number Parsing at a Gigabyte per
+ *          Second" (2021): up to 19 significant digits are gathered into a
+ *          64-bit mantissa and converted with a single 64x128-bit product.
+ *          Inputs with more digits are resolved by converting both bounds of
+ *          the truncated mantissa; only when those disagree does the parser
+ *          defer to strtod().
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "parser.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** Truncated 128-bit powers of five, 5^PARSER_POW5_MIN .. 5^PARSER_POW5_MAX (parser_pow5.c) */
+extern const uint64_t parser_pow5_table[2 * (PARSER_POW5_MAX - PARSER_POW5_MIN + 1)];
+
+/**
+ * Significant digits the strtod() fallback keeps. The exact decimal value
+ * of a halfway point between two doubles has at most 768 of them, so the
+ * digits past this one only decide rounding through being nonzero.
+ */
+#define PARSER_FALLBACK_DIGITS 800
+
+// ==========================================
+// MARK: - Line Reader
+// ==========================================
+
+parser_result_t parser_reader_init(parser_reader_t *reader, int fd, char *buffer, size_t capacity) {
+    if (reader == NULL || buffer == NULL || capacity == 0) {
+        return PARSER_ERROR_INVALID_INPUT;
+    }
+
+    reader->fd = fd;
+    reader->buffer = buffer;
+    reader->capacity = capacity;
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = false;
+    reader->skipping = false;
+
+    return PARSER_SUCCESS;
+}
+
+parser_result_t parser_reader_next_line(parser_reader_t *reader, const char **line, size_t *length) {
+    if (reader == NULL || line == NULL || length == NULL) {
+        return PARSER_ERROR_INVALID_INPUT;
+    }
+
+    for (;;) {
+        char *start = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        char *newline = memchr(start, '\n', available);
+
+        if (newline != NULL) {
+            reader->start += (size_t)(newline - start) + 1;
+            if (reader->skipping) {
+                reader->skipping = false;
+                return PARSER_ERROR_OVERLONG;
+            }
+            *line = start;
+            *length = (size_t)(newline - start);
+            if (*length > 0 && start[*length - 1] == '\r') {
+                (*length)--;
+            }
+            return PARSER_SUCCESS;
+        }
+
+        if (reader->eof) {
+            reader->start = reader->end;
+            if (reader->skipping) {
+                reader->skipping = false;
+                return PARSER_ERROR_OVERLONG;
+            }
+            if (available == 0) {
+                return PARSER_ERROR_EOF;
+            }
+            *line = start;
+            *length = available;
+            return PARSER_SUCCESS;
+        }
+
+        // Move the partial line to the front of the window, or drop it if
+        // it already fills the window
+        if (reader->skipping || available == reader->capacity) {
+            reader->skipping = true;
+            reader->start = 0;
+            reader->end = 0;
+        } else if (reader->start > 0) {
+            memmove(reader->buffer, start, available);
+            reader->start = 0;
+            reader->end = available;
+        }
+
+        ssize_t received = read(reader->fd, reader->buffer + reader->end,
+                                reader->capacity - reader->end);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return PARSER_ERROR_IO;
+        }
+        if (received == 0) {
+            reader->eof = true;
+        }
+        reader->end += (size_t)received;
+    }
+}
+
+// ==========================================
+// MARK: - Mapped Input
+// ==========================================
+
+parser_result_t parser_map_open(parser_map_t *map, int fd) {
+    struct stat info;
+
+    if (map == NULL) {
+        return PARSER_ERROR_INVALID_INPUT;
+    }
+    map->data = NULL;
+    map->size = 0;
+    map->released = 0;
+
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || (uintmax_t)info.st_size > SIZE_MAX) {
+        return PARSER_ERROR_IO;
+    }
+    if (info.st_size == 0) {
+        return PARSER_SUCCESS;
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return PARSER_ERROR_IO;
+    }
+    // Advice only: a kernel that ignores it just reads ahead less
+    madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    map->data = data;
+    map->size = (size_t)info.st_size;
+    return PARSER_SUCCESS;
+}
+
+void parser_map_release(parser_map_t *map, size_t offset) {
+    if (map == NULL || map->data == NULL) {
+        return;
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = (offset < map->size ? offset : map->size) / page * page;
+    if (end > map->released) {
+        madvise((char *)map->data + map->released, end - map->released, MADV_DONTNEED);
+        map->released = end;
+    }
+}
+
+void parser_map_close(parser_map_t *map) {
+    if (map == NULL) {
+        return;
+    }
+    if (map->data != NULL) {
+        munmap((void *)map->data, map->size);
+    }
+    map->data = NULL;
+    map->size = 0;
+    map->released = 0;
+}
+
+parser_result_t parser_span_init(parser_span_t *span, const char *begin, const char *end,
+                                 size_t max_length) {
+    if (span == NULL || (begin == NULL && end != NULL) || end < begin || max_length == 0) {
+        return PARSER_ERROR_INVALID_INPUT;
+    }
+
+    span->cursor = begin;
+    span->end = end;
+    span->max_length = max_length;
+    return PARSER_SUCCESS;
+}
+
+parser_result_t parser_span_next_line(parser_span_t *span, const char **line, size_t *length) {
+    if (span == NULL || line == NULL || length == NULL) {
+        return PARSER_ERROR_INVALID_INPUT;
+    }
+    if (span->cursor == span->end) {
+        return PARSER_ERROR_EOF;
+    }
+
+    const char *start = span->cursor;
+    size_t available = (size_t)(span->end - start);
+    const char *newline = memchr(start, '\n', available);
+    size_t line_length = (newline != NULL) ? (size_t)(newline - start) : available;
+
+    span->cursor = (newline != NULL) ? newline + 1 : span->end;
+    // Same limit as a reader whose window is max_length bytes
+    if (line_length >= span->max_length) {
+        return PARSER_ERROR_OVERLONG;
+    }
+
+    *line = start;
+    *length = line_length;
+    if (newline != NULL && line_length > 0 && start[line_length - 1] == '\r') {
+        (*length)--;
+    }
+    return PARSER_SUCCESS;
+}
+
+// ==========================================
+// MARK: - Integer Parsing
+// ==========================================
+
+const char *parser_skip_blanks(const char *begin, const char *end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) {
+        begin++;
+    }
+    return begin;
+}
+
+const char *parser_parse_int(const char *begin, const char *end, int *value) {
+    const char *p = begin;
+    bool negative = false;
+    long long accumulator = 0;
+
+    if (begin == NULL || end == NULL || value == NULL) {
+        return NULL;
+    }
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    const char *digits = p;
+    while (p < end && *p >= '0' && *p <= '9') {
+        accumulator = accumulator * 10 + (*p - '0');
+        if (accumulator > (long long)INT_MAX + 1) {
+            return NULL;
+        }
+        p++;
+    }
+
+    if (p == digits) {
+        return NULL;
+    }
+    if (negative) {
+        accumulator = -accumulator;
+    }
+    if (accumulator > INT_MAX || accumulator < INT_MIN) {
+        return NULL;
+    }
+
+    *value = (int)accumulator;
+    return p;
+}
+
+// ==========================================
+// MARK: - Floating-Point Helpers
+// ==========================================
+
+/** 64x64 -> 128-bit multiply; returns the low half and stores the high half */
+static uint64_t parser_multiply_128(uint64_t a, uint64_t b, uint64_t *high) {
+#ifdef __SIZEOF_INT128__
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *high = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (uint32_t)lo_lo;
+#endif
+}
+
+static int parser_leading_zeros(uint64_t value) {
+    return __builtin_clzll(value);
+}
+
+static double parser_from_bits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Clinger's fast path: both w and 10^|q| are exact doubles
+ * @details Only valid when intermediate results are rounded to double,
+ *          which FLT_EVAL_METHOD == 0 guarantees.
+ */
+static bool parser_clinger(uint64_t w, int64_t q, bool negative, double *value) {
+#if FLT_EVAL_METHOD == 0
+    static const double exact_powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (w > ((uint64_t)1 << 53) || q < -22 || q > 22) {
+        return false;
+    }
+
+    double result = (double)w;
+    result = (q < 0) ? result / exact_powers[-q] : result * exact_powers[q];
+    *value = negative ? -result : result;
+    return true;
+#else
+    (void)w; (void)q; (void)negative; (void)value;
+    return false;
+#endif
+}
+
+/**
+ * @brief Eisel-Lemire conversion of w * 10^q to the nearest double
+ * @details Exact for any w below 10^19; see Mushtak & Lemire, "Fast Number
+ *          Parsing Without Fallback" (2023) for why no fallback is needed.
+ */
+static double parser_eisel_lemire(uint64_t w, int64_t q, bool negative) {
+    uint64_t sign = negative ? (uint64_t)1 << 63 : 0;
+
+    if (w == 0 || q < PARSER_POW5_MIN) {
+        return parser_from_bits(sign);
+    }
+    if (q > PARSER_POW5_MAX) {
+        return parser_from_bits(sign | 0x7FF0000000000000ULL);
+    }
+
+    int lz = parser_leading_zeros(w);
+    w <<= lz;
+
+    // w * 5^q to 128 bits; the second word only matters when the
+    // bits below the 55 we keep are all ones
+    size_t index = 2 * (size_t)(q - PARSER_POW5_MIN);
+    uint64_t high;
+    uint64_t low = parser_multiply_128(w, parser_pow5_table[index], &high);
+    if ((high & 0x1FF) == 0x1FF) {
+        uint64_t second_high;
+        (void)parser_multiply_128(w, parser_pow5_table[index + 1], &second_high);
+        low += second_high;
+        if (second_high > low) {
+            high++;
+        }
+    }
+
+    int upper_bit = (int)(high >> 63);
+    uint64_t mantissa = high >> (upper_bit + 9);
+    int64_t power2 = ((217706 * q) >> 16) + 63 + upper_bit - lz + 1023;
+
+    if (power2 <= 0) {
+        // Subnormal result, or zero
+        if (-power2 + 1 >= 64) {
+            return parser_from_bits(sign);
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = (mantissa < ((uint64_t)1 << 52)) ? 0 : 1;
+        return parser_from_bits(sign | ((uint64_t)power2 << 52) | mantissa);
+    }
+
+    // Exactly halfway between two doubles: round to even
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1) {
+        if ((mantissa << (upper_bit + 9)) == high) {
+            mantissa &= ~(uint64_t)1;
+        }
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= ((uint64_t)2 << 52)) {
+        mantissa = (uint64_t)1 << 52;
+        power2++;
+    }
+    mantissa &= ~((uint64_t)1 << 52);
+
+    if (power2 >= 0x7FF) {
+        return parser_from_bits(sign | 0x7FF0000000000000ULL);
+    }
+
+    return parser_from_bits(sign | ((uint64_t)power2 << 52) | mantissa);
+}
+
+/**
+ * @brief Rare path for more than 19 significant digits on a rounding boundary
+ * @details Rewrites the number as its first PARSER_FALLBACK_DIGITS
+ *          significant digits and a power of ten, with a trailing 1 standing
+ *          in for any nonzero digits dropped after them. That text rounds
+ *          like the original at any length, and without a decimal point
+ *          strtod() reads it the same in every locale.
+ */
+static double parser_fallback(const char *begin, const char *end) {
+    char text[PARSER_FALLBACK_DIGITS + 32];
+    const char *p = begin;
+    size_t length = 0;
+    size_t kept = 0;
+    int64_t exponent = 0;
+    bool fraction = false;
+    bool sticky = false;
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        text[length++] = *p++;
+    }
+
+    // text holds the kept digits; the value is those digits times 10^exponent
+    for (; p < end; p++) {
+        if (*p == '.') {
+            fraction = true;
+            continue;
+        }
+        if (*p < '0' || *p > '9') {
+            break;
+        }
+        if (kept == 0 && *p == '0') {
+            exponent -= fraction;
+        } else if (kept < PARSER_FALLBACK_DIGITS) {
+            text[length++] = *p;
+            kept++;
+            exponent -= fraction;
+        } else {
+            sticky |= (*p != '0');
+            exponent += !fraction;
+        }
+    }
+    if (kept == 0) {
+        text[length++] = '0';
+    }
+    if (sticky) {
+        text[length++] = '1';
+        exponent--;
+    }
+
+    // The explicit exponent, capped like parser_parse_double() caps it
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        bool exponent_negative = false;
+        int64_t explicit_exponent = 0;
+
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) {
+            exponent_negative = (*p == '-');
+            p++;
+        }
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            if (explicit_exponent < 100000) {
+                explicit_exponent = explicit_exponent * 10 + (*p - '0');
+            }
+        }
+        exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+    }
+
+    snprintf(text + length, sizeof(text) - length, "e%lld", (long long)exponent);
+    return strtod(text, NULL);
+}
+
+static bool parser_match_word(const char *p, const char *end, const char *word) {
+    size_t length = strlen(word);
+
+    if ((size_t)(end - p) < length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if ((p[i] | 0x20) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==========================================
+// MARK: - Floating-Point Parsing
+// ==========================================
+
+const char *parser_parse_double(const char *begin, const char *end, double *value) {
+    const char *p = begin;
+    bool negative = false;
+    uint64_t w = 0;
+    int64_t exponent = 0;
+    int significant = 0;
+    size_t digit_count = 0;
+    bool truncated = false;
+
+    if (begin == NULL || end == NULL || value == NULL) {
+        return NULL;
+    }
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    if (parser_match_word(p, end, "inf")) {
+        p += parser_match_word(p, end, "infinity") ? 8 : 3;
+        *value = negative ? -INFINITY : INFINITY;
+        return p;
+    }
+    if (parser_match_word(p, end, "nan")) {
+        *value = negative ? -NAN : NAN;
+        return p + 3;
+    }
+
+    // Integer digits: past 19 significant digits only the scale grows
+    while (p < end && *p >= '0' && *p <= '9') {
+        unsigned digit = (unsigned)(*p - '0');
+        if (significant < PARSER_MAX_DIGITS) {
+            w = w * 10 + digit;
+            significant += (w != 0);
+        } else {
+            exponent++;
+            truncated |= (digit != 0);
+        }
+        digit_count++;
+        p++;
+    }
+
+    // Fraction digits: past 19 significant digits they are dropped
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            unsigned digit = (unsigned)(*p - '0');
+            if (significant < PARSER_MAX_DIGITS) {
+                w = w * 10 + digit;
+                significant += (w != 0);
+                exponent--;
+            } else {
+                truncated |= (digit != 0);
+            }
+            digit_count++;
+            p++;
+        }
+    }
+
+    if (digit_count == 0) {
+        return NULL;
+    }
+
+    // Exponent, only if at least one digit follows the 'e'
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *e = p + 1;
+        bool exponent_negative = false;
+        int64_t explicit_exponent = 0;
+
+        if (e < end && (*e == '+' || *e == '-')) {
+            exponent_negative = (*e == '-');
+            e++;
+        }
+        if (e < end && *e >= '0' && *e <= '9') {
+            while (e < end && *e >= '0' && *e <= '9') {
+                if (explicit_exponent < 100000) {
+                    explicit_exponent = explicit_exponent * 10 + (*e - '0');
+                }
+                e++;
+            }
+            exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+            p = e;
+        }
+    }
+
+    if (!truncated && parser_clinger(w, exponent, negative, value)) {
+        return p;
+    }
+
+    // With dropped digits the value lies between w and w + 1; only when
+    // those round differently do the remaining digits matter
+    double result = parser_eisel_lemire(w, exponent, negative);
+    if (truncated && parser_eisel_lemire(w + 1, exponent, negative) != result) {
+        result = parser_fallback(begin, p);
+    }
+
+    *value = result;
+    return p;
+}
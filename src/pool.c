@@ -0,0 +1,478 @@
+// ==========================================
+// FILE: pool.c
+// ==========================================
+/**
+ * @file pool.c
+ * @brief Thread pool implementation
+ * @details Implements the work-stealing pool. Deques are short ring
+ *          buffers under a per-deque mutex: ranges are split lazily, so a
+ *          deque holds at most a few dozen entries and owners and thieves
+ *          rarely meet on the same lock. Idle workers sleep on a condition
+ *          variable between loops; inside one, a worker that finds nothing
+ *          to run parks on a second one until a range is published or the
+ *          loop's last unit is handled.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#define _GNU_SOURCE
+#include "pool.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ==========================================
+// MARK: - Pool Types
+// ==========================================
+
+/** One parallel_for call; lives on the submitting thread's stack */
+typedef struct {
+    pool_range_fn_t fn;
+    void *context;
+    size_t grain;
+    atomic_size_t pending;      ///< Units not yet handled
+} pool_job_t;
+
+/** Range of units of the running job */
+typedef struct {
+    size_t begin;
+    size_t end;
+} pool_task_t;
+
+/** Per-thread deque: the owner uses the bottom, thieves take the top */
+typedef struct {
+    pthread_mutex_t lock;
+    atomic_size_t top;          ///< Oldest entry (written under lock)
+    atomic_size_t bottom;       ///< One past the newest entry (written under lock)
+    pool_task_t tasks[POOL_DEQUE_CAPACITY];
+} pool_deque_t;
+
+/** Process-wide pool state */
+typedef struct {
+    bool running;
+    bool attempted;             ///< pool_initialize() ran at least once
+    bool pin;
+    size_t worker_count;        ///< Started threads; deque worker_count is the submitter's
+    pthread_t *workers;
+    pool_deque_t *deques;
+    pthread_mutex_t lock;       ///< Guards job, generation, inside and stopping
+    pthread_cond_t wake;        ///< Signalled when a job starts or the pool stops
+    pthread_cond_t idle;        ///< Signalled when the last worker leaves a job
+    pthread_cond_t more;        ///< Signalled when a range is published or a job completes
+    atomic_size_t published;    ///< Ranges pushed so far, so parked threads notice new work
+    atomic_size_t parked;       ///< Threads waiting on more
+    pool_job_t *job;
+    uint64_t generation;
+    size_t inside;              ///< Workers currently working on job
+    bool stopping;
+    pthread_mutex_t submit;     ///< Guards the fields above lock; one loop, start or stop at a time
+} pool_state_t;
+
+// ==========================================
+// MARK: - Pool State
+// ==========================================
+
+static pool_state_t pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .idle = PTHREAD_COND_INITIALIZER,
+    .more = PTHREAD_COND_INITIALIZER,
+    .submit = PTHREAD_MUTEX_INITIALIZER
+};
+
+/** Non-zero while this thread runs loop bodies; nested loops run inline */
+static _Thread_local int pool_depth = 0;
+
+// ==========================================
+// MARK: - Deques
+// ==========================================
+
+/** Wake the threads parked on pool.more */
+static void pool_unpark(void) {
+    pthread_mutex_lock(&pool.lock);
+    pthread_cond_broadcast(&pool.more);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/*
+ * A thread parks only after bumping pool.parked and then finding
+ * pool.published unchanged since before its last search, while a push
+ * bumps pool.published and then checks pool.parked. Both are sequentially
+ * consistent, so at least one side sees the other: either the parker
+ * searches again or the pusher wakes it.
+ */
+
+static bool pool_deque_push(pool_deque_t *deque, pool_task_t task) {
+    bool pushed = false;
+    pthread_mutex_lock(&deque->lock);
+    size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    if (bottom - atomic_load_explicit(&deque->top, memory_order_relaxed) < POOL_DEQUE_CAPACITY) {
+        deque->tasks[bottom % POOL_DEQUE_CAPACITY] = task;
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        pushed = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    if (pushed) {
+        atomic_fetch_add(&pool.published, 1);
+        if (atomic_load(&pool.parked) > 0) {
+            pool_unpark();
+        }
+    }
+    return pushed;
+}
+
+/** Take from the bottom (owner) or the top (thief) */
+static bool pool_deque_take(pool_deque_t *deque, bool steal, pool_task_t *task) {
+    // Unlocked peek so idle thieves do not hammer empty deques' locks
+    if (atomic_load_explicit(&deque->top, memory_order_relaxed) ==
+        atomic_load_explicit(&deque->bottom, memory_order_relaxed)) {
+        return false;
+    }
+
+    bool taken = false;
+    pthread_mutex_lock(&deque->lock);
+    size_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    if (top != bottom) {
+        if (steal) {
+            *task = deque->tasks[top % POOL_DEQUE_CAPACITY];
+            atomic_store_explicit(&deque->top, top + 1, memory_order_relaxed);
+        } else {
+            *task = deque->tasks[(bottom - 1) % POOL_DEQUE_CAPACITY];
+            atomic_store_explicit(&deque->bottom, bottom - 1, memory_order_relaxed);
+        }
+        taken = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return taken;
+}
+
+// ==========================================
+// MARK: - Scheduling
+// ==========================================
+
+static uint64_t pool_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/** Try every other deque once, starting from a random victim */
+static bool pool_steal(size_t self, uint64_t *rng, pool_task_t *task) {
+    size_t deque_count = pool.worker_count + 1;
+    size_t first = (size_t)(pool_random(rng) % deque_count);
+    for (size_t attempt = 0; attempt < deque_count; attempt++) {
+        size_t victim = (first + attempt) % deque_count;
+        if (victim != self && pool_deque_take(&pool.deques[victim], true, task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Split a range down to the grain, publishing upper halves, then run it */
+static void pool_execute(size_t self, pool_job_t *job, pool_task_t task) {
+    while (task.end - task.begin > job->grain) {
+        size_t middle = task.begin + (task.end - task.begin) / 2;
+        pool_task_t upper = { middle, task.end };
+        if (!pool_deque_push(&pool.deques[self], upper)) {
+            break;
+        }
+        task.end = middle;
+    }
+    for (size_t begin = task.begin; begin < task.end; begin += job->grain) {
+        size_t end = (task.end - begin < job->grain) ? task.end : begin + job->grain;
+        job->fn(job->context, begin, end);
+    }
+    if (atomic_fetch_sub(&job->pending, task.end - task.begin) == task.end - task.begin) {
+        pool_unpark();
+    }
+}
+
+/** Run and steal ranges until every unit of the job is handled */
+static void pool_work(size_t self, pool_job_t *job) {
+    uint64_t rng = 0x9E3779B97F4A7C15u * (self + 1);
+    pool_task_t task;
+
+    pool_depth++;
+    while (atomic_load(&job->pending) > 0) {
+        size_t seen = atomic_load(&pool.published);
+        if (pool_deque_take(&pool.deques[self], false, &task) || pool_steal(self, &rng, &task)) {
+            pool_execute(self, job, task);
+            continue;
+        }
+
+        // Every remaining range is running elsewhere: park until one is split
+        pthread_mutex_lock(&pool.lock);
+        atomic_fetch_add(&pool.parked, 1);
+        while (atomic_load(&job->pending) > 0 && atomic_load(&pool.published) == seen) {
+            pthread_cond_wait(&pool.more, &pool.lock);
+        }
+        atomic_fetch_sub(&pool.parked, 1);
+        pthread_mutex_unlock(&pool.lock);
+    }
+    pool_depth--;
+}
+
+/** Pin the calling worker to the (index + 1)-th CPU it may run on */
+static void pool_pin(size_t index) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+        return;
+    }
+    size_t target = (index + 1) % (size_t)CPU_COUNT(&allowed);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            cpu_set_t only;
+            CPU_ZERO(&only);
+            CPU_SET(cpu, &only);
+            pthread_setaffinity_np(pthread_self(), sizeof(only), &only);
+            return;
+        }
+    }
+#else
+    (void)index;
+#endif
+}
+
+static void *pool_worker_main(void *arg) {
+    size_t self = (size_t)(uintptr_t)arg;
+    uint64_t seen = 0;
+
+    if (pool.pin) {
+        pool_pin(self);
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (!pool.stopping && (pool.job == NULL || pool.generation == seen)) {
+            pthread_cond_wait(&pool.wake, &pool.lock);
+        }
+        if (pool.stopping) {
+            break;
+        }
+        seen = pool.generation;
+        pool_job_t *job = pool.job;
+        pool.inside++;
+        pthread_mutex_unlock(&pool.lock);
+
+        pool_work(self, job);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.inside == 0) {
+            pthread_cond_signal(&pool.idle);
+        }
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+// ==========================================
+// MARK: - Internal Helpers
+// ==========================================
+
+/** Resolve a thread count of 0 from CALC_THREADS, then the online CPU count */
+static pool_result_t pool_resolve_config(const pool_config_t *config, size_t *threads, bool *pin) {
+    const char *text = getenv(POOL_THREADS_ENV);
+    const char *pin_text = getenv(POOL_PIN_ENV);
+
+    *threads = (config != NULL) ? config->threads : 0;
+    *pin = (config != NULL && config->pin) || (pin_text != NULL && strcmp(pin_text, "1") == 0);
+
+    if (*threads == 0 && text != NULL && text[0] != '\0') {
+        char *end;
+        errno = 0;
+        unsigned long long value = strtoull(text, &end, 10);
+        if (errno != 0 || *end != '\0' || text[0] < '0' || text[0] > '9') {
+            return POOL_ERROR_INVALID_INPUT;
+        }
+        *threads = (size_t)value;
+    }
+    if (*threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        *threads = (online > 0) ? (size_t)online : 1;
+    }
+    return (*threads <= POOL_MAX_THREADS) ? POOL_SUCCESS : POOL_ERROR_INVALID_INPUT;
+}
+
+// ==========================================
+// MARK: - Pool Lifecycle
+// ==========================================
+
+/*
+ * Starting, stopping and running a loop all hold pool.submit, so two
+ * threads that start the pool lazily create it once, and a stop waits for
+ * the loop in flight instead of freeing its deques. Loop bodies run while
+ * their submitter holds the mutex, so the entry points refuse to start or
+ * stop the pool from inside one.
+ */
+
+/** Join the workers and free the deques; pool.submit must be held */
+static void pool_stop(void) {
+    if (!pool.running) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+    for (size_t i = 0; i < pool.worker_count; i++) {
+        pthread_join(pool.workers[i], NULL);
+    }
+    for (size_t i = 0; i <= pool.worker_count; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+    }
+
+    free(pool.workers);
+    free(pool.deques);
+    pool.workers = NULL;
+    pool.deques = NULL;
+    pool.worker_count = 0;
+    pool.running = false;
+    pool.attempted = false;
+}
+
+/** Body of pool_initialize(); pool.submit must be held */
+static pool_result_t pool_start(const pool_config_t *config) {
+    size_t threads;
+    bool pin;
+
+    pool_stop();
+    pool.attempted = true;
+
+    pool_result_t result = pool_resolve_config(config, &threads, &pin);
+    if (result != POOL_SUCCESS) {
+        return result;
+    }
+    if (threads <= 1) {
+        return POOL_SUCCESS;
+    }
+
+    pool.worker_count = threads - 1;
+    pool.pin = pin;
+    pool.workers = calloc(pool.worker_count, sizeof(*pool.workers));
+    pool.deques = calloc(threads, sizeof(*pool.deques));
+    if (pool.workers == NULL || pool.deques == NULL) {
+        free(pool.workers);
+        free(pool.deques);
+        pool.workers = NULL;
+        pool.deques = NULL;
+        pool.worker_count = 0;
+        return POOL_ERROR_MEMORY;
+    }
+    for (size_t i = 0; i < threads; i++) {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+    }
+
+    pool.stopping = false;
+    pool.running = true;
+    for (size_t i = 0; i < pool.worker_count; i++) {
+        if (pthread_create(&pool.workers[i], NULL, pool_worker_main, (void *)(uintptr_t)i) != 0) {
+            pool.worker_count = i;
+            pool_stop();
+            pool.attempted = true;
+            return POOL_ERROR_THREAD;
+        }
+    }
+    return POOL_SUCCESS;
+}
+
+pool_result_t pool_initialize(const pool_config_t *config) {
+    if (pool_depth > 0) {
+        return POOL_ERROR_INVALID_INPUT;
+    }
+    pthread_mutex_lock(&pool.submit);
+    pool_result_t result = pool_start(config);
+    pthread_mutex_unlock(&pool.submit);
+    return result;
+}
+
+void pool_shutdown(void) {
+    if (pool_depth > 0) {
+        return;
+    }
+    pthread_mutex_lock(&pool.submit);
+    pool_stop();
+    pthread_mutex_unlock(&pool.submit);
+}
+
+size_t pool_thread_count(void) {
+    // Inside a loop body the pool cannot change under this thread
+    if (pool_depth > 0) {
+        return pool.running ? pool.worker_count + 1 : 1;
+    }
+    pthread_mutex_lock(&pool.submit);
+    size_t threads = pool.running ? pool.worker_count + 1 : 1;
+    pthread_mutex_unlock(&pool.submit);
+    return threads;
+}
+
+// ==========================================
+// MARK: - Parallel Loops
+// ==========================================
+
+void pool_parallel_for(size_t count, size_t grain, pool_range_fn_t fn, void *context) {
+    if (fn == NULL || count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    bool parallel = count > grain && pool_depth == 0;
+    if (parallel) {
+        pthread_mutex_lock(&pool.submit);
+        if (!pool.running && !pool.attempted) {
+            pool_start(NULL);
+        }
+        if (!pool.running) {
+            pthread_mutex_unlock(&pool.submit);
+            parallel = false;
+        }
+    }
+    if (!parallel) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            fn(context, begin, (count - begin < grain) ? count : begin + grain);
+        }
+        return;
+    }
+
+    pool_job_t job = { fn, context, grain, 0 };
+    size_t self = pool.worker_count;
+    size_t deque_count = pool.worker_count + 1;
+
+    atomic_store(&job.pending, count);
+
+    // Seed every deque with an equal share so workers start without stealing
+    for (size_t i = 0; i < deque_count; i++) {
+        pool_task_t share = { i * count / deque_count, (i + 1) * count / deque_count };
+        if (share.begin < share.end) {
+            pool_deque_push(&pool.deques[i], share);
+        }
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.job = &job;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+
+    pool_work(self, &job);
+
+    // job lives on this stack: wait until no worker can still touch it
+    pthread_mutex_lock(&pool.lock);
+    pool.job = NULL;
+    while (pool.inside > 0) {
+        pthread_cond_wait(&pool.idle, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.submit);
+}
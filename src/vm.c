@@ -0,0 +1,461 @@
+// ==========================================
+// FILE: vm.c
+// ==========================================
+/**
+ * @file vm.c
+ * @brief Expression VM implementation
+ * @details Implements the bytecode compiler and two executors. The row
+ *          interpreter is direct-threaded with computed goto, and each op
+ *          handler carries the body of the matching calculator_* function:
+ *          operands are already known to be finite, so only the result
+ *          checks remain. The column executor evaluates a chunk of rows one
+ *          instruction at a time over register lanes.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "vm.h"
+#include "calculator_dispatch.h"
+#include "calculator_inline.h"
+#include <math.h>
+#include <string.h>
+
+// ==========================================
+// MARK: - Op Bodies
+// ==========================================
+
+/** Body of calculator_power() for finite operands; result is written on underflow too */
+static inline calc_result_t vm_power(double base, double exponent, double *result) {
+    if (fabs(exponent) <= CALC_POWER_INTEGER_MAX && exponent == (double)(int)exponent) {
+        return calculator_inline_power_int(base, (int)exponent, result);
+    }
+    if (base == 0.0 && exponent < 0.0) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    if (base < 0.0 && floor(exponent) != exponent) {
+        return CALC_ERROR_DOMAIN;
+    }
+    *result = calculator_inline_as_daz(pow(calculator_inline_as_daz(base), exponent));
+    return calculator_inline_range(*result, calculator_inline_is_zero(base));
+}
+
+// ==========================================
+// MARK: - Compiler
+// ==========================================
+
+static const uint8_t vm_binary_opcodes[] = {
+    [EXPR_NODE_ADD] = VM_OP_ADD,
+    [EXPR_NODE_SUBTRACT] = VM_OP_SUBTRACT,
+    [EXPR_NODE_MULTIPLY] = VM_OP_MULTIPLY,
+    [EXPR_NODE_DIVIDE] = VM_OP_DIVIDE,
+    [EXPR_NODE_MODULUS] = VM_OP_MODULUS,
+    [EXPR_NODE_POWER] = VM_OP_POWER
+};
+
+/** Register of a literal, shared by literals with the same bit pattern */
+static int vm_constant_register(vm_program_t *program, double value) {
+    for (int i = 0; i < program->constant_count; i++) {
+        if (memcmp(&program->constants[i], &value, sizeof(value)) == 0) {
+            return i;
+        }
+    }
+    if (program->constant_count >= VM_MAX_REGISTERS) {
+        return -1;
+    }
+    program->constants[program->constant_count] = value;
+    return program->constant_count++;
+}
+
+/** Input slot of an input index (register = constant_count + slot) */
+static int vm_input_slot(vm_program_t *program, uint32_t input) {
+    for (int i = 0; i < program->input_count; i++) {
+        if (program->inputs[i] == input) {
+            return i;
+        }
+    }
+    if (program->input_count >= VM_MAX_REGISTERS) {
+        return -1;
+    }
+    program->inputs[program->input_count] = input;
+    return program->input_count++;
+}
+
+/** Compiler passes over the nodes, with per-node scratch from the caller */
+static vm_result_t vm_compile_nodes(const expr_t *expr, vm_program_t *program,
+                                    int *slots, uint8_t *registers) {
+    program->code_length = 0;
+    program->input_limit = expr->input_count;
+    program->constant_count = 0;
+    program->input_count = 0;
+    program->invalid_constant = false;
+
+    // Pass 1: literals and inputs, so temporaries can start after them
+    for (uint32_t i = 0; i < expr->count; i++) {
+        const expr_node_t *node = &expr->nodes[i];
+        if (node->kind == EXPR_NODE_NUMBER) {
+            slots[i] = vm_constant_register(program, node->as.value);
+            if (!calculator_is_valid_number(node->as.value)) {
+                program->invalid_constant = true;
+            }
+        } else if (node->kind == EXPR_NODE_INPUT) {
+            slots[i] = vm_input_slot(program, node->as.input);
+        } else {
+            continue;
+        }
+        if (slots[i] < 0) {
+            return VM_ERROR_TOO_COMPLEX;
+        }
+    }
+
+    int temp_base = program->constant_count + program->input_count;
+    for (uint32_t i = 0; i < expr->count; i++) {
+        if (expr->nodes[i].kind == EXPR_NODE_NUMBER) {
+            registers[i] = (uint8_t)slots[i];
+        } else if (expr->nodes[i].kind == EXPR_NODE_INPUT) {
+            registers[i] = (uint8_t)(program->constant_count + slots[i]);
+        }
+    }
+
+    // Pass 2: operators in postfix order; live temporaries form a stack, so
+    // an operator's temporary operands are always the topmost ones
+    int depth = 0;
+    int max_depth = 0;
+    for (uint32_t i = 0; i < expr->count; i++) {
+        const expr_node_t *node = &expr->nodes[i];
+        if (node->kind == EXPR_NODE_NUMBER || node->kind == EXPR_NODE_INPUT) {
+            continue;
+        }
+
+        uint32_t left = node->as.children.left;
+        uint32_t right = node->as.children.right;
+        vm_instruction_t instruction;
+        instruction.a = registers[left];
+        instruction.b = registers[right];
+        if (node->kind == EXPR_NODE_NEGATE) {
+            instruction.op = VM_OP_NEGATE;
+            depth -= (registers[left] >= temp_base);
+        } else {
+            instruction.op = vm_binary_opcodes[node->kind];
+            depth -= (registers[left] >= temp_base) + (registers[right] >= temp_base);
+        }
+
+        if (temp_base + depth >= VM_MAX_REGISTERS) {
+            return VM_ERROR_TOO_COMPLEX;
+        }
+        instruction.dst = (uint8_t)(temp_base + depth);
+        registers[i] = instruction.dst;
+        if (++depth > max_depth) {
+            max_depth = depth;
+        }
+        program->code[program->code_length++] = instruction;
+    }
+
+    vm_instruction_t halt = { VM_OP_HALT, 0, registers[expr->root], 0 };
+    program->code[program->code_length++] = halt;
+    program->register_count = (uint8_t)(temp_base + max_depth);
+    return VM_SUCCESS;
+}
+
+vm_result_t vm_compile(const expr_t *expr, arena_t *arena, vm_program_t *program) {
+    if (expr == NULL || arena == NULL || program == NULL || expr->count == 0) {
+        return VM_ERROR_INVALID_INPUT;
+    }
+
+    program->code = arena_alloc(arena, (expr->count + 1) * sizeof(vm_instruction_t));
+    if (program->code == NULL) {
+        return VM_ERROR_MEMORY;
+    }
+
+    // Per-node scratch only lives for this call
+    arena_mark_t scratch = arena_mark(arena);
+    int *slots = arena_alloc(arena, expr->count * sizeof(int));
+    uint8_t *registers = arena_alloc(arena, expr->count);
+    if (slots == NULL || registers == NULL) {
+        arena_release(arena, scratch);
+        return VM_ERROR_MEMORY;
+    }
+    vm_result_t result = vm_compile_nodes(expr, program, slots, registers);
+    arena_release(arena, scratch);
+    return result;
+}
+
+// ==========================================
+// MARK: - Row Interpreter
+// ==========================================
+
+// Computed goto ("labels as values") is a GNU extension
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+/**
+ * @brief Run the instructions over a loaded register file
+ * @details Each handler ends in its own indirect jump, which gives the
+ *          branch predictor one history per opcode instead of one shared
+ *          switch jump. An underflow stops the program unless a batch
+ *          flushes it to zero: then the row runs on with the zero, and
+ *          returns CALC_ERROR_UNDERFLOW with its result for the error
+ *          channel to count.
+ */
+static calc_result_t vm_run(const vm_program_t *program, double *registers, double *result) {
+    static const void *const dispatch[VM_OP_COUNT] = {
+        [VM_OP_ADD] = &&op_add,
+        [VM_OP_SUBTRACT] = &&op_subtract,
+        [VM_OP_MULTIPLY] = &&op_multiply,
+        [VM_OP_DIVIDE] = &&op_divide,
+        [VM_OP_MODULUS] = &&op_modulus,
+        [VM_OP_POWER] = &&op_power,
+        [VM_OP_NEGATE] = &&op_negate,
+        [VM_OP_HALT] = &&op_halt
+    };
+    const vm_instruction_t *ip = program->code;
+    calc_result_t status;
+    bool flushed = false;
+    double value;
+
+#define VM_NEXT() goto *dispatch[(++ip)->op]
+#define VM_CHECK(expression)                                                        \
+    status = (expression);                                                          \
+    if (status != CALC_SUCCESS) {                                                   \
+        if (status != CALC_ERROR_UNDERFLOW || !calculator_batch_flushing()) {       \
+            return status;                                                          \
+        }                                                                           \
+        flushed = true;                                                             \
+    }
+#define VM_STORE_CHECKED(expression, zero_is_exact)                                 \
+    value = (expression);                                                           \
+    VM_CHECK(calculator_inline_range(value, zero_is_exact));                        \
+    registers[ip->dst] = value;                                                     \
+    VM_NEXT()
+
+    goto *dispatch[ip->op];
+
+op_add:
+    VM_STORE_CHECKED(registers[ip->a] + registers[ip->b],
+                     calculator_inline_cancels(registers[ip->a], registers[ip->b]));
+op_subtract:
+    VM_STORE_CHECKED(registers[ip->a] - registers[ip->b],
+                     calculator_inline_cancels(registers[ip->a], -registers[ip->b]));
+op_multiply:
+    VM_STORE_CHECKED(registers[ip->a] * registers[ip->b],
+                     calculator_inline_is_zero(registers[ip->a]) | calculator_inline_is_zero(registers[ip->b]));
+op_divide:
+    if (fabs(registers[ip->b]) < CALC_PRECISION_EPSILON) {
+        return CALC_ERROR_DIVISION_BY_ZERO;
+    }
+    VM_STORE_CHECKED(registers[ip->a] / registers[ip->b], calculator_inline_is_zero(registers[ip->a]));
+op_modulus:
+    status = calculator_inline_modulus_truncated(registers[ip->a], registers[ip->b], &registers[ip->dst]);
+    if (status != CALC_SUCCESS) {
+        return status;
+    }
+    VM_NEXT();
+op_power:
+    VM_CHECK(vm_power(registers[ip->a], registers[ip->b], &registers[ip->dst]));
+    VM_NEXT();
+op_negate:
+    registers[ip->dst] = -registers[ip->a];
+    VM_NEXT();
+op_halt:
+    *result = registers[ip->a];
+    return flushed ? CALC_ERROR_UNDERFLOW : CALC_SUCCESS;
+
+#undef VM_STORE_CHECKED
+#undef VM_CHECK
+#undef VM_NEXT
+}
+
+#pragma GCC diagnostic pop
+
+/** Load literals and one row of inputs; non-finite operands are invalid input */
+static calc_result_t vm_load_row(const vm_program_t *program, const double *const *columns,
+                                 size_t row, double *registers) {
+    if (program->invalid_constant) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    memcpy(registers, program->constants, program->constant_count * sizeof(double));
+    for (int i = 0; i < program->input_count; i++) {
+        double value = columns[program->inputs[i]][row];
+        if (!calculator_inline_is_valid_number(value)) {
+            return CALC_ERROR_INVALID_INPUT;
+        }
+        registers[program->constant_count + i] = value;
+    }
+    return CALC_SUCCESS;
+}
+
+calc_result_t vm_execute(const vm_program_t *program, const double *inputs,
+                         size_t input_count, double *result) {
+    if (program == NULL || result == NULL || input_count < program->input_limit ||
+        (inputs == NULL && input_count > 0)) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+
+    double registers[VM_MAX_REGISTERS];
+    if (program->invalid_constant) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    memcpy(registers, program->constants, program->constant_count * sizeof(double));
+    for (int i = 0; i < program->input_count; i++) {
+        double value = inputs[program->inputs[i]];
+        if (!calculator_inline_is_valid_number(value)) {
+            return CALC_ERROR_INVALID_INPUT;
+        }
+        registers[program->constant_count + i] = value;
+    }
+    return vm_run(program, registers, result);
+}
+
+// ==========================================
+// MARK: - Column Executor
+// ==========================================
+
+/** True if every lane is finite */
+static bool vm_lanes_finite(const double *lanes, size_t count) {
+    bool finite = true;
+    for (size_t i = 0; i < count; i++) {
+        finite &= calculator_inline_is_valid_number(lanes[i]);
+    }
+    return finite;
+}
+
+/**
+ * @brief Evaluate one chunk over register lanes
+ * @details Literal lanes are filled by the caller; input registers point
+ *          straight into the columns and temps[i] backs temporary register
+ *          constant_count + input_count + i. Returns false as soon as any
+ *          lane fails, leaving the chunk to the row interpreter.
+ */
+static bool vm_run_chunk(const vm_program_t *program, const double **lanes,
+                         double (*temps)[VM_CHUNK_ROWS], size_t count) {
+    const calc_kernel_table_t *kernels = calculator_dispatch_kernels();
+
+    for (int i = 0; i < program->input_count; i++) {
+        if (!vm_lanes_finite(lanes[program->constant_count + i], count)) {
+            return false;
+        }
+    }
+
+    int temp_base = program->constant_count + program->input_count;
+    for (const vm_instruction_t *ip = program->code; ip->op != VM_OP_HALT; ip++) {
+        const double *a = lanes[ip->a];
+        const double *b = lanes[ip->b];
+        double *dst = temps[ip->dst - temp_base];
+        calc_kernel_fn_t kernel = NULL;
+
+        switch ((vm_opcode_t)ip->op) {
+            case VM_OP_ADD:      kernel = kernels->add; break;
+            case VM_OP_SUBTRACT: kernel = kernels->subtract; break;
+            case VM_OP_MULTIPLY: kernel = kernels->multiply; break;
+            case VM_OP_DIVIDE:   kernel = kernels->divide; break;
+            case VM_OP_NEGATE:
+                for (size_t r = 0; r < count; r++) {
+                    dst[r] = -a[r];
+                }
+                break;
+            case VM_OP_MODULUS:
+                for (size_t r = 0; r < count; r++) {
+                    if (calculator_inline_modulus_truncated(a[r], b[r], &dst[r]) != CALC_SUCCESS) {
+                        return false;
+                    }
+                }
+                break;
+            case VM_OP_POWER:
+                for (size_t r = 0; r < count; r++) {
+                    if (vm_power(a[r], b[r], &dst[r]) != CALC_SUCCESS) {
+                        return false;
+                    }
+                }
+                break;
+            default:
+                return false;
+        }
+
+        // Kernels stop in front of the first vector with a failing lane
+        if (kernel != NULL && kernel(a, b, dst, count) != count) {
+            return false;
+        }
+        lanes[ip->dst] = dst;
+    }
+    return true;
+}
+
+/** One vm_execute_columns() call, shared by the pool threads */
+typedef struct {
+    const vm_program_t *program;
+    const double *const *columns;
+    double *out;
+} vm_columns_job_t;
+
+/** Evaluate rows [begin, end); begin is a multiple of VM_CHUNK_ROWS */
+static calc_result_t vm_execute_rows(void *context, size_t begin, size_t end,
+                                     calc_batch_errors_t *errors) {
+    const vm_columns_job_t *job = context;
+    const vm_program_t *program = job->program;
+    const double *const *columns = job->columns;
+    double *out = job->out;
+
+    // Lanes for literals followed by temporaries; inputs are read in place
+    size_t own_lanes = (size_t)(program->register_count - program->input_count);
+    double lane_storage[own_lanes > 0 ? own_lanes : 1][VM_CHUNK_ROWS];
+    double (*temp_lanes)[VM_CHUNK_ROWS] = lane_storage + program->constant_count;
+    const double *lanes[VM_MAX_REGISTERS];
+    double registers[VM_MAX_REGISTERS];
+    calc_result_t first_error = CALC_SUCCESS;
+    const vm_instruction_t *halt = &program->code[program->code_length - 1];
+
+    for (int i = 0; i < program->constant_count; i++) {
+        for (size_t r = 0; r < VM_CHUNK_ROWS; r++) {
+            lane_storage[i][r] = program->constants[i];
+        }
+        lanes[i] = lane_storage[i];
+    }
+
+    for (size_t base = begin; base < end; base += VM_CHUNK_ROWS) {
+        size_t count = (end - base < VM_CHUNK_ROWS) ? end - base : VM_CHUNK_ROWS;
+
+        for (int i = 0; i < program->input_count; i++) {
+            lanes[program->constant_count + i] = columns[program->inputs[i]] + base;
+        }
+
+        if (!program->invalid_constant &&
+            vm_run_chunk(program, lanes, temp_lanes, count)) {
+            memmove(out + base, lanes[halt->a], count * sizeof(double));
+            continue;
+        }
+
+        // Some row failed: classify every row of the chunk individually
+        for (size_t r = base; r < base + count; r++) {
+            calc_result_t status = vm_load_row(program, columns, r, registers);
+            if (status == CALC_SUCCESS) {
+                status = vm_run(program, registers, &out[r]);
+            }
+            if (status != CALC_SUCCESS) {
+                status = calculator_batch_errors_record(errors, r, status);
+                if (first_error == CALC_SUCCESS) {
+                    first_error = status;
+                }
+            }
+        }
+    }
+
+    return first_error;
+}
+
+calc_result_t vm_execute_columns(const vm_program_t *program, const double *const *columns,
+                                 size_t column_count, double *out, size_t rows,
+                                 calc_batch_errors_t *errors) {
+    if (program == NULL || column_count < program->input_limit ||
+        (rows > 0 && (columns == NULL || out == NULL))) {
+        return CALC_ERROR_INVALID_INPUT;
+    }
+    for (int i = 0; i < program->input_count; i++) {
+        if (columns[program->inputs[i]] == NULL) {
+            return CALC_ERROR_INVALID_INPUT;
+        }
+    }
+
+    // Large column sets run in pool-sized ranges of whole chunks
+    vm_columns_job_t job = { program, columns, out };
+    return calculator_batch_parallel(rows, vm_execute_rows, &job, errors);
+}
@@ -0,0 +1,640 @@
+// ==========================================
+// FILE: test_calculator.c
+// ==========================================
+/**
+ * @file test_calculator.c
+ * @brief Calculator regression tests
+ * @details Checks the behaviour the engine promises at its entry points,
+ *          one section per feature. Prints every failed check and exits
+ *          non-zero if there was one.
+ * @author Rahul B.
+ * @date 2025-07-01
+ * @version 1.0.0
+ */
+
+#include "batch_mode.h"
+#include "calculator.h"
+#include "calculator_batch.h"
+#include "calculator_dispatch.h"
+#include "calculator_reduce.h"
+#include "csv.h"
+#include "expr.h"
+#include "format.h"
+#include "parser.h"
+#include "vm.h"
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ==========================================
+// MARK: - Test Constants
+// ==========================================
+
+/** Elements per batch check; odd, so every level runs its scalar tail */
+#define TEST_BATCH_COUNT 1003
+
+/** Random doubles formatted and parsed back */
+#define TEST_ROUND_TRIPS 200000
+
+/** Largest output read back from a stream run */
+#define TEST_OUTPUT_SIZE 4096
+
+// ==========================================
+// MARK: - Helpers
+// ==========================================
+
+static int test_failures = 0;
+
+/** Record a failed check without stopping the run */
+#define TEST_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            test_failures++; \
+        } \
+    } while (0)
+
+static bool test_same_bits(double a, double b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static uint64_t test_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/** Operands mixing ordinary values with zeros, subnormals, extremes and non-finite values */
+static double test_operand(uint64_t *state) {
+    static const double special[] = {
+        0.0, -0.0, 1.0, -1.0, 3.0, 0.1, 1e-8, 5e-324, -1e-310, 2.2250738585072014e-308,
+        1e-200, -1e-160, 1e200, -1e300, DBL_MAX, -DBL_MAX, INFINITY, -INFINITY, NAN
+    };
+    uint64_t r = test_random(state);
+    if (r % 4 == 0) {
+        return special[(r >> 8) % (sizeof(special) / sizeof(special[0]))];
+    }
+    return ldexp((double)(int64_t)(r >> 11) / 4503599627370496.0, (int)((r >> 2) % 64) - 32);
+}
+
+/** Element i of a batch must match the scalar operation, code and bits */
+static bool test_matches(calc_result_t code, double value, uint8_t batch_code, double batch_value) {
+    return batch_code == (uint8_t)code && (code != CALC_SUCCESS || test_same_bits(batch_value, value));
+}
+
+/** Run text through a file descriptor based entry point and collect its output */
+typedef int (*test_stream_fn_t)(int input_fd, int output_fd, void *context);
+
+static bool test_stream(const char *text, test_stream_fn_t fn, void *context, char *output) {
+    FILE *input = tmpfile();
+    FILE *result = tmpfile();
+    bool ok = false;
+
+    if (input != NULL && result != NULL &&
+        fwrite(text, 1, strlen(text), input) == strlen(text) && fflush(input) == 0 &&
+        lseek(fileno(input), 0, SEEK_SET) == 0 &&
+        fn(fileno(input), fileno(result), context) == 0 &&
+        lseek(fileno(result), 0, SEEK_SET) == 0) {
+        ssize_t length = read(fileno(result), output, TEST_OUTPUT_SIZE - 1);
+        if (length >= 0) {
+            output[length] = '\0';
+            ok = true;
+        }
+    }
+    if (input != NULL) {
+        fclose(input);
+    }
+    if (result != NULL) {
+        fclose(result);
+    }
+    return ok;
+}
+
+static int test_run_batch(int input_fd, int output_fd, void *context) {
+    (void)context;
+    return (int)batch_mode_run(input_fd, output_fd, NULL, NULL);
+}
+
+static int test_run_csv(int input_fd, int output_fd, void *context) {
+    return (int)csv_evaluate(input_fd, output_fd, context, false, NULL);
+}
+
+// ==========================================
+// MARK: - Batch Versus Scalar
+// ==========================================
+
+/** Operands shared by the checks that run at every kernel level */
+typedef struct {
+    double a[TEST_BATCH_COUNT];
+    double b[TEST_BATCH_COUNT];
+    double exponent[TEST_BATCH_COUNT];
+    int ia[TEST_BATCH_COUNT];
+    int ib[TEST_BATCH_COUNT];
+} test_operands_t;
+
+static test_operands_t test_operands;
+
+typedef void (*test_level_fn_t)(const test_operands_t *operands);
+typedef calc_result_t (*test_batch_fn_t)(const double *a, const double *b, double *out,
+                                         size_t n, calc_batch_errors_t *errors);
+typedef calc_result_t (*test_scalar_fn_t)(double a, double b, double *result);
+
+static void test_fill_operands(test_operands_t *operands) {
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+        operands->a[i] = test_operand(&state);
+        operands->b[i] = test_operand(&state);
+        operands->exponent[i] = (i % 3 == 0) ? operands->b[i] : (double)((int)(test_random(&state) % 161) - 80);
+        operands->ia[i] = (int)(test_random(&state) % 2001) - 1000;
+        operands->ib[i] = (int)(test_random(&state) % 41) - 20;
+    }
+}
+
+/**
+ * Run check once at every kernel level the CPU supports, then restore the
+ * active level. Batches only match the scalar operations with subnormals
+ * preserved, so the denormal mode is pinned while they run.
+ */
+static void test_each_level(test_level_fn_t check) {
+    calc_cpu_level_t active = calculator_dispatch_level();
+    calc_denormal_mode_t denormals = calculator_get_denormal_mode();
+
+    calculator_set_denormal_mode(CALC_DENORMAL_MODE_PRESERVE);
+    for (int level = CALC_CPU_LEVEL_SCALAR; level <= (int)calculator_dispatch_detect(); level++) {
+        if (calculator_dispatch_set_level((calc_cpu_level_t)level) == CALC_SUCCESS) {
+            check(&test_operands);
+        }
+    }
+    calculator_dispatch_set_level(active);
+    calculator_set_denormal_mode(denormals);
+}
+
+static void test_batch_op(const char *name, test_batch_fn_t batch, test_scalar_fn_t scalar,
+                          const double *a, const double *b) {
+    double out[TEST_BATCH_COUNT];
+    uint8_t codes[TEST_BATCH_COUNT];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+    size_t mismatches = 0;
+
+    batch(a, b, out, TEST_BATCH_COUNT, &errors);
+    for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+        double value = 0.0;
+        calc_result_t code = scalar(a[i], b[i], &value);
+        mismatches += !test_matches(code, value, codes[i], out[i]);
+    }
+    if (mismatches > 0) {
+        fprintf(stderr, "%s at %s: %zu elements differ from the scalar operation\n", name,
+                calculator_dispatch_level_name(calculator_dispatch_level()), mismatches);
+        test_failures++;
+    }
+}
+
+static void test_batch_level(const test_operands_t *operands) {
+    double out[TEST_BATCH_COUNT];
+    uint8_t codes[TEST_BATCH_COUNT];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+
+    test_batch_op("add", calculator_add_batch, calculator_add, operands->a, operands->b);
+    test_batch_op("subtract", calculator_subtract_batch, calculator_subtract, operands->a, operands->b);
+    test_batch_op("multiply", calculator_multiply_batch, calculator_multiply, operands->a, operands->b);
+    test_batch_op("divide", calculator_divide_batch, calculator_divide, operands->a, operands->b);
+    test_batch_op("power", calculator_power_batch, calculator_power, operands->a, operands->exponent);
+
+    calculator_modulus_batch(operands->ia, operands->ib, out, TEST_BATCH_COUNT, &errors);
+    for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+        double value = 0.0;
+        calc_result_t code = calculator_modulus(operands->ia[i], operands->ib[i], &value);
+        TEST_CHECK(test_matches(code, value, codes[i], out[i]));
+    }
+}
+
+static void test_batch(void) {
+    test_each_level(test_batch_level);
+}
+
+/**
+ * Power in CALC_ERROR_MODE_FENV: every element, failing or not, holds what
+ * calculator_power() leaves in its result, and the caller's sticky flags
+ * survive the call. Subnormals are preserved so underflows match too.
+ */
+static void test_power_fenv(void) {
+    static const double base[] = { 2.0, NAN, 0.0, -2.0, 10.0, 10.0, 10.0, 1.5, 0.5, 3.0 };
+    static const double exponent[] = { 0.5, 2.0, -1.5, 0.5, 400.0, 400.5, -400.0, 3.0, 1075.0, -2.5 };
+    const size_t count = sizeof(base) / sizeof(base[0]);
+    calc_error_mode_t mode = calculator_get_error_mode();
+    calc_denormal_mode_t denormals = calculator_get_denormal_mode();
+    double out[sizeof(base) / sizeof(base[0])];
+    uint8_t codes[sizeof(base) / sizeof(base[0])];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+
+    calculator_set_error_mode(CALC_ERROR_MODE_FENV);
+    calculator_set_denormal_mode(CALC_DENORMAL_MODE_PRESERVE);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = 42.0;
+    }
+    feclearexcept(CALC_FENV_FLAGS);
+    feraiseexcept(FE_OVERFLOW);
+    calculator_power_batch(base, exponent, out, count, &errors);
+    TEST_CHECK(fetestexcept(FE_OVERFLOW) != 0);
+    feclearexcept(CALC_FENV_FLAGS);
+    for (size_t i = 0; i < count; i++) {
+        double value = 42.0;
+        calc_result_t code = calculator_power(base[i], exponent[i], &value);
+        TEST_CHECK(codes[i] == (uint8_t)code && test_same_bits(out[i], value));
+    }
+    calculator_set_error_mode(mode);
+    calculator_set_denormal_mode(denormals);
+}
+
+// ==========================================
+// MARK: - Parser
+// ==========================================
+
+static bool test_parses_to(const char *text, double expected) {
+    double parsed;
+    const char *end = parser_parse_double(text, text + strlen(text), &parsed);
+    return end == text + strlen(text) && test_same_bits(parsed, expected);
+}
+
+static void test_parser(void) {
+    // Correct rounding at the boundaries and past the fast path's digits
+    TEST_CHECK(test_parses_to("0.1", 0.1) && test_parses_to("-0", -0.0));
+    TEST_CHECK(test_parses_to("2.2250738585072011e-308", 2.2250738585072009e-308));
+    TEST_CHECK(test_parses_to("2.4703282292062327e-324", 0.0));
+    TEST_CHECK(test_parses_to("2.4703282292062328e-324", 5e-324));
+    TEST_CHECK(test_parses_to("1.7976931348623158e308", DBL_MAX));
+    TEST_CHECK(test_parses_to("9007199254740993", 9007199254740992.0));
+    TEST_CHECK(test_parses_to("9007199254740993.00000000000000000000000000000000000000001",
+                              9007199254740994.0));
+    TEST_CHECK(test_parses_to("1e400", INFINITY) && test_parses_to("-1e-400", -0.0));
+
+    // A halfway case decided by a digit far beyond the first 800
+    char text[1200];
+    memset(text, '0', sizeof(text));
+    memcpy(text, "9007199254740993.", 17);
+    text[sizeof(text) - 2] = '1';
+    text[sizeof(text) - 1] = '\0';
+    TEST_CHECK(test_parses_to(text, 9007199254740994.0));
+    text[sizeof(text) - 2] = '0';
+    TEST_CHECK(test_parses_to(text, 9007199254740992.0));
+}
+
+// ==========================================
+// MARK: - Formatting
+// ==========================================
+
+/** Shortest output parses back to the same bits */
+static bool test_round_trip(double value) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    double parsed;
+    size_t length = format_double_shortest(value, buffer);
+    const char *end = parser_parse_double(buffer, buffer + length, &parsed);
+    return end == buffer + length && test_same_bits(parsed, value);
+}
+
+static bool test_formats_as(double value, const char *expected) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    format_double_shortest(value, buffer);
+    return strcmp(buffer, expected) == 0;
+}
+
+static void test_format(void) {
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    size_t mismatches = 0;
+
+    // Random bit patterns cover every exponent, subnormals included
+    for (size_t i = 0; i < TEST_ROUND_TRIPS; i++) {
+        uint64_t bits = test_random(&state);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isfinite(value)) {
+            mismatches += !test_round_trip(value);
+        }
+    }
+    TEST_CHECK(mismatches == 0);
+
+    TEST_CHECK(test_round_trip(0.0) && test_round_trip(-0.0));
+    TEST_CHECK(test_round_trip(5e-324) && test_round_trip(DBL_MIN) && test_round_trip(DBL_MAX));
+    TEST_CHECK(test_round_trip(0.1) && test_round_trip(1.0 / 3.0) && test_round_trip(9007199254740993.0));
+
+    TEST_CHECK(test_formats_as(0.1, "0.1") && test_formats_as(-2.5, "-2.5"));
+    TEST_CHECK(test_formats_as(1e300, "1e+300") && test_formats_as(1e-5, "1e-05"));
+    TEST_CHECK(test_formats_as(0.0001, "0.0001") && test_formats_as(1e16, "10000000000000000"));
+    TEST_CHECK(test_formats_as(INFINITY, "inf") && test_formats_as(-INFINITY, "-inf"));
+}
+
+// ==========================================
+// MARK: - Expressions
+// ==========================================
+
+/** Parse and evaluate "1 <op> 1 <op> ... 1" with count operands */
+static expr_result_t test_chain(const char *op, size_t count, double *value) {
+    size_t step = strlen(op) + 1;
+    char *text = malloc(count * step);
+    arena_t arena;
+    expr_t expr;
+
+    if (text == NULL) {
+        return EXPR_ERROR_MEMORY;
+    }
+    for (size_t i = 0; i < count; i++) {
+        text[i * step] = '1';
+        memcpy(text + i * step + 1, op, step - 1);
+    }
+    arena_init(&arena, 0, 0);
+    expr_result_t result = expr_parse(text, count * step - (step - 1), &arena, &expr);
+    if (result == EXPR_SUCCESS && expr_evaluate(&expr, value) != CALC_SUCCESS) {
+        result = EXPR_ERROR_SYNTAX;
+    }
+    arena_destroy(&arena);
+    free(text);
+    return result;
+}
+
+static void test_expressions(void) {
+    double value = 0.0;
+
+    // Right operands count toward the nesting limit, so long
+    // right-associative chains are refused instead of overflowing the stack
+    TEST_CHECK(test_chain("^", 32, &value) == EXPR_SUCCESS && value == 1.0);
+    TEST_CHECK(test_chain("^", EXPR_MAX_DEPTH + 2, &value) == EXPR_ERROR_TOO_COMPLEX);
+    TEST_CHECK(test_chain("^", 40000, &value) == EXPR_ERROR_TOO_COMPLEX);
+
+    // Left-associative chains loop instead of recursing
+    TEST_CHECK(test_chain("+", 20000, &value) == EXPR_SUCCESS && value == 20000.0);
+    TEST_CHECK(test_chain("*", 20000, &value) == EXPR_SUCCESS && value == 1.0);
+}
+
+// ==========================================
+// MARK: - 64-bit Modulus
+// ==========================================
+
+static void test_modulus_level(const test_operands_t *operands) {
+    static const int64_t divisors[] = { 7, -1, 1000000007, INT64_MIN, INT64_MAX, -3 };
+    int64_t wide[TEST_BATCH_COUNT], out[TEST_BATCH_COUNT];
+    uint64_t state = 0x853C49E6748FEA9Bu;
+
+    (void)operands;
+    for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+        wide[i] = (int64_t)test_random(&state);
+    }
+    wide[0] = INT64_MIN;
+
+    for (size_t k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+        calc_divisor_i64_t divisor;
+        TEST_CHECK(calculator_divisor_i64_init(&divisor, divisors[k]) == CALC_SUCCESS);
+        TEST_CHECK(calculator_modulus_i64_batch(wide, &divisor, out, TEST_BATCH_COUNT) == CALC_SUCCESS);
+        for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+            int64_t value = 0;
+            TEST_CHECK(calculator_modulus_i64(wide[i], divisors[k], &value) == CALC_SUCCESS && value == out[i]);
+        }
+    }
+}
+
+static void test_modulus_i64(void) {
+    arena_t arena;
+    expr_t expr;
+    vm_program_t program;
+    char output[TEST_OUTPUT_SIZE];
+    double value;
+    int64_t remainder;
+
+    TEST_CHECK(calculator_modulus_i64(INT64_MIN, -1, &remainder) == CALC_SUCCESS && remainder == 0);
+    TEST_CHECK(calculator_modulus_i64(7, 0, &remainder) == CALC_ERROR_DIVISION_BY_ZERO);
+    test_each_level(test_modulus_level);
+
+    // Batch mode
+    TEST_CHECK(batch_mode_evaluate(BATCH_OP_MODULUS, 3000000000.0, 7.0, &value) == CALC_SUCCESS && value == 4.0);
+    TEST_CHECK(batch_mode_evaluate(BATCH_OP_MODULUS, -9000000000000.0, 1000000007.0, &value) == CALC_SUCCESS &&
+               value == -999937007.0);
+    TEST_CHECK(batch_mode_evaluate(BATCH_OP_MODULUS, 1e19, 3.0, &value) == CALC_ERROR_INVALID_INPUT);
+    TEST_CHECK(batch_mode_evaluate(BATCH_OP_MODULUS, 5.0, 0.0, &value) == CALC_ERROR_DIVISION_BY_ZERO);
+    TEST_CHECK(test_stream("mod 3000000000 7\n", test_run_batch, NULL, output) && strcmp(output, "4\n") == 0);
+
+    // Expressions
+    arena_init(&arena, 0, 0);
+    const char *text = "3000000000 % 7";
+    TEST_CHECK(expr_parse(text, strlen(text), &arena, &expr) == EXPR_SUCCESS &&
+               expr_evaluate(&expr, &value) == CALC_SUCCESS && value == 4.0);
+    text = "-9223372036854775808 % -1";
+    TEST_CHECK(expr_parse(text, strlen(text), &arena, &expr) == EXPR_SUCCESS &&
+               expr_evaluate(&expr, &value) == CALC_SUCCESS && value == 0.0);
+    text = "1e19 % 3";
+    TEST_CHECK(expr_parse(text, strlen(text), &arena, &expr) == EXPR_SUCCESS &&
+               expr_evaluate(&expr, &value) == CALC_ERROR_INVALID_INPUT);
+
+    // The VM, row by row and by columns, and CSV on top of it
+    text = "col1 % col2";
+    if (expr_parse(text, strlen(text), &arena, &expr) != EXPR_SUCCESS ||
+        vm_compile(&expr, &arena, &program) != VM_SUCCESS) {
+        TEST_CHECK(!"col1 % col2 compiles");
+        arena_destroy(&arena);
+        return;
+    }
+    double inputs[2] = { 3000000000.0, 7.0 };
+    TEST_CHECK(expr_evaluate_inputs(&expr, inputs, 2, expr.values, &value) == CALC_SUCCESS && value == 4.0);
+    TEST_CHECK(vm_execute(&program, inputs, 2, &value) == CALC_SUCCESS && value == 4.0);
+
+    double dividends[3] = { 3000000000.0, -9000000000000.0, 1e19 };
+    double divisors[3] = { 7.0, 1000000007.0, 3.0 };
+    const double *columns[2] = { dividends, divisors };
+    double out[3];
+    uint8_t codes[3];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+    vm_execute_columns(&program, columns, 2, out, 3, &errors);
+    TEST_CHECK(codes[0] == CALC_SUCCESS && out[0] == 4.0);
+    TEST_CHECK(codes[1] == CALC_SUCCESS && out[1] == -999937007.0);
+    TEST_CHECK(codes[2] == CALC_ERROR_INVALID_INPUT);
+
+    TEST_CHECK(test_stream("3000000000,7\n1e19,3\n", test_run_csv, &program, output) &&
+               strcmp(output, "3000000000,7,4,\n1e19,3,,invalid_input\n") == 0);
+    arena_destroy(&arena);
+}
+
+// ==========================================
+// MARK: - Prepared Division
+// ==========================================
+
+static void test_divide_prepared_level(const test_operands_t *operands) {
+    static const double divisors[] = { 3.0, -0.1, 7e-15, 1e300 };
+    double out[TEST_BATCH_COUNT];
+    uint8_t codes[TEST_BATCH_COUNT];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+
+    for (size_t k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+        calc_divisor_f64_t divisor;
+        TEST_CHECK(calculator_divisor_f64_init(&divisor, divisors[k]) == CALC_SUCCESS);
+        calculator_divide_prepared_batch(operands->a, &divisor, out, TEST_BATCH_COUNT, &errors);
+        for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+            double value = 0.0;
+            double prepared = 0.0;
+            calc_result_t code = calculator_divide(operands->a[i], divisors[k], &value);
+            TEST_CHECK(test_matches(code, value, codes[i], out[i]));
+            TEST_CHECK(calculator_divide_prepared(operands->a[i], &divisor, &prepared) == code &&
+                       (code != CALC_SUCCESS || test_same_bits(prepared, value)));
+        }
+    }
+}
+
+static void test_divide_prepared(void) {
+    calc_divisor_f64_t divisor;
+    TEST_CHECK(calculator_divisor_f64_init(&divisor, 0.0) == CALC_ERROR_DIVISION_BY_ZERO);
+    TEST_CHECK(calculator_divisor_f64_init(&divisor, NAN) == CALC_ERROR_INVALID_INPUT);
+    test_each_level(test_divide_prepared_level);
+}
+
+// ==========================================
+// MARK: - Reductions
+// ==========================================
+
+static void test_reduce(void) {
+    double value;
+    double tiny[2] = { 1e-310, 1e-310 };
+    double cancel[2] = { 1.0, -1.0 };
+    double small[2] = { 1e-200, 1.0 };
+    double zero_factor[2] = { 1e-200, 0.0 };
+    double ones[2] = { 1.0, 1.0 };
+    double lossy[3] = { 1e100, 1.0, -1e100 };
+    double huge[2] = { DBL_MAX, DBL_MAX };
+
+    // Compensation keeps what plain summation loses
+    TEST_CHECK(calculator_sum(lossy, 3, &value) == CALC_SUCCESS && value == 1.0);
+    TEST_CHECK(calculator_sum(NULL, 0, &value) == CALC_SUCCESS && value == 0.0);
+    TEST_CHECK(calculator_product(NULL, 0, &value) == CALC_SUCCESS && value == 1.0);
+    TEST_CHECK(calculator_sum(huge, 2, &value) == CALC_ERROR_OVERFLOW);
+
+    // The final value is classified like a scalar result
+    TEST_CHECK(calculator_sum(tiny, 2, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_sum(cancel, 2, &value) == CALC_SUCCESS && value == 0.0);
+    TEST_CHECK(calculator_product(small, 1, &value) == CALC_SUCCESS);
+    TEST_CHECK(calculator_product(small, 2, &value) == CALC_SUCCESS && value == 1e-200);
+    TEST_CHECK(calculator_dot(small, small, 1, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_dot(small, zero_factor, 2, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_dot(cancel, ones, 2, &value) == CALC_SUCCESS && value == 0.0);
+}
+
+// ==========================================
+// MARK: - Underflow and Denormals
+// ==========================================
+
+static void test_underflow(void) {
+    calc_denormal_mode_t previous = calculator_get_denormal_mode();
+    double value;
+
+    // The preserve-mode expectations must not depend on CALC_DENORMAL_MODE
+    TEST_CHECK(calculator_set_denormal_mode(CALC_DENORMAL_MODE_PRESERVE) == CALC_SUCCESS);
+
+    // Subnormal results and zeros that lost a nonzero value underflow
+    TEST_CHECK(calculator_multiply(1e-200, 1e-200, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_multiply(1e-160, 1e-160, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_add(2.2250738585072014e-308, -1.5e-308, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_divide(1e-300, 1e10, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_power(10.0, -400.0, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_power_int(0.5, 1075, &value) == CALC_ERROR_UNDERFLOW);
+
+    // Exact zeros do not
+    TEST_CHECK(calculator_multiply(0.0, 5.0, &value) == CALC_SUCCESS && value == 0.0);
+    TEST_CHECK(calculator_subtract(1.0, 1.0, &value) == CALC_SUCCESS && value == 0.0);
+    TEST_CHECK(calculator_add(-0.0, 0.0, &value) == CALC_SUCCESS);
+    TEST_CHECK(calculator_power(0.0, 5.0, &value) == CALC_SUCCESS && value == 0.0);
+
+    // Both infinities overflow
+    TEST_CHECK(calculator_multiply(1e300, 1e300, &value) == CALC_ERROR_OVERFLOW);
+    TEST_CHECK(calculator_multiply(-1e300, 1e300, &value) == CALC_ERROR_OVERFLOW);
+
+    TEST_CHECK(calculator_is_underflow(5e-324) && calculator_is_underflow(-1e-310));
+    TEST_CHECK(!calculator_is_underflow(0.0) && !calculator_is_underflow(DBL_MIN));
+    TEST_CHECK(calculator_is_overflow(INFINITY) && calculator_is_overflow(-INFINITY));
+
+    // Batches report underflow per element, or count it as flushed
+    double a[2] = { 1e-200, 2.0 };
+    double b[2] = { 1e-200, 3.0 };
+    double out[2];
+    uint8_t codes[2];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+    TEST_CHECK(calculator_multiply_batch(a, b, out, 2, &errors) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(codes[0] == CALC_ERROR_UNDERFLOW && codes[1] == CALC_SUCCESS && out[1] == 6.0);
+    TEST_CHECK(errors.summary.failed == 1 && errors.summary.flushed == 0);
+
+    if (calculator_set_denormal_mode(CALC_DENORMAL_MODE_FLUSH) == CALC_SUCCESS) {
+        TEST_CHECK(calculator_multiply_batch(a, b, out, 2, &errors) == CALC_SUCCESS);
+        TEST_CHECK(codes[0] == CALC_SUCCESS && out[0] == 0.0 && out[1] == 6.0);
+        TEST_CHECK(errors.summary.failed == 0 && errors.summary.flushed == 1);
+        TEST_CHECK(calculator_multiply(1e-200, 1e-200, &value) == CALC_ERROR_UNDERFLOW);
+    }
+    calculator_set_denormal_mode(previous);
+}
+
+// ==========================================
+// MARK: - Fused Operations
+// ==========================================
+
+static void test_axpy_level(const test_operands_t *operands) {
+    static const double alphas[] = { 3.0, -0.1, 1e-200, 1e300 };
+    double out[TEST_BATCH_COUNT];
+    uint8_t codes[TEST_BATCH_COUNT];
+    calc_batch_errors_t errors = { codes, NULL, { 0 } };
+
+    for (size_t k = 0; k < sizeof(alphas) / sizeof(alphas[0]); k++) {
+        calculator_axpy(alphas[k], operands->a, operands->b, out, TEST_BATCH_COUNT, &errors);
+        for (size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+            double value = 0.0;
+            calc_result_t code = calculator_fma(alphas[k], operands->a[i], operands->b[i], &value);
+            TEST_CHECK(test_matches(code, value, codes[i], out[i]));
+        }
+    }
+}
+
+static void test_fused(void) {
+    double value;
+
+    // One rounding: the product's low bits survive the addition
+    TEST_CHECK(calculator_fma(1.0 + DBL_EPSILON, 1.0 - DBL_EPSILON, -1.0, &value) == CALC_SUCCESS &&
+               value == -DBL_EPSILON * DBL_EPSILON);
+    TEST_CHECK(calculator_fma(2.0, 3.0, -6.0, &value) == CALC_SUCCESS && value == 0.0);
+    TEST_CHECK(calculator_fma(1e-200, 1e-200, 0.0, &value) == CALC_ERROR_UNDERFLOW);
+    TEST_CHECK(calculator_fma(1e300, 1e300, 0.0, &value) == CALC_ERROR_OVERFLOW);
+    TEST_CHECK(calculator_fma(NAN, 1.0, 1.0, &value) == CALC_ERROR_INVALID_INPUT);
+
+    TEST_CHECK(calculator_lerp(2.0, 6.0, 0.25, &value) == CALC_SUCCESS && value == 3.0);
+    TEST_CHECK(calculator_lerp(2.0, 6.0, 1.0, &value) == CALC_SUCCESS && value == 6.0);
+
+    test_each_level(test_axpy_level);
+}
+
+// ==========================================
+// MARK: - Main
+// ==========================================
+
+int main(void) {
+    if (calculator_initialize() != CALC_SUCCESS) {
+        fprintf(stderr, "test_calculator: initialization failed\n");
+        return 1;
+    }
+    test_fill_operands(&test_operands);
+
+    test_batch();
+    test_power_fenv();
+    test_parser();
+    test_format();
+    test_expressions();
+    test_modulus_i64();
+    test_divide_prepared();
+    test_reduce();
+    test_underflow();
+    test_fused();
+
+    calculator_cleanup();
+    if (test_failures > 0) {
+        fprintf(stderr, "test_calculator: %d checks failed\n", test_failures);
+        return 1;
+    }
+    printf("test_calculator: all checks passed\n");
+    return 0;
+}